@@ -0,0 +1,148 @@
+#include "harken_jobsystem.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// Compares the cost of spreading many small tasks across all cores using Harken's JobSystem
+// against launching a std::async task for each, and against running them serially. Each task
+// stands in for a typical per-object engine task (a transform update, say), and is deliberately
+// small so that scheduling overhead dominates.
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::size_t TaskCount = 100000;
+    constexpr int Repetitions = 5;
+
+    // std::async typically starts a thread for each task, and launching all of them at once would
+    // exhaust the process's thread limit, so tasks are launched in batches of this many.
+
+    constexpr std::size_t AsyncBatchSize = 256;
+
+    /**
+     * A small, fixed amount of floating-point work for the task at @p index.
+     */
+
+    double task(const std::size_t index) {
+
+        auto value = static_cast<double>(index);
+        for (auto i = 0; i < 64; ++i) {
+            value = std::sqrt(value + i);
+        }
+
+        return value;
+    }
+
+    /**
+     * Runs @p benchmark several times and returns the fastest run, in milliseconds.
+     */
+
+    template<typename Benchmark>
+    double time(const Benchmark& benchmark) {
+
+        auto best = 0.0;
+        for (auto i = 0; i < Repetitions; ++i) {
+
+            const auto start = Clock::now();
+            benchmark();
+            const auto elapsed = std::chrono::duration<double, std::milli>{Clock::now() - start}.count();
+
+            if (i == 0 || elapsed < best) {
+                best = elapsed;
+            }
+        }
+
+        return best;
+    }
+
+    void report(const char * const name, const double milliseconds, const std::size_t jobCount) {
+
+        std::cout << std::left << std::setw(36) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(2) << milliseconds << " ms"
+                  << std::setw(12) << std::setprecision(1) << milliseconds * 1.0e6 / jobCount << " ns/job"
+                  << std::endl;
+    }
+}
+
+int main() {
+
+    std::vector<double> results(TaskCount);
+    Harken::JobSystem jobs{Harken::JobSystem::defaultWorkerThreadCount(), Harken::JobSystemCaller::Worker};
+
+    std::cout << "Running " << TaskCount << " tasks on " << jobs.threadCount() << " threads" << std::endl;
+
+    const auto serial = time([&results]() {
+        for (std::size_t i = 0; i < TaskCount; ++i) {
+            results[i] = task(i);
+        }
+    });
+
+    report("serial", serial, TaskCount);
+
+    const auto jobPerTask = time([&jobs, &results]() {
+        jobs.parallelFor(0, TaskCount, 1, [&results](const std::size_t i) {
+            results[i] = task(i);
+        });
+    });
+
+    report("JobSystem (1 task per job)", jobPerTask, TaskCount);
+
+    constexpr std::size_t Grain = 256;
+    const auto grained = time([&jobs, &results]() {
+        jobs.parallelFor(0, TaskCount, Grain, [&results](const std::size_t i) {
+            results[i] = task(i);
+        });
+    });
+
+    report("JobSystem (256 tasks per job)", grained, (TaskCount + Grain - 1) / Grain);
+
+    const auto async = time([&results]() {
+
+        std::vector<std::future<void>> futures;
+        futures.reserve(AsyncBatchSize);
+
+        for (std::size_t batch = 0; batch < TaskCount; batch += AsyncBatchSize) {
+
+            for (auto i = batch; i < batch + AsyncBatchSize && i < TaskCount; ++i) {
+                futures.push_back(std::async(std::launch::async, [&results, i]() {
+                    results[i] = task(i);
+                }));
+            }
+
+            for (auto& future : futures) {
+                future.get();
+            }
+
+            futures.clear();
+        }
+    });
+
+    report("std::async (1 task per future)", async, TaskCount);
+
+    const auto asyncGrained = time([&results]() {
+
+        std::vector<std::future<void>> futures;
+        for (std::size_t first = 0; first < TaskCount; first += Grain) {
+            futures.push_back(std::async(std::launch::async, [&results, first]() {
+                for (auto i = first; i < first + Grain && i < TaskCount; ++i) {
+                    results[i] = task(i);
+                }
+            }));
+        }
+
+        for (auto& future : futures) {
+            future.get();
+        }
+    });
+
+    report("std::async (256 tasks per future)", asyncGrained, (TaskCount + Grain - 1) / Grain);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+#include "harken_headlesswindow.h"
+#include "harken_jobsystem.h"
+#include "harken_mipgenerator.h"
+#include "harken_stringbuilder.h"
+#include "harken_texture.h"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Compares generating the mipmap chain of an sRGB image with Harken's MipGenerator against
+// glGenerateMipmap() in a headless context. Both are timed from the base level's pixels in memory
+// to a complete chain on the GPU, so the generator's times include uploading every level, where
+// glGenerateMipmap() only uploads the base; the generator's times alone are reported as well.
+// Usage: bench-mipgenerator [size]
+
+using namespace Harken;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int Repetitions = 5;
+
+    /**
+     * Runs @p benchmark several times and returns the fastest run, in milliseconds.
+     */
+
+    template<typename Benchmark>
+    double time(const Benchmark& benchmark) {
+
+        auto best = 0.0;
+        for (auto i = 0; i < Repetitions; ++i) {
+
+            const auto start = Clock::now();
+            benchmark();
+            const auto elapsed = std::chrono::duration<double, std::milli>{Clock::now() - start}.count();
+
+            if (i == 0 || elapsed < best) {
+                best = elapsed;
+            }
+        }
+
+        return best;
+    }
+
+    void report(const char * const name, const double milliseconds, const double baseline) {
+
+        std::cout << std::left << std::setw(36) << name
+                  << std::right << std::setw(10) << std::fixed << std::setprecision(2) << milliseconds << " ms"
+                  << std::setw(10) << std::setprecision(2) << baseline / milliseconds << "x"
+                  << std::endl;
+    }
+
+    /**
+     * Makes a square image of @p size pixels of noisy colour, so that no level is trivially flat.
+     */
+
+    std::vector<char> makeImage(const int size) {
+
+        std::vector<char> pixels(static_cast<std::size_t>(size) * size * 4);
+
+        auto state = std::uint32_t{12345};
+        for (auto& byte : pixels) {
+            state = state * 1664525u + 1013904223u;
+            byte = static_cast<char>(state >> 24);
+        }
+
+        return pixels;
+    }
+
+    void initialiseGLEW() {
+
+        glewExperimental = true;
+        const auto result = glewInit();
+
+        // GLEW builds that use GLX report a missing X display after loading everything else, which
+        // is expected here (see HeadlessWindow).
+
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+        if (result == GLEW_ERROR_NO_GLX_DISPLAY) {
+            return;
+        }
+#endif
+
+        if (result != GLEW_OK) {
+            throw std::runtime_error{StringBuilder{} << "Could not initialise GLEW. Error: " << glewGetErrorString(result)};
+        }
+    }
+}
+
+int main(int argc, char * argv[]) {
+
+    try {
+
+        const auto size = argc > 1 ? std::max(std::stoi(argv[1]), 1) : 2048;
+
+        HeadlessWindow window{64, 64};
+        initialiseGLEW();
+
+        JobSystem jobs{JobSystem::defaultWorkerThreadCount(), JobSystemCaller::Worker};
+        MipGenerator generator{jobs};
+
+        const auto pixels = makeImage(size);
+        const Size2<int> imageSize{size, size};
+
+        Texture2D texture{GL_SRGB8_ALPHA8, imageSize, mipLevelCount(imageSize)};
+
+        std::cout << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
+        std::cout << "Generating " << texture.levels() << " levels of a " << size << "x" << size
+                  << " sRGB image on " << jobs.threadCount() << " threads" << std::endl;
+
+        const auto driver = time([&texture, &pixels]() {
+            texture.setData(0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+            texture.generateMipmaps();
+            glFinish();
+        });
+
+        report("glGenerateMipmap()", driver, driver);
+
+        for (const auto filter : {MipFilter::Box, MipFilter::Kaiser}) {
+
+            MipSettings settings;
+            settings.srgb = true;
+            settings.filter = filter;
+
+            const auto name = filter == MipFilter::Box ? "box" : "Kaiser";
+
+            const auto generated = time([&generator, &pixels, &imageSize, &settings]() {
+                generator.generate(pixels, imageSize, settings);
+            });
+
+            const auto uploaded = time([&generator, &texture, &pixels, &imageSize, &settings]() {
+
+                const auto chain = generator.generate(pixels, imageSize, settings);
+
+                for (std::size_t level = 0; level < chain.levels.size(); ++level) {
+                    texture.setData(static_cast<GLint>(level), chain.format(), GL_UNSIGNED_BYTE, chain.levels[level].data());
+                }
+
+                glFinish();
+            });
+
+            report((std::string{"MipGenerator ("} + name + ")").c_str(), generated, driver);
+            report((std::string{"MipGenerator ("} + name + ") + upload").c_str(), uploaded, driver);
+        }
+    }
+    catch (const std::exception& ex) {
+        std::cout << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
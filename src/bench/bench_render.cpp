@@ -0,0 +1,152 @@
+#include "harken_glmath.h"
+#include "harken_headlesswindow.h"
+#include "harken_renderqueue.h"
+#include "harken_shader.h"
+#include "harken_shaderprogram.h"
+#include "harken_stringbuilder.h"
+#include "harken_vertexarrayobject.h"
+#include "harken_vertexbufferobject.h"
+#include "harken_vertexlayout.h"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Renders frames of the demo scene (many times over) into a headless context, and reports frame
+// times along with a checksum of the final frame's pixels. Needs no display and no GPU, so it
+// can be run on build machines, where the checksum also serves as a crude rendering regression
+// test. Usage: bench-render [frames] [draws per frame]
+
+using namespace Harken;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+    using TriangleVertexLayout = VertexLayout<VertexAttribute<Vector2f>>;
+
+    constexpr int Width = 1280;
+    constexpr int Height = 720;
+
+    /**
+     * Computes the 32-bit FNV-1a hash of @p pixels.
+     */
+
+    std::uint32_t checksum(const std::vector<GLubyte>& pixels) {
+
+        auto hash = std::uint32_t{2166136261u};
+        for (const auto byte : pixels) {
+            hash = (hash ^ byte) * 16777619u;
+        }
+
+        return hash;
+    }
+
+    void initialiseGLEW() {
+
+        glewExperimental = true;
+        const auto result = glewInit();
+
+        // GLEW builds that use GLX report a missing X display after loading everything else, which
+        // is expected here (see HeadlessWindow).
+
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+        if (result == GLEW_ERROR_NO_GLX_DISPLAY) {
+            return;
+        }
+#endif
+
+        if (result != GLEW_OK) {
+            throw std::runtime_error{StringBuilder{} << "Could not initialise GLEW. Error: " << glewGetErrorString(result)};
+        }
+    }
+}
+
+int main(int argc, char * argv[]) {
+
+    try {
+
+        const auto frameCount = argc > 1 ? std::max(std::stoi(argv[1]), 1) : 300;
+        const auto drawCount = argc > 2 ? std::max(std::stoi(argv[2]), 1) : 1000;
+
+        HeadlessWindow window{Width, Height};
+        initialiseGLEW();
+
+        std::cout << "Renderer: " << glGetString(GL_RENDERER) << std::endl;
+        std::cout << "Rendering " << frameCount << " frames of " << drawCount << " draws at "
+                  << window.size().width() << "x" << window.size().height() << std::endl;
+
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+        VertexArrayObject triangleVAO;
+        VertexBufferObject arrayBuffer{GL_ARRAY_BUFFER};
+        triangleVAO.setFormat(arrayBuffer, TriangleVertexLayout::format());
+
+        const std::vector<GLfloat> vertices = {
+             0.0f,  0.433f,
+             0.5f, -0.433f,
+            -0.5f, -0.433f
+        };
+
+        arrayBuffer.setData(vertices);
+
+        const auto vertexShader   = std::make_shared<Shader>(GL_VERTEX_SHADER, "uniform-scale.vert");
+        const auto fragmentShader = std::make_shared<Shader>(GL_FRAGMENT_SHADER, "red.frag");
+
+        ShaderProgram shaderProgram{vertexShader, fragmentShader};
+        shaderProgram.use();
+
+        const auto scaleLocation = glGetUniformLocation(shaderProgram.id(), "scale");
+
+        RenderQueue renderQueue;
+        std::vector<double> frameTimes;
+        frameTimes.reserve(frameCount);
+
+        for (auto frame = 0; frame < frameCount; ++frame) {
+
+            const auto start = Clock::now();
+
+            glClear(GL_COLOR_BUFFER_BIT);
+            glUniform1f(scaleLocation, std::sin(frame * 0.01f));
+
+            for (auto i = 0; i < drawCount; ++i) {
+                renderQueue.submit(DrawItem{&shaderProgram, &triangleVAO, 0, GL_TRIANGLES, 0, 3}, static_cast<float>(i));
+            }
+
+            renderQueue.flush();
+            window.swapBuffers();
+
+            frameTimes.push_back(std::chrono::duration<double, std::milli>{Clock::now() - start}.count());
+        }
+
+        const auto pixels = window.readPixels();
+
+        std::sort(frameTimes.begin(), frameTimes.end());
+
+        auto total = 0.0;
+        for (const auto time : frameTimes) {
+            total += time;
+        }
+
+        std::cout << std::fixed << std::setprecision(3)
+                  << "Mean frame time:   " << total / frameTimes.size() << " ms" << std::endl
+                  << "Median frame time: " << frameTimes[frameTimes.size() / 2] << " ms" << std::endl
+                  << "99th percentile:   " << frameTimes[frameTimes.size() * 99 / 100] << " ms" << std::endl
+                  << "Final frame checksum: " << std::hex << checksum(pixels) << std::endl;
+    }
+    catch (const std::exception& ex) {
+        std::cout << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,344 @@
+#include "harken_assetpack.h"
+#include "harken_lz4.h"
+#include "harken_stringbuilder.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+namespace Harken {
+
+    /**
+     * Describes an asset in the index of a pack. The index is read in place from the mapping, so
+     * the layout is fixed, with explicit padding.
+     */
+
+    struct AssetPack::Entry {
+        std::uint64_t offset;
+        std::uint64_t storedSize;
+        std::uint64_t originalSize;
+        std::uint32_t nameOffset;
+        std::uint32_t nameLength;
+        AssetCompression compression;
+        std::uint32_t reserved;
+    };
+
+    namespace {
+
+        /**
+         * Begins every pack. The index of @c count entries follows it, then the @c namesSize bytes
+         * of the assets' names (not null-terminated), then the assets.
+         */
+
+        struct PackHeader {
+            char magic[4];
+            std::uint32_t version;
+            std::uint32_t count;
+            std::uint32_t namesSize;
+        };
+
+        constexpr char packMagic[4] = {'H', 'K', 'A', 'P'};
+        constexpr std::uint32_t packVersion = 1;
+
+        static_assert(sizeof(PackHeader) == 16, "Asset pack headers must have no padding.");
+
+        /**
+         * Compares the name of @p length bytes at @p name with @p other, as std::string would.
+         */
+
+        int compareName(const char * const name, const std::size_t length, const std::string& other) {
+
+            const auto result = std::memcmp(name, other.data(), std::min(length, other.size()));
+            if (result != 0) {
+                return result;
+            }
+
+            return length < other.size() ? -1 : length > other.size() ? 1 : 0;
+        }
+
+        std::size_t alignUp(const std::size_t value, const std::size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    AssetPackException::AssetPackException(const std::string& message)
+        : Exception{message} {
+    }
+
+    constexpr std::size_t AssetPack::alignment;
+
+    AssetPack::AssetPack(const std::string& path) {
+
+        static_assert(sizeof(Entry) == 40, "Asset pack entries must have no padding.");
+
+        const auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw IOException{StringBuilder{} << "Could not open asset pack \"" << path << "\"."};
+        }
+
+        struct stat status;
+        if (fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(PackHeader))) {
+            close(fd);
+            throw AssetPackException{StringBuilder{} << "\"" << path << "\" is too small to be an asset pack."};
+        }
+
+        m_size = static_cast<std::size_t>(status.st_size);
+
+        // The mapping holds its own reference to the file, so the descriptor is no longer needed
+        // once it is made.
+
+        const auto mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if (mapping == MAP_FAILED) {
+            throw IOException{StringBuilder{} << "Could not map asset pack \"" << path << "\"."};
+        }
+
+        m_data = static_cast<const char *>(mapping);
+
+        const auto invalid = [&](const char * const reason) {
+            munmap(const_cast<char *>(m_data), m_size);
+            return AssetPackException{StringBuilder{} << "\"" << path << "\" is not a valid asset pack: " << reason};
+        };
+
+        PackHeader header;
+        std::memcpy(&header, m_data, sizeof(header));
+
+        if (std::memcmp(header.magic, packMagic, sizeof(packMagic)) != 0) {
+            throw invalid("it has the wrong signature.");
+        }
+
+        if (header.version != packVersion) {
+            throw invalid("it was written by an unsupported version of the packer.");
+        }
+
+        const auto indexSize = std::size_t{header.count} * sizeof(Entry);
+        if (indexSize + header.namesSize > m_size - sizeof(PackHeader)) {
+            throw invalid("its index is truncated.");
+        }
+
+        m_entries = reinterpret_cast<const Entry *>(m_data + sizeof(PackHeader));
+        m_count = header.count;
+        m_names = m_data + sizeof(PackHeader) + indexSize;
+
+        // Each entry is checked once here, so that lookups need not check them again.
+
+        for (std::size_t i = 0; i < m_count; ++i) {
+
+            const auto& entry = m_entries[i];
+
+            if (entry.nameOffset > header.namesSize || entry.nameLength > header.namesSize - entry.nameOffset) {
+                throw invalid("an asset's name lies outside the index.");
+            }
+
+            if (i > 0 && compareName(m_names + entry.nameOffset, entry.nameLength, name(m_entries[i - 1])) <= 0) {
+                throw invalid("its index is not sorted.");
+            }
+
+            if (entry.offset > m_size || entry.storedSize > m_size - entry.offset) {
+                throw invalid("an asset lies outside the file.");
+            }
+
+            if (entry.compression == AssetCompression::None) {
+                if (entry.storedSize != entry.originalSize) {
+                    throw invalid("an uncompressed asset's sizes differ.");
+                }
+            }
+            else if (entry.compression != AssetCompression::LZ4) {
+                throw invalid("an asset uses an unknown compression method.");
+            }
+        }
+    }
+
+    AssetPack::~AssetPack() {
+        munmap(const_cast<char *>(m_data), m_size);
+    }
+
+    AssetCompression AssetPack::compression(const std::string& name) const {
+        return entry(name).compression;
+    }
+
+    bool AssetPack::contains(const std::string& name) const {
+        return find(name) != nullptr;
+    }
+
+    std::size_t AssetPack::count() const {
+        return m_count;
+    }
+
+    const AssetPack::Entry& AssetPack::entry(const std::string& name) const {
+
+        const auto entry = find(name);
+        if (!entry) {
+            throw AssetPackException{StringBuilder{} << "The asset pack has no asset named \"" << name << "\"."};
+        }
+
+        return *entry;
+    }
+
+    const AssetPack::Entry * AssetPack::find(const std::string& name) const {
+
+        const auto end = m_entries + m_count;
+        const auto it = std::lower_bound(m_entries, end, name, [this](const Entry& entry, const std::string& name) {
+            return compareName(m_names + entry.nameOffset, entry.nameLength, name) < 0;
+        });
+
+        if (it == end || compareName(m_names + it->nameOffset, it->nameLength, name) != 0) {
+            return nullptr;
+        }
+
+        return it;
+    }
+
+    std::string AssetPack::name(const Entry& entry) const {
+        return std::string{m_names + entry.nameOffset, entry.nameLength};
+    }
+
+    std::vector<std::string> AssetPack::names() const {
+
+        std::vector<std::string> names;
+        names.reserve(m_count);
+
+        for (std::size_t i = 0; i < m_count; ++i) {
+            names.push_back(name(m_entries[i]));
+        }
+
+        return names;
+    }
+
+    std::vector<char> AssetPack::read(const std::string& name) const {
+
+        const auto& asset = entry(name);
+        const auto stored = m_data + asset.offset;
+
+        if (asset.compression == AssetCompression::None) {
+            return std::vector<char>(stored, stored + asset.storedSize);
+        }
+
+        std::vector<char> data(asset.originalSize);
+        if (!lz4Decompress(stored, asset.storedSize, data.data(), data.size())) {
+            throw AssetPackException{StringBuilder{} << "The asset \"" << name << "\" is corrupt."};
+        }
+
+        return data;
+    }
+
+    std::size_t AssetPack::size(const std::string& name) const {
+        return entry(name).originalSize;
+    }
+
+    void AssetPack::upload(const std::string& name, VertexBufferObject& buffer, const GLenum usage) const {
+
+        const auto& asset = entry(name);
+
+        if (asset.compression == AssetCompression::None) {
+            buffer.setData(m_data + asset.offset, static_cast<GLsizeiptr>(asset.storedSize), usage);
+        }
+        else {
+            buffer.setData(read(name), usage);
+        }
+    }
+
+    AssetView AssetPack::view(const std::string& name) const {
+
+        const auto& asset = entry(name);
+        if (asset.compression != AssetCompression::None) {
+            throw AssetPackException{StringBuilder{} << "The asset \"" << name << "\" is compressed, so cannot be viewed in place."};
+        }
+
+        return AssetView{m_data + asset.offset, asset.storedSize};
+    }
+
+    void AssetPackWriter::add(std::string name, std::vector<char> data, const AssetCompression compression) {
+
+        if (m_assets.count(name)) {
+            throw AssetPackException{StringBuilder{} << "The asset pack already has an asset named \"" << name << "\"."};
+        }
+
+        Asset asset{std::move(data), 0, AssetCompression::None};
+        asset.originalSize = asset.data.size();
+
+        if (compression == AssetCompression::LZ4) {
+
+            auto compressed = lz4Compress(asset.data.data(), asset.data.size());
+            if (compressed.size() < asset.data.size()) {
+                asset.data = std::move(compressed);
+                asset.compression = AssetCompression::LZ4;
+            }
+        }
+
+        m_assets.emplace(std::move(name), std::move(asset));
+    }
+
+    void AssetPackWriter::write(const std::string& path) const {
+
+        PackHeader header;
+        std::memcpy(header.magic, packMagic, sizeof(packMagic));
+        header.version = packVersion;
+        header.count = static_cast<std::uint32_t>(m_assets.size());
+
+        std::vector<AssetPack::Entry> entries;
+        std::string names;
+
+        for (const auto& asset : m_assets) {
+
+            AssetPack::Entry entry{};
+            entry.storedSize = asset.second.data.size();
+            entry.originalSize = asset.second.originalSize;
+            entry.nameOffset = static_cast<std::uint32_t>(names.size());
+            entry.nameLength = static_cast<std::uint32_t>(asset.first.size());
+            entry.compression = asset.second.compression;
+
+            entries.push_back(entry);
+            names += asset.first;
+        }
+
+        header.namesSize = static_cast<std::uint32_t>(names.size());
+
+        auto offset = alignUp(sizeof(header) + entries.size() * sizeof(AssetPack::Entry) + names.size(), AssetPack::alignment);
+        for (auto& entry : entries) {
+            entry.offset = offset;
+            offset = alignUp(offset + entry.storedSize, AssetPack::alignment);
+        }
+
+        const auto temporaryPath = path + ".tmp";
+
+        {
+            std::ofstream file{temporaryPath, std::ios::binary | std::ios::trunc};
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char *>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(AssetPack::Entry)));
+            file.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+            const char padding[AssetPack::alignment] = {};
+            auto position = sizeof(header) + entries.size() * sizeof(AssetPack::Entry) + names.size();
+
+            auto entry = entries.begin();
+            for (const auto& asset : m_assets) {
+
+                file.write(padding, static_cast<std::streamsize>(entry->offset - position));
+                file.write(asset.second.data.data(), static_cast<std::streamsize>(asset.second.data.size()));
+
+                position = entry->offset + entry->storedSize;
+                ++entry;
+            }
+
+            if (!file) {
+                file.close();
+                std::remove(temporaryPath.c_str());
+                throw IOException{StringBuilder{} << "Could not write asset pack \"" << path << "\"."};
+            }
+        }
+
+        if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            std::remove(temporaryPath.c_str());
+            throw IOException{StringBuilder{} << "Could not write asset pack \"" << path << "\"."};
+        }
+    }
+}
@@ -0,0 +1,188 @@
+#ifndef HARKEN_ASSETPACK_H
+#define HARKEN_ASSETPACK_H
+
+#include "harken_global.h"
+#include "harken_exception.h"
+#include "harken_vertexbufferobject.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * Exception type thrown when an asset pack is malformed, or an asset is requested from a pack
+     * in a way it cannot satisfy.
+     */
+
+    class AssetPackException : public Exception {
+    public:
+        explicit AssetPackException(const std::string& message);
+    };
+
+    /**
+     * How an asset is stored in its pack.
+     */
+
+    enum class AssetCompression : std::uint32_t {
+        None = 0,  ///< Stored as is, so that it can be used in place.
+        LZ4 = 1    ///< Stored as an LZ4 block (see lz4Compress()).
+    };
+
+    /**
+     * A view of the bytes of an asset stored uncompressed, in place in its pack's mapping.
+     */
+
+    struct AssetView {
+
+        const char * data;  ///< The first byte of the asset, aligned to AssetPack::alignment.
+        std::size_t size;   ///< The size of the asset in bytes.
+    };
+
+    /**
+     * A read-only archive of named assets, mapped into memory rather than read, so that opening a
+     * pack costs only the validation of its index, and the bytes of each asset are read from disk
+     * (by the kernel, a page at a time) only when they are first used.
+     *
+     * A pack begins with a header and an index of its assets sorted by name, followed by the
+     * assets themselves, each aligned to AssetPack::alignment bytes. Assets stored uncompressed
+     * can be used in place, through view(), and in particular uploaded to OpenGL directly from the
+     * mapping, with no intermediate copy; compressed assets are decompressed on request. Packs
+     * are written by AssetPackWriter (and the @c pack-assets tool, which uses it), and are only
+     * readable on machines of the same endianness as the one that wrote them.
+     */
+
+    class AssetPack {
+        friend class AssetPackWriter;
+
+    public:
+
+        /**
+         * The alignment, in bytes, of every asset within its pack, which suffices for any vertex
+         * or pixel data read in place.
+         */
+
+        static constexpr std::size_t alignment = 64;
+
+        /**
+         * Maps the pack at @p path into memory and validates its index, throwing an IOException if
+         * the file cannot be mapped, or an AssetPackException if it is not a valid pack.
+         */
+
+        explicit AssetPack(const std::string& path);
+        ~AssetPack();
+
+        AssetPack(const AssetPack&) = delete;
+        AssetPack& operator=(const AssetPack&) = delete;
+
+        /**
+         * Gets how the asset named @p name is stored.
+         */
+
+        AssetCompression compression(const std::string& name) const;
+
+        /**
+         * Determines whether the pack has an asset named @p name.
+         */
+
+        bool contains(const std::string& name) const;
+
+        /**
+         * Gets the number of assets in the pack.
+         */
+
+        std::size_t count() const;
+
+        /**
+         * Gets the names of every asset in the pack, in order.
+         */
+
+        std::vector<std::string> names() const;
+
+        /**
+         * Gets a copy of the asset named @p name, decompressing it if need be. Prefer view() for
+         * uncompressed assets that need not outlive the pack.
+         */
+
+        std::vector<char> read(const std::string& name) const;
+
+        /**
+         * Gets the size in bytes of the asset named @p name, once decompressed.
+         */
+
+        std::size_t size(const std::string& name) const;
+
+        /**
+         * Replaces the contents of @p buffer with the asset named @p name. An uncompressed asset
+         * is passed to OpenGL straight from the pack's mapping; a compressed asset is first
+         * decompressed into a temporary buffer.
+         * @see VertexBufferObject::setData()
+         */
+
+        void upload(const std::string& name, VertexBufferObject& buffer, GLenum usage = GL_STATIC_DRAW) const;
+
+        /**
+         * Gets a view of the asset named @p name, which must be stored uncompressed. The view
+         * remains valid for as long as the pack.
+         */
+
+        AssetView view(const std::string& name) const;
+
+    private:
+
+        struct Entry;
+
+        const Entry& entry(const std::string& name) const;
+        const Entry * find(const std::string& name) const;
+        std::string name(const Entry& entry) const;
+
+        const char * m_data = nullptr;
+        std::size_t m_size = 0;
+
+        const Entry * m_entries = nullptr;
+        std::size_t m_count = 0;
+        const char * m_names = nullptr;
+    };
+
+    /**
+     * Builds an asset pack in memory and writes it out. Assets may be added in any order; they are
+     * sorted by name when the pack is written.
+     */
+
+    class AssetPackWriter {
+    public:
+
+        /**
+         * Adds an asset named @p name with the contents @p data, throwing an AssetPackException if
+         * the pack already has an asset of that name. If @p compression is AssetCompression::LZ4
+         * but compressing the asset would not make it smaller, it is stored uncompressed instead.
+         */
+
+        void add(std::string name, std::vector<char> data, AssetCompression compression = AssetCompression::None);
+
+        /**
+         * Writes the pack to @p path, throwing an IOException if it cannot be written. The pack is
+         * written to a temporary file and renamed into place, so that a pack being rebuilt while
+         * the application runs is never read half-written.
+         */
+
+        void write(const std::string& path) const;
+
+    private:
+
+        struct Asset {
+            std::vector<char> data;
+            std::size_t originalSize;
+            AssetCompression compression;
+        };
+
+        std::map<std::string, Asset> m_assets;
+    };
+}
+
+#endif
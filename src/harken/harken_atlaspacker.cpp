@@ -0,0 +1,420 @@
+#include "harken_atlaspacker.h"
+#include "harken_stringbuilder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <numeric>
+#include <utility>
+
+namespace Harken {
+
+    namespace {
+
+        /**
+         * Begins every atlas index. The regions follow it, each an IndexRegion followed by the
+         * @c nameLength bytes of its name (not null-terminated).
+         */
+
+        struct IndexHeader {
+            char magic[4];
+            std::uint32_t version;
+            std::int32_t pageWidth;
+            std::int32_t pageHeight;
+            std::int32_t pageCount;
+            std::int32_t padding;
+            std::uint32_t regionCount;
+        };
+
+        struct IndexRegion {
+            std::int32_t page;
+            std::int32_t x;
+            std::int32_t y;
+            std::int32_t width;
+            std::int32_t height;
+            std::uint32_t nameLength;
+        };
+
+        const char indexMagic[4] = {'H', 'K', 'A', 'T'};
+        const std::uint32_t indexVersion = 1;
+
+        template<typename T>
+        void append(std::vector<char>& data, const T& value) {
+            const auto bytes = reinterpret_cast<const char *>(&value);
+            data.insert(data.end(), bytes, bytes + sizeof(T));
+        }
+
+        /**
+         * Copies @p size bytes from @p data at @p offset into @p target and advances @p offset,
+         * throwing an AtlasException if the index ends first.
+         */
+
+        void extract(const char * const data, const std::size_t dataSize, std::size_t& offset, void * const target,
+                     const std::size_t size) {
+
+            if (dataSize - offset < size) {
+                throw AtlasException{"The atlas index is truncated."};
+            }
+
+            std::memcpy(target, data + offset, size);
+            offset += size;
+        }
+
+        void setTextureCoordinates(AtlasRegion& region, const Size2<int> pageSize) {
+
+            const auto width = static_cast<GLfloat>(pageSize.width());
+            const auto height = static_cast<GLfloat>(pageSize.height());
+
+            region.uvMin = Vector2f{region.x / width, region.y / height};
+            region.uvMax = Vector2f{(region.x + region.width) / width, (region.y + region.height) / height};
+        }
+    }
+
+    AtlasException::AtlasException(const std::string& message)
+        : Exception{message} {
+    }
+
+    Vector2f AtlasRegion::remap(const Vector2f& uv) const {
+        return Vector2f{uvMin.x() + (uvMax.x() - uvMin.x()) * uv.x(), uvMin.y() + (uvMax.y() - uvMin.y()) * uv.y()};
+    }
+
+    SkylinePacker::SkylinePacker(const Size2<int> size)
+        : m_size{size} {
+
+        clear();
+    }
+
+    void SkylinePacker::clear() {
+        m_skyline.assign(1, {0, 0, m_size.width()});
+        m_usedArea = 0;
+    }
+
+    bool SkylinePacker::insert(const Size2<int> size, int& x, int& y) {
+
+        assert(size.width() > 0 && size.height() > 0 && "Only rectangles with an area can be packed.");
+
+        auto bestIndex = m_skyline.size();
+        auto bestTop = m_size.height() + 1;
+
+        for (std::size_t i = 0; i < m_skyline.size(); ++i) {
+
+            const auto bottom = fit(i, size);
+            if (bottom >= 0 && bottom + size.height() < bestTop) {
+                bestIndex = i;
+                bestTop = bottom + size.height();
+            }
+        }
+
+        if (bestIndex == m_skyline.size()) {
+            return false;
+        }
+
+        x = m_skyline[bestIndex].x;
+        y = bestTop - size.height();
+
+        // The rectangle's top becomes a new segment of the skyline, hiding whatever part of the
+        // segments it spans lay beneath it.
+
+        m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(bestIndex), {x, bestTop, size.width()});
+
+        const auto right = x + size.width();
+        for (auto i = bestIndex + 1; i < m_skyline.size();) {
+
+            auto& segment = m_skyline[i];
+            if (segment.x >= right) {
+                break;
+            }
+
+            const auto hidden = std::min(right - segment.x, segment.width);
+            segment.x += hidden;
+            segment.width -= hidden;
+
+            if (segment.width == 0) {
+                m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+            else {
+                break;
+            }
+        }
+
+        for (std::size_t i = 1; i < m_skyline.size();) {
+            if (m_skyline[i - 1].y == m_skyline[i].y) {
+                m_skyline[i - 1].width += m_skyline[i].width;
+                m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+            else {
+                ++i;
+            }
+        }
+
+        m_usedArea += static_cast<std::int64_t>(size.width()) * size.height();
+        return true;
+    }
+
+    double SkylinePacker::occupancy() const {
+        return static_cast<double>(m_usedArea) / (static_cast<double>(m_size.width()) * m_size.height());
+    }
+
+    Size2<int> SkylinePacker::size() const {
+        return m_size;
+    }
+
+    int SkylinePacker::fit(const std::size_t index, const Size2<int> size) const {
+
+        // A rectangle placed at a segment rests on the highest of the segments it spans.
+
+        if (m_skyline[index].x + size.width() > m_size.width()) {
+            return -1;
+        }
+
+        auto bottom = 0;
+        auto remaining = size.width();
+
+        for (auto i = index; remaining > 0; ++i) {
+
+            bottom = std::max(bottom, m_skyline[i].y);
+            if (bottom + size.height() > m_size.height()) {
+                return -1;
+            }
+
+            remaining -= m_skyline[i].width;
+        }
+
+        return bottom;
+    }
+
+    AtlasPacker::AtlasPacker(const Size2<int> pageSize, const int padding, const int maxPages)
+        : m_pageSize{pageSize}, m_padding{padding}, m_maxPages{maxPages} {
+
+        assert(pageSize.width() > 0 && pageSize.height() > 0 && padding >= 0 && maxPages >= 0);
+    }
+
+    void AtlasPacker::clear() {
+        m_pages.clear();
+    }
+
+    AtlasRegion AtlasPacker::insert(const Size2<int> size) {
+
+        // Padding alone would let an empty image take up space, and there is nothing to pad.
+
+        if (size.width() <= 0 || size.height() <= 0) {
+            throw AtlasException{StringBuilder{} << "Cannot place an image of " << size.width() << "x" << size.height()
+                                                 << " in an atlas."};
+        }
+
+        const Size2<int> paddedSize{size.width() + 2 * m_padding, size.height() + 2 * m_padding};
+
+        if (paddedSize.width() > m_pageSize.width() || paddedSize.height() > m_pageSize.height()) {
+            throw AtlasException{StringBuilder{} << "An image of " << size.width() << "x" << size.height()
+                                                 << " does not fit in an atlas page of " << m_pageSize.width()
+                                                 << "x" << m_pageSize.height() << "."};
+        }
+
+        AtlasRegion region;
+
+        for (std::size_t page = 0; page < m_pages.size(); ++page) {
+            if (insert(page, paddedSize, region)) {
+                region.width = size.width();
+                region.height = size.height();
+                setTextureCoordinates(region, m_pageSize);
+                return region;
+            }
+        }
+
+        if (m_maxPages > 0 && pageCount() == m_maxPages) {
+            throw AtlasException{StringBuilder{} << "Every page of the atlas is full (of " << m_maxPages << ")."};
+        }
+
+        m_pages.emplace_back(m_pageSize);
+
+        const auto inserted = insert(m_pages.size() - 1, paddedSize, region);
+        assert(inserted && "An image that fits in a page must fit in an empty one.");
+        (void)inserted;
+
+        region.width = size.width();
+        region.height = size.height();
+        setTextureCoordinates(region, m_pageSize);
+        return region;
+    }
+
+    std::vector<AtlasRegion> AtlasPacker::insert(const std::vector<Size2<int>>& sizes) {
+
+        // Placing tall images first leaves the skyline flat for the short ones that follow, which
+        // then fill the space left beside it.
+
+        std::vector<std::size_t> order(sizes.size());
+        std::iota(order.begin(), order.end(), 0);
+
+        std::stable_sort(order.begin(), order.end(), [&](const std::size_t lhs, const std::size_t rhs) {
+            return sizes[lhs].height() != sizes[rhs].height()
+                ? sizes[lhs].height() > sizes[rhs].height()
+                : sizes[lhs].width() > sizes[rhs].width();
+        });
+
+        std::vector<AtlasRegion> regions(sizes.size());
+        for (const auto index : order) {
+            regions[index] = insert(sizes[index]);
+        }
+
+        return regions;
+    }
+
+    double AtlasPacker::occupancy() const {
+
+        if (m_pages.empty()) {
+            return 0.0;
+        }
+
+        auto occupancy = 0.0;
+        for (const auto& page : m_pages) {
+            occupancy += page.occupancy();
+        }
+
+        return occupancy / static_cast<double>(m_pages.size());
+    }
+
+    int AtlasPacker::padding() const {
+        return m_padding;
+    }
+
+    int AtlasPacker::pageCount() const {
+        return static_cast<int>(m_pages.size());
+    }
+
+    Size2<int> AtlasPacker::pageSize() const {
+        return m_pageSize;
+    }
+
+    bool AtlasPacker::insert(const std::size_t page, const Size2<int> size, AtlasRegion& region) {
+
+        int x;
+        int y;
+
+        if (!m_pages[page].insert(size, x, y)) {
+            return false;
+        }
+
+        region.page = static_cast<int>(page);
+        region.x = x + m_padding;
+        region.y = y + m_padding;
+        return true;
+    }
+
+    std::vector<char> padImage(const char * const pixels, const Size2<int> size, const std::size_t pixelSize,
+                               const int padding) {
+
+        const auto width = static_cast<std::size_t>(size.width());
+        const auto rowSize = width * pixelSize;
+        const auto paddedRowSize = (width + 2 * static_cast<std::size_t>(padding)) * pixelSize;
+
+        std::vector<char> padded(paddedRowSize * static_cast<std::size_t>(size.height() + 2 * padding));
+
+        for (auto row = 0; row < size.height() + 2 * padding; ++row) {
+
+            const auto source = pixels + static_cast<std::size_t>(std::min(std::max(row - padding, 0), size.height() - 1)) * rowSize;
+            auto target = padded.data() + static_cast<std::size_t>(row) * paddedRowSize;
+
+            for (auto column = 0; column < padding; ++column, target += pixelSize) {
+                std::memcpy(target, source, pixelSize);
+            }
+
+            std::memcpy(target, source, rowSize);
+            target += rowSize;
+
+            for (auto column = 0; column < padding; ++column, target += pixelSize) {
+                std::memcpy(target, source + rowSize - pixelSize, pixelSize);
+            }
+        }
+
+        return padded;
+    }
+
+    AtlasIndex readAtlasIndex(const char * const data, const std::size_t size) {
+
+        std::size_t offset = 0;
+
+        IndexHeader header;
+        extract(data, size, offset, &header, sizeof(header));
+
+        if (std::memcmp(header.magic, indexMagic, sizeof(indexMagic)) != 0) {
+            throw AtlasException{"The data is not an atlas index."};
+        }
+
+        if (header.version != indexVersion) {
+            throw AtlasException{StringBuilder{} << "Unsupported atlas index version " << header.version << "."};
+        }
+
+        if (header.pageWidth <= 0 || header.pageHeight <= 0 || header.pageCount < 0 || header.padding < 0) {
+            throw AtlasException{"The atlas index describes invalid pages."};
+        }
+
+        AtlasIndex index;
+        index.pageSize = {header.pageWidth, header.pageHeight};
+        index.pageCount = header.pageCount;
+        index.padding = header.padding;
+
+        for (std::uint32_t i = 0; i < header.regionCount; ++i) {
+
+            IndexRegion entry;
+            extract(data, size, offset, &entry, sizeof(entry));
+
+            // The length is checked before the name is allocated, so that a corrupt length cannot
+            // make for an enormous allocation.
+
+            if (entry.nameLength > size - offset) {
+                throw AtlasException{"The atlas index is truncated."};
+            }
+
+            std::string name(entry.nameLength, '\0');
+            extract(data, size, offset, &name[0], name.size());
+
+            const auto inBounds = entry.page >= 0 && entry.page < header.pageCount
+                && entry.x >= 0 && entry.width > 0 && entry.x <= header.pageWidth - entry.width
+                && entry.y >= 0 && entry.height > 0 && entry.y <= header.pageHeight - entry.height;
+
+            if (!inBounds) {
+                throw AtlasException{"The atlas index places \"" + name + "\" outside its pages."};
+            }
+
+            AtlasRegion region;
+            region.page = entry.page;
+            region.x = entry.x;
+            region.y = entry.y;
+            region.width = entry.width;
+            region.height = entry.height;
+            setTextureCoordinates(region, index.pageSize);
+
+            if (!index.regions.emplace(std::move(name), region).second) {
+                throw AtlasException{"The atlas index names an image twice."};
+            }
+        }
+
+        return index;
+    }
+
+    std::vector<char> writeAtlasIndex(const AtlasIndex& index) {
+
+        IndexHeader header;
+        std::memcpy(header.magic, indexMagic, sizeof(indexMagic));
+        header.version = indexVersion;
+        header.pageWidth = index.pageSize.width();
+        header.pageHeight = index.pageSize.height();
+        header.pageCount = index.pageCount;
+        header.padding = index.padding;
+        header.regionCount = static_cast<std::uint32_t>(index.regions.size());
+
+        std::vector<char> data;
+        append(data, header);
+
+        for (const auto& entry : index.regions) {
+
+            const auto& region = entry.second;
+            append(data, IndexRegion{region.page, region.x, region.y, region.width, region.height,
+                                     static_cast<std::uint32_t>(entry.first.size())});
+
+            data.insert(data.end(), entry.first.begin(), entry.first.end());
+        }
+
+        return data;
+    }
+}
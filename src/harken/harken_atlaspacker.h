@@ -0,0 +1,204 @@
+#ifndef HARKEN_ATLASPACKER_H
+#define HARKEN_ATLASPACKER_H
+
+#include "harken_global.h"
+#include "harken_exception.h"
+#include "harken_glmath.h"
+#include "harken_size.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * Exception type thrown when images cannot be packed into an atlas, or an atlas index cannot
+     * be read.
+     */
+
+    class AtlasException : public Exception {
+    public:
+        explicit AtlasException(const std::string& message);
+    };
+
+    /**
+     * Where an image was placed in an atlas, in pixels (with the origin at the bottom-left corner
+     * of its page, as for texture coordinates) and in texture coordinates.
+     */
+
+    struct AtlasRegion {
+
+        int page = 0;    ///< The page (or array layer) the image was placed on.
+        int x = 0;       ///< The column of the image's leftmost pixels.
+        int y = 0;       ///< The row of the image's bottom pixels.
+        int width = 0;   ///< The width of the image, in pixels.
+        int height = 0;  ///< The height of the image, in pixels.
+
+        Vector2f uvMin;  ///< The texture coordinates of the image's bottom-left corner.
+        Vector2f uvMax;  ///< The texture coordinates of the image's top-right corner.
+
+        /**
+         * Maps texture coordinates @p uv that span the image alone (from 0 to 1 across it) to
+         * coordinates that span the image within its page, so that meshes textured for the image
+         * can be drawn with the atlas instead.
+         */
+
+        Vector2f remap(const Vector2f& uv) const;
+    };
+
+    /**
+     * Packs rectangles into a single page, using the skyline bottom-left heuristic: the packer
+     * tracks the height of the packed area across the page (its skyline, as a list of horizontal
+     * segments), and places each rectangle wherever its top would be lowest. This wastes a little
+     * more space than keeping track of every free rectangle (as MaxRects does), but each insertion
+     * costs time only in the number of segments, which stays small, so it suits packing at
+     * runtime as well as offline.
+     */
+
+    class SkylinePacker {
+    public:
+
+        explicit SkylinePacker(Size2<int> size);
+
+        /**
+         * Removes every rectangle from the page.
+         */
+
+        void clear();
+
+        /**
+         * Places a rectangle of the given @p size, setting @p x and @p y to the position of its
+         * bottom-left corner and returning @c true, or returns @c false if it does not fit.
+         */
+
+        bool insert(Size2<int> size, int& x, int& y);
+
+        /**
+         * Gets the fraction of the page's area covered by rectangles.
+         */
+
+        double occupancy() const;
+
+        Size2<int> size() const;  ///< Gets the size of the page.
+
+    private:
+
+        struct Segment {
+            int x;
+            int y;
+            int width;
+        };
+
+        int fit(std::size_t index, Size2<int> size) const;
+
+        Size2<int> m_size;
+        std::vector<Segment> m_skyline;
+        std::int64_t m_usedArea = 0;
+    };
+
+    /**
+     * Packs images into pages of a fixed size, opening new pages as earlier ones fill, and maps
+     * them into the pages' texture coordinates, so that meshes textured with many small images
+     * can share a texture (an atlas texture per page, or a single array texture with a layer per
+     * page) and be batched into fewer draws.
+     *
+     * Images may be inserted all at once, which lets them be sorted to pack tightly (as is done
+     * offline, by the pack-atlas tool), or one at a time as they are needed, which places each
+     * on the first page with room for it. Each image is surrounded by a gutter of @c padding
+     * pixels, which should be filled with the image's edge pixels (see padImage()) so that
+     * filtering at its edges does not blend in its neighbours.
+     */
+
+    class AtlasPacker {
+    public:
+
+        /**
+         * @param pageSize The size of every page, in pixels.
+         * @param padding  The width, in pixels, of the gutter around each image.
+         * @param maxPages The most pages to open, or @c 0 for no limit.
+         */
+
+        explicit AtlasPacker(Size2<int> pageSize, int padding = 1, int maxPages = 0);
+
+        /**
+         * Removes every image, and closes every page.
+         */
+
+        void clear();
+
+        /**
+         * Places an image of the given @p size, throwing an AtlasException if it is empty, if it
+         * is larger than a page (with its gutter) or if every page is full and no more may be
+         * opened.
+         */
+
+        AtlasRegion insert(Size2<int> size);
+
+        /**
+         * Places images of the given @p sizes, tallest first, and returns their regions in the
+         * order given. Throws as insert() does, after which some of the images may have been
+         * placed.
+         */
+
+        std::vector<AtlasRegion> insert(const std::vector<Size2<int>>& sizes);
+
+        /**
+         * Gets the fraction of the pages' area covered by images (including their gutters).
+         */
+
+        double occupancy() const;
+
+        int padding() const;          ///< Gets the width of the gutter around each image.
+        int pageCount() const;        ///< Gets the number of pages opened.
+        Size2<int> pageSize() const;  ///< Gets the size of every page.
+
+    private:
+
+        bool insert(std::size_t page, Size2<int> size, AtlasRegion& region);
+
+        Size2<int> m_pageSize;
+        int m_padding;
+        int m_maxPages;
+        std::vector<SkylinePacker> m_pages;
+    };
+
+    /**
+     * The layout of a packed atlas: the size and number of its pages, and the region of each of
+     * its images, by name.
+     */
+
+    struct AtlasIndex {
+
+        Size2<int> pageSize;
+        int pageCount = 0;
+        int padding = 0;
+        std::map<std::string, AtlasRegion> regions;
+    };
+
+    /**
+     * Copies the image @p pixels (tightly packed rows of pixels of @p pixelSize bytes) into the
+     * middle of an image @p padding pixels larger on every side, whose gutter repeats the image's
+     * edge pixels, and returns the larger image.
+     */
+
+    std::vector<char> padImage(const char * pixels, Size2<int> size, std::size_t pixelSize, int padding);
+
+    /**
+     * Reads an atlas index written by writeAtlasIndex(), throwing an AtlasException if it is not
+     * valid.
+     */
+
+    AtlasIndex readAtlasIndex(const char * data, std::size_t size);
+
+    /**
+     * Writes @p index out, for readAtlasIndex() to read. Texture coordinates are not written, but
+     * recalculated as the index is read.
+     */
+
+    std::vector<char> writeAtlasIndex(const AtlasIndex& index);
+}
+
+#endif
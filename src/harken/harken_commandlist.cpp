@@ -0,0 +1,142 @@
+#include "harken_commandlist.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Harken {
+
+    CommandList::CommandList(const std::size_t chunkSize)
+        : m_memory{chunkSize} {
+    }
+
+    void CommandList::bindVertexArray(VertexArrayObject& vertexArray) {
+        record(Type::BindVertexArray, Commands::BindVertexArray{&vertexArray});
+    }
+
+    std::size_t CommandList::bytesUsed() const {
+        return m_memory.bytesAllocated();
+    }
+
+    void CommandList::clear() {
+        m_memory.reset();
+        m_first = nullptr;
+        m_last = nullptr;
+        m_size = 0;
+    }
+
+    void CommandList::drawArrays(const GLenum mode,
+                                 const GLint first,
+                                 const GLsizei count,
+                                 const GLsizei instanceCount) {
+
+        record(Type::DrawArrays, Commands::DrawArrays{mode, first, count, instanceCount});
+    }
+
+    void CommandList::drawElements(const GLenum mode,
+                                   const GLsizei count,
+                                   const GLenum indexType,
+                                   const GLsizei firstIndex,
+                                   const GLsizei instanceCount) {
+
+        record(Type::DrawElements, Commands::DrawElements{mode, count, indexType, firstIndex, instanceCount});
+    }
+
+    template<typename Command>
+    void CommandList::record(const Type type, const Command& command) {
+
+        const auto entry = m_memory.create<Record<Command>>(Header{type, nullptr}, command);
+
+        if (m_last) {
+            m_last->next = &entry->header;
+        }
+        else {
+            m_first = &entry->header;
+        }
+
+        m_last = &entry->header;
+        ++m_size;
+    }
+
+    void CommandList::setUniform(const GLint location, const GLfloat value) {
+        record(Type::SetUniform1f, Commands::SetUniform1f{location, value});
+    }
+
+    void CommandList::setUniform(const GLint location, const Vector4f& value) {
+
+        Commands::SetUniform4f command{location, {}};
+        for (auto i = 0; i < 4; ++i) {
+            command.value[i] = value[i];
+        }
+
+        record(Type::SetUniform4f, command);
+    }
+
+    void CommandList::setUniform(const GLint location, const Matrix4f& value) {
+
+        Commands::SetUniformMatrix4f command{location, {}};
+        std::copy(value.data(), value.data() + 16, command.value);
+
+        record(Type::SetUniformMatrix4f, command);
+    }
+
+    std::size_t CommandList::size() const {
+        return m_size;
+    }
+
+    void CommandList::useProgram(ShaderProgram& program) {
+        record(Type::UseProgram, Commands::UseProgram{&program});
+    }
+
+    void CommandListExecutor::execute(const CommandList& commands) {
+        commands.visit(*this);
+    }
+
+    void CommandListExecutor::reset() {
+        m_program = nullptr;
+        m_vertexArray = nullptr;
+    }
+
+    void CommandListExecutor::operator()(const Commands::UseProgram& command) {
+
+        if (command.program != m_program) {
+            m_program = command.program;
+            m_program->use();
+        }
+    }
+
+    void CommandListExecutor::operator()(const Commands::BindVertexArray& command) {
+
+        if (command.vertexArray != m_vertexArray) {
+            m_vertexArray = command.vertexArray;
+            m_vertexArray->bind();
+        }
+    }
+
+    void CommandListExecutor::operator()(const Commands::SetUniform1f& command) {
+        glUniform1f(command.location, command.value);
+    }
+
+    void CommandListExecutor::operator()(const Commands::SetUniform4f& command) {
+        glUniform4fv(command.location, 1, command.value);
+    }
+
+    void CommandListExecutor::operator()(const Commands::SetUniformMatrix4f& command) {
+
+        // Matrix4f stores its data in column-major order, as OpenGL expects, so no transposition
+        // is needed.
+
+        glUniformMatrix4fv(command.location, 1, GL_FALSE, command.value);
+    }
+
+    void CommandListExecutor::operator()(const Commands::DrawArrays& command) {
+        glDrawArraysInstanced(command.mode, command.first, command.count, command.instanceCount);
+    }
+
+    void CommandListExecutor::operator()(const Commands::DrawElements& command) {
+
+        const auto indexSize = std::uintptr_t{command.indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint)};
+        const auto offset = reinterpret_cast<const GLvoid *>(command.firstIndex * indexSize);
+
+        glDrawElementsInstanced(command.mode, command.count, command.indexType, offset, command.instanceCount);
+    }
+}
@@ -0,0 +1,231 @@
+#ifndef HARKEN_COMMANDLIST_H
+#define HARKEN_COMMANDLIST_H
+
+#include "harken_global.h"
+#include "harken_glmath.h"
+#include "harken_linearallocator.h"
+#include "harken_shaderprogram.h"
+#include "harken_vertexarrayobject.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Harken {
+
+    /**
+     * The commands that may be recorded into a CommandList. Each is a plain structure holding the
+     * arguments of the command, so recording a command makes no OpenGL calls at all; the commands
+     * are only translated into OpenGL calls when the list is replayed by a CommandListExecutor.
+     */
+
+    namespace Commands {
+
+        struct UseProgram {
+            ShaderProgram * program;
+        };
+
+        struct BindVertexArray {
+            VertexArrayObject * vertexArray;
+        };
+
+        struct SetUniform1f {
+            GLint location;
+            GLfloat value;
+        };
+
+        struct SetUniform4f {
+            GLint location;
+            GLfloat value[4];
+        };
+
+        struct SetUniformMatrix4f {
+            GLint location;
+            GLfloat value[16];
+        };
+
+        struct DrawArrays {
+            GLenum mode;
+            GLint first;
+            GLsizei count;
+            GLsizei instanceCount;
+        };
+
+        struct DrawElements {
+            GLenum mode;
+            GLsizei count;
+            GLenum indexType;
+            GLsizei firstIndex;
+            GLsizei instanceCount;
+        };
+    }
+
+    /**
+     * A sequence of rendering commands recorded without touching OpenGL, so that it may be filled
+     * on any thread. The usual pattern is for each worker thread to own a CommandList (and hence
+     * its own linear memory, with no sharing between threads and no locking), and for the thread
+     * owning the OpenGL context to replay the lists in a fixed order once every worker has
+     * finished recording. Handing the lists over from the workers to the OpenGL thread (by
+     * joining the workers or waiting on futures, say) is the only synchronisation required.
+     *
+     * Command arguments are stored contiguously in a LinearAllocator, which is reused from frame
+     * to frame by clear(); once a list has grown to its steady-state size, recording performs no
+     * heap allocation at all.
+     */
+
+    class CommandList {
+    public:
+
+        explicit CommandList(std::size_t chunkSize = LinearAllocator::DefaultChunkSize);
+
+        CommandList(CommandList&&) = default;
+        CommandList& operator=(CommandList&&) = default;
+
+        void bindVertexArray(VertexArrayObject& vertexArray);
+
+        void drawArrays(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount = 1);
+
+        void drawElements(GLenum mode, GLsizei count, GLenum indexType,
+                          GLsizei firstIndex = 0, GLsizei instanceCount = 1);
+
+        void setUniform(GLint location, GLfloat value);
+        void setUniform(GLint location, const Vector4f& value);
+        void setUniform(GLint location, const Matrix4f& value);
+
+        void useProgram(ShaderProgram& program);
+
+        /**
+         * Gets the number of bytes of linear memory used by the commands currently recorded.
+         */
+
+        std::size_t bytesUsed() const;
+
+        /**
+         * Removes every command from the list, retaining its memory for reuse.
+         */
+
+        void clear();
+
+        /**
+         * Gets the number of commands currently recorded.
+         */
+
+        std::size_t size() const;
+
+        /**
+         * Calls @p visitor with each recorded command (as one of the types in the Commands
+         * namespace), in the order the commands were recorded.
+         */
+
+        template<typename Visitor>
+        void visit(Visitor&& visitor) const {
+
+            for (auto header = m_first; header; header = header->next) {
+
+                switch (header->type) {
+                case Type::UseProgram:
+                    visitor(commandOf<Commands::UseProgram>(header));
+                    break;
+                case Type::BindVertexArray:
+                    visitor(commandOf<Commands::BindVertexArray>(header));
+                    break;
+                case Type::SetUniform1f:
+                    visitor(commandOf<Commands::SetUniform1f>(header));
+                    break;
+                case Type::SetUniform4f:
+                    visitor(commandOf<Commands::SetUniform4f>(header));
+                    break;
+                case Type::SetUniformMatrix4f:
+                    visitor(commandOf<Commands::SetUniformMatrix4f>(header));
+                    break;
+                case Type::DrawArrays:
+                    visitor(commandOf<Commands::DrawArrays>(header));
+                    break;
+                case Type::DrawElements:
+                    visitor(commandOf<Commands::DrawElements>(header));
+                    break;
+                }
+            }
+        }
+
+    private:
+
+        enum class Type : std::uint8_t {
+            UseProgram,
+            BindVertexArray,
+            SetUniform1f,
+            SetUniform4f,
+            SetUniformMatrix4f,
+            DrawArrays,
+            DrawElements
+        };
+
+        // Commands are stored as an intrusive singly linked list of records in the allocator's
+        // memory, each consisting of a header followed immediately by the command itself.
+
+        struct Header {
+            Type type;
+            Header * next;
+        };
+
+        template<typename Command>
+        struct Record {
+            Header header;
+            Command command;
+        };
+
+        template<typename Command>
+        static const Command& commandOf(const Header * const header) {
+            return reinterpret_cast<const Record<Command> *>(header)->command;
+        }
+
+        template<typename Command>
+        void record(Type type, const Command& command);
+
+        LinearAllocator m_memory;
+        Header * m_first = nullptr;
+        Header * m_last = nullptr;
+        std::size_t m_size = 0;
+    };
+
+    /**
+     * Replays CommandList objects into OpenGL, and so must only be used on the thread owning the
+     * OpenGL context. The executor remembers the shader program and vertex array object most
+     * recently made current, across however many lists it executes, and skips commands that
+     * would make them current again.
+     */
+
+    class CommandListExecutor {
+    public:
+
+        /**
+         * Issues the OpenGL calls corresponding to each command in @p commands, in order.
+         */
+
+        void execute(const CommandList& commands);
+
+        /**
+         * Forgets the tracked shader program and vertex array object. This must be called if
+         * OpenGL state is changed other than through the executor (at the start of each frame,
+         * say).
+         */
+
+        void reset();
+
+        void operator()(const Commands::UseProgram& command);
+        void operator()(const Commands::BindVertexArray& command);
+        void operator()(const Commands::SetUniform1f& command);
+        void operator()(const Commands::SetUniform4f& command);
+        void operator()(const Commands::SetUniformMatrix4f& command);
+        void operator()(const Commands::DrawArrays& command);
+        void operator()(const Commands::DrawElements& command);
+
+    private:
+
+        ShaderProgram * m_program = nullptr;
+        VertexArrayObject * m_vertexArray = nullptr;
+    };
+}
+
+#endif
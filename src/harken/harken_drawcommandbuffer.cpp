@@ -0,0 +1,82 @@
+#include "harken_drawcommandbuffer.h"
+
+#include <cstdint>
+
+namespace Harken {
+
+    bool isMultiDrawIndirectSupported() {
+        return GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+    }
+
+    DrawArraysCommandBuffer::DrawArraysCommandBuffer()
+        : DrawArraysCommandBuffer{isMultiDrawIndirectSupported()} {
+    }
+
+    DrawArraysCommandBuffer::DrawArraysCommandBuffer(const bool useIndirect)
+        : DrawCommandBuffer<DrawArraysIndirectCommand>{useIndirect} {
+    }
+
+    void DrawArraysCommandBuffer::submit(const GLenum mode) {
+
+        if (m_commands.empty()) {
+            return;
+        }
+
+        if (usesIndirect()) {
+            bindIndirectBuffer();
+            glMultiDrawArraysIndirect(mode, nullptr, static_cast<GLsizei>(m_commands.size()), 0);
+            return;
+        }
+
+        const bool baseInstanceSupported = GLEW_ARB_base_instance;
+        for (const auto& command : m_commands) {
+
+            if (baseInstanceSupported) {
+                glDrawArraysInstancedBaseInstance(mode, command.first, command.count,
+                                                  command.instanceCount, command.baseInstance);
+            }
+            else {
+                glDrawArraysInstanced(mode, command.first, command.count, command.instanceCount);
+            }
+        }
+    }
+
+    DrawElementsCommandBuffer::DrawElementsCommandBuffer()
+        : DrawElementsCommandBuffer{isMultiDrawIndirectSupported()} {
+    }
+
+    DrawElementsCommandBuffer::DrawElementsCommandBuffer(const bool useIndirect)
+        : DrawCommandBuffer<DrawElementsIndirectCommand>{useIndirect} {
+    }
+
+    void DrawElementsCommandBuffer::submit(const GLenum indexType, const GLenum mode) {
+
+        if (m_commands.empty()) {
+            return;
+        }
+
+        if (usesIndirect()) {
+            bindIndirectBuffer();
+            glMultiDrawElementsIndirect(mode, indexType, nullptr, static_cast<GLsizei>(m_commands.size()), 0);
+            return;
+        }
+
+        const auto indexSize = std::uintptr_t{indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint)};
+        const bool baseInstanceSupported = GLEW_ARB_base_instance;
+
+        for (const auto& command : m_commands) {
+
+            const auto offset = reinterpret_cast<const GLvoid *>(command.firstIndex * indexSize);
+
+            if (baseInstanceSupported) {
+                glDrawElementsInstancedBaseVertexBaseInstance(mode, command.count, indexType, offset,
+                                                              command.instanceCount, command.baseVertex,
+                                                              command.baseInstance);
+            }
+            else {
+                glDrawElementsInstancedBaseVertex(mode, command.count, indexType, offset,
+                                                  command.instanceCount, command.baseVertex);
+            }
+        }
+    }
+}
@@ -0,0 +1,194 @@
+#ifndef HARKEN_DRAWCOMMANDBUFFER_H
+#define HARKEN_DRAWCOMMANDBUFFER_H
+
+#include "harken_global.h"
+#include "harken_vertexbufferobject.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * The parameters of a single non-indexed draw, laid out as OpenGL expects to read them from a
+     * @c GL_DRAW_INDIRECT_BUFFER. See <tt>glDrawArraysIndirect()</tt>.
+     */
+
+    struct DrawArraysIndirectCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint first;
+        GLuint baseInstance;
+    };
+
+    /**
+     * The parameters of a single indexed draw, laid out as OpenGL expects to read them from a
+     * @c GL_DRAW_INDIRECT_BUFFER. See <tt>glDrawElementsIndirect()</tt>.
+     */
+
+    struct DrawElementsIndirectCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+    /**
+     * Determines whether the current OpenGL context can source multiple draws from a single
+     * indirect buffer (that is, whether it supports OpenGL 4.3 or
+     * @c GL_ARB_multi_draw_indirect). Requires GLEW to have been initialised.
+     */
+
+    bool isMultiDrawIndirectSupported();
+
+    /**
+     * Common base for DrawArraysCommandBuffer and DrawElementsCommandBuffer. Collects draw
+     * commands on the CPU and uploads them to a @c GL_DRAW_INDIRECT_BUFFER so that a whole batch
+     * of draws sharing the same vertex array object and shader program can be submitted with a
+     * single multi-draw call, making the CPU cost of submission independent of the number of
+     * objects drawn.
+     *
+     * When multi-draw indirect is unavailable, commands are instead submitted by looping over
+     * them on the CPU; the results are the same, except that @c baseInstance is ignored unless
+     * @c GL_ARB_base_instance is supported.
+     */
+
+    template<typename Command>
+    class DrawCommandBuffer {
+    public:
+
+        /**
+         * Appends @p command to the batch. The command is not uploaded to OpenGL until the batch
+         * is next submitted.
+         */
+
+        void add(const Command& command) {
+            m_commands.push_back(command);
+            m_dirty = true;
+        }
+
+        /**
+         * Removes every command from the batch, typically at the start of a frame.
+         */
+
+        void clear() {
+            m_commands.clear();
+            m_dirty = true;
+        }
+
+        const std::vector<Command>& commands() const {
+            return m_commands;
+        }
+
+        std::size_t size() const {
+            return m_commands.size();
+        }
+
+        /**
+         * Determines whether the batch is submitted with a single multi-draw indirect call, or
+         * with the fallback loop.
+         */
+
+        bool usesIndirect() const {
+            return m_useIndirect;
+        }
+
+    protected:
+
+        /**
+         * @param useIndirect Whether to submit commands through the indirect buffer; this should
+         *                    only be @c true if isMultiDrawIndirectSupported().
+         */
+
+        explicit DrawCommandBuffer(const bool useIndirect)
+            : m_useIndirect{useIndirect} {
+        }
+
+        ~DrawCommandBuffer() = default;
+
+        /**
+         * Binds the indirect buffer, first re-uploading the commands to it if they have changed
+         * since they were last uploaded.
+         */
+
+        void bindIndirectBuffer() {
+
+            if (m_dirty) {
+                m_buffer.setData(m_commands, GL_STREAM_DRAW);
+                m_dirty = false;
+            }
+            else {
+                m_buffer.bind();
+            }
+        }
+
+        std::vector<Command> m_commands;
+
+    private:
+
+        VertexBufferObject m_buffer{GL_DRAW_INDIRECT_BUFFER};
+        bool m_dirty = false;
+        bool m_useIndirect;
+    };
+
+    /**
+     * Collects and submits a batch of non-indexed draws. @see DrawCommandBuffer
+     */
+
+    class DrawArraysCommandBuffer : public DrawCommandBuffer<DrawArraysIndirectCommand> {
+    public:
+
+        /**
+         * Creates an empty batch that uses multi-draw indirect if the current context supports it.
+         */
+
+        DrawArraysCommandBuffer();
+
+        /**
+         * Creates an empty batch that uses multi-draw indirect only if @p useIndirect is @c true.
+         */
+
+        explicit DrawArraysCommandBuffer(bool useIndirect);
+
+        /**
+         * Draws every command in the batch using the currently bound vertex array object and
+         * shader program. See <tt>glMultiDrawArraysIndirect()</tt>.
+         */
+
+        void submit(GLenum mode = GL_TRIANGLES);
+    };
+
+    /**
+     * Collects and submits a batch of indexed draws. @see DrawCommandBuffer
+     */
+
+    class DrawElementsCommandBuffer : public DrawCommandBuffer<DrawElementsIndirectCommand> {
+    public:
+
+        /**
+         * Creates an empty batch that uses multi-draw indirect if the current context supports it.
+         */
+
+        DrawElementsCommandBuffer();
+
+        /**
+         * Creates an empty batch that uses multi-draw indirect only if @p useIndirect is @c true.
+         */
+
+        explicit DrawElementsCommandBuffer(bool useIndirect);
+
+        /**
+         * Draws every command in the batch using the currently bound vertex array object (and its
+         * element buffer) and shader program. See <tt>glMultiDrawElementsIndirect()</tt>.
+         * @param indexType The type of the indices in the element buffer; see
+         *                  ElementBufferObject::indexType().
+         */
+
+        void submit(GLenum indexType, GLenum mode = GL_TRIANGLES);
+    };
+}
+
+#endif
@@ -0,0 +1,138 @@
+#include "harken_dynamicresolution.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace Harken {
+
+    ResolutionController::ResolutionController(const double targetFrameTime, const double minScale, const double maxScale)
+        : m_targetFrameTime{targetFrameTime},
+          m_minArea{minScale * minScale},
+          m_maxArea{maxScale * maxScale},
+          m_area{maxScale * maxScale} {
+
+        assert(targetFrameTime > 0.0 && "The target frame time must be positive.");
+        assert(minScale > 0.0 && minScale <= maxScale && "Invalid resolution scale limits.");
+    }
+
+    void ResolutionController::reset() {
+        m_area = m_maxArea;
+        m_previousError = 0.0;
+        m_previousDelta = 0.0;
+    }
+
+    double ResolutionController::scale() const {
+        return std::sqrt(m_area);
+    }
+
+    Size2<int> ResolutionController::scaledSize(const Size2<int> fullSize) const {
+
+        const auto scaleFactor = scale();
+        return {
+            std::max(static_cast<int>(std::lround(fullSize.width() * scaleFactor)), 1),
+            std::max(static_cast<int>(std::lround(fullSize.height() * scaleFactor)), 1)
+        };
+    }
+
+    void ResolutionController::setGains(const double proportional, const double integral, const double derivative) {
+        m_proportionalGain = proportional;
+        m_integralGain = integral;
+        m_derivativeGain = derivative;
+    }
+
+    void ResolutionController::setTargetFrameTime(const double targetFrameTime) {
+        assert(targetFrameTime > 0.0 && "The target frame time must be positive.");
+        m_targetFrameTime = targetFrameTime;
+    }
+
+    double ResolutionController::targetFrameTime() const {
+        return m_targetFrameTime;
+    }
+
+    double ResolutionController::update(const double frameTime) {
+
+        // The error is relative, so that the gains are independent of the target, and positive
+        // when there is time to spare (and the resolution may rise).
+
+        const auto error = (m_targetFrameTime - frameTime) / m_targetFrameTime;
+        const auto delta = error - m_previousError;
+
+        const auto change = m_proportionalGain * delta
+                          + m_integralGain * error
+                          + m_derivativeGain * (delta - m_previousDelta);
+
+        // The change is applied multiplicatively, so that a given error moves the pixel count by
+        // the same proportion whatever it currently is.
+
+        m_area = std::min(std::max(m_area * (1.0 + change), m_minArea), m_maxArea);
+
+        m_previousError = error;
+        m_previousDelta = delta;
+
+        return scale();
+    }
+
+    DynamicResolution::DynamicResolution(RenderTargetPool& pool,
+                                         const ResolutionController& controller,
+                                         const GLenum colorFormat,
+                                         const GLenum depthFormat)
+        : m_pool(pool), m_controller{controller}, m_colorFormat{colorFormat}, m_depthFormat{depthFormat} {
+    }
+
+    void DynamicResolution::begin(const Size2<int> windowSize) {
+
+        assert(!m_target && "DynamicResolution::begin() called twice without end().");
+
+        RenderTargetDesc desc;
+        desc.size = windowSize;
+        desc.colorFormat = m_colorFormat;
+        desc.depthFormat = m_depthFormat;
+
+        m_target = &m_pool.acquire(desc);
+        m_windowSize = windowSize;
+        m_renderSize = m_controller.scaledSize(windowSize);
+
+        m_target->framebuffer().bind();
+        glViewport(0, 0, m_renderSize.width(), m_renderSize.height());
+    }
+
+    ResolutionController& DynamicResolution::controller() {
+        return m_controller;
+    }
+
+    void DynamicResolution::end() {
+
+        assert(m_target && "DynamicResolution::end() called without begin().");
+
+        m_target->framebuffer().bind(GL_READ_FRAMEBUFFER);
+        FramebufferObject::unbind(GL_DRAW_FRAMEBUFFER);
+
+        glBlitFramebuffer(0, 0, m_renderSize.width(), m_renderSize.height(),
+                          0, 0, m_windowSize.width(), m_windowSize.height(),
+                          GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+        FramebufferObject::unbind();
+        glViewport(0, 0, m_windowSize.width(), m_windowSize.height());
+
+        m_pool.release(*m_target);
+        m_target = nullptr;
+    }
+
+    Size2<int> DynamicResolution::renderSize() const {
+        return m_renderSize;
+    }
+
+    void DynamicResolution::update(const double frameTime) {
+        m_controller.update(frameTime);
+    }
+
+    void DynamicResolution::update(const FrameSync& frameSync) {
+
+        const auto& timings = frameSync.gpuTimings();
+        if (timings.frameNumber != 0 && timings.frameNumber != m_lastMeasuredFrame) {
+            m_controller.update(timings.busyTime);
+            m_lastMeasuredFrame = timings.frameNumber;
+        }
+    }
+}
@@ -0,0 +1,177 @@
+#ifndef HARKEN_DYNAMICRESOLUTION_H
+#define HARKEN_DYNAMICRESOLUTION_H
+
+#include "harken_global.h"
+#include "harken_framesync.h"
+#include "harken_rendertargetpool.h"
+#include "harken_size.h"
+
+#include <GL/glew.h>
+
+#include <cstdint>
+
+namespace Harken {
+
+    /**
+     * Chooses the resolution at which to render so that frames take a target time. The
+     * controller is a PID controller in velocity form: each frame, the fraction of the full pixel
+     * count rendered is adjusted according to the relative error between the measured and the
+     * target frame time (the integral term), how that error has changed since the previous frame
+     * (the proportional term) and how that change has itself changed (the derivative term). The
+     * velocity form cannot wind up while the resolution is pinned at either limit, since it
+     * accumulates nothing but the current output.
+     *
+     * Rendering cost is assumed to be roughly proportional to the number of pixels, which is why
+     * the pixel count rather than the scale of each axis is what is controlled.
+     */
+
+    class ResolutionController {
+    public:
+
+        /**
+         * @param targetFrameTime The frame time to aim for, in seconds. This should be somewhat
+         *                        below the frame budget, since frame times vary from one frame to
+         *                        the next.
+         * @param minScale        The smallest scale of each axis that may be chosen.
+         * @param maxScale        The largest scale of each axis that may be chosen.
+         */
+
+        explicit ResolutionController(double targetFrameTime, double minScale = 0.5, double maxScale = 1.0);
+
+        /**
+         * Returns the controller to the largest scale and forgets its history, for example after
+         * the scene changes drastically.
+         */
+
+        void reset();
+
+        /**
+         * Gets the scale of each axis at which to render; that is, the ratio of the rendered
+         * resolution to the full resolution.
+         */
+
+        double scale() const;
+
+        /**
+         * Scales each dimension of @p fullSize by scale(), rounding to the nearest pixel but never
+         * to less than one.
+         */
+
+        Size2<int> scaledSize(Size2<int> fullSize) const;
+
+        /**
+         * Sets the gains of the controller's terms. The defaults (0.5, 0.15 and 0.05) converge
+         * within a few dozen frames without overshooting noticeably on typical loads.
+         */
+
+        void setGains(double proportional, double integral, double derivative);
+
+        /**
+         * Sets the frame time to aim for, in seconds.
+         */
+
+        void setTargetFrameTime(double targetFrameTime);
+
+        double targetFrameTime() const;  ///< Gets the frame time aimed for, in seconds.
+
+        /**
+         * Adjusts the scale according to the time, in seconds, that the most recent frame took to
+         * render at the current scale, and returns the new scale.
+         */
+
+        double update(double frameTime);
+
+    private:
+
+        double m_targetFrameTime;
+        double m_minArea;
+        double m_maxArea;
+
+        double m_proportionalGain = 0.5;
+        double m_integralGain = 0.15;
+        double m_derivativeGain = 0.05;
+
+        double m_area;
+        double m_previousError = 0.0;
+        double m_previousDelta = 0.0;
+    };
+
+    /**
+     * Renders a scene at a dynamically chosen resolution and upscales the result to fill the
+     * window. Between begin() and end(), rendering is directed to the lower-left corner of an
+     * offscreen target the size of the window, of the size chosen by a ResolutionController;
+     * end() then stretches that corner over the window's default framebuffer with bilinear
+     * filtering. Since the target is always the size of the window, changing the resolution never
+     * causes a target to be reallocated.
+     */
+
+    class DynamicResolution {
+    public:
+
+        /**
+         * @param pool        The pool from which to acquire the offscreen target each frame.
+         * @param controller  The controller that chooses the resolution.
+         * @param colorFormat The colour format of the offscreen target.
+         * @param depthFormat The depth format of the offscreen target, or @c GL_NONE for none.
+         */
+
+        DynamicResolution(RenderTargetPool& pool,
+                          const ResolutionController& controller,
+                          GLenum colorFormat = GL_RGBA8,
+                          GLenum depthFormat = GL_DEPTH24_STENCIL8);
+
+        /**
+         * Acquires an offscreen target the size of @p windowSize, binds it, and sets the viewport
+         * to the part of it to render to this frame.
+         */
+
+        void begin(Size2<int> windowSize);
+
+        /**
+         * Gets the controller choosing the resolution.
+         */
+
+        ResolutionController& controller();
+
+        /**
+         * Upscales the frame rendered since begin() to the window's default framebuffer, which is
+         * left bound with a viewport covering the window, and releases the offscreen target.
+         */
+
+        void end();
+
+        /**
+         * Gets the size at which the current frame is being rendered.
+         */
+
+        Size2<int> renderSize() const;
+
+        /**
+         * Feeds the time taken by a frame rendered at the current scale, in seconds, to the
+         * controller.
+         */
+
+        void update(double frameTime);
+
+        /**
+         * Feeds the GPU time of the most recently finished frame measured by @p frameSync to the
+         * controller, if it has not been fed already.
+         */
+
+        void update(const FrameSync& frameSync);
+
+    private:
+
+        RenderTargetPool& m_pool;
+        ResolutionController m_controller;
+        GLenum m_colorFormat;
+        GLenum m_depthFormat;
+
+        RenderTarget * m_target = nullptr;
+        Size2<int> m_windowSize;
+        Size2<int> m_renderSize;
+        std::uint64_t m_lastMeasuredFrame = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef HARKEN_ENGINELOOP_H
+#define HARKEN_ENGINELOOP_H
+
+#include "harken_global.h"
+#include "harken_fixedtimestep.h"
+#include "harken_framelimiter.h"
+#include "harken_sdl.h"
+#include "harken_triplebuffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Harken {
+
+    /**
+     * Runs simulation and rendering concurrently on threads of their own. The simulation thread
+     * advances a working copy of the simulation state at a fixed rate and, after each step,
+     * publishes an immutable copy of it (a snapshot) through a TripleBuffer. The render thread
+     * owns the window's OpenGL context and draws the newest published snapshot as often as the
+     * display allows. Neither thread ever blocks on the other, so simulation and rendering overlap
+     * fully, and since a snapshot is never modified once published, the renderer never observes a
+     * state that is halfway through being updated.
+     *
+     * SDL requires events to be handled on the thread that created the window, so the thread
+     * calling run() is left to pump events until the loop is stopped.
+     *
+     * @tparam Snapshot The simulation state. Must be copy-assignable and default-constructible;
+     *                  it is copied once per simulation step, so should be kept reasonably
+     *                  compact.
+     */
+
+    template<typename Snapshot>
+    class EngineLoop {
+    public:
+
+        /**
+         * Advances the state passed to it by the given number of seconds.
+         */
+
+        using SimulateFunction = std::function<void(Snapshot&, double)>;
+
+        /**
+         * Renders the snapshot passed to it and swaps the window's buffers. Called on the render
+         * thread, with the window's OpenGL context current.
+         */
+
+        using RenderFunction = std::function<void(const Snapshot&)>;
+
+        /**
+         * Handles any pending window system events on the thread calling run(), returning
+         * @c false if the loop should stop.
+         */
+
+        using PumpEventsFunction = std::function<bool()>;
+
+        /**
+         * Prepares an engine loop rendering to @p window, whose simulation advances in steps of
+         * @p simulationStep starting from @p initial. Nothing is run until run() is called.
+         */
+
+        EngineLoop(SDLWindow& window, const std::chrono::nanoseconds simulationStep, const Snapshot& initial = Snapshot{})
+            : m_window(window), m_simulationStep{simulationStep}, m_snapshots{initial} {
+        }
+
+        /**
+         * Starts the simulation and render threads, then pumps events on the calling thread until
+         * @p pumpEvents returns @c false or stop() is called. The OpenGL context of the window must
+         * be current on the calling thread; it is handed to the render thread for the duration of
+         * the loop and made current on the calling thread again before run() returns. If either
+         * thread throws an exception, the loop is stopped and the exception is rethrown here.
+         */
+
+        void run(SimulateFunction simulate, RenderFunction render, PumpEventsFunction pumpEvents) {
+
+            m_running = true;
+            m_window.releaseCurrent();
+
+            std::thread simulationThread;
+            std::thread renderThread;
+
+            // If a thread cannot be started, the one already running must be stopped and joined
+            // before the exception propagates, since destroying a joinable thread terminates.
+
+            try {
+                simulationThread = std::thread{[this, &simulate]() {
+                    guard([this, &simulate]() { simulationLoop(simulate); });
+                }};
+                renderThread = std::thread{[this, &render]() {
+                    guard([this, &render]() { renderLoop(render); });
+                }};
+            }
+            catch (...) {
+                stop();
+                if (simulationThread.joinable()) {
+                    simulationThread.join();
+                }
+                m_window.makeCurrent();
+                throw;
+            }
+
+            // Events are polled rather than waited upon so that a stop requested by another
+            // thread is noticed promptly; sleeping between polls keeps this thread from competing
+            // with the others for a core.
+
+            guard([this, &pumpEvents]() {
+                while (m_running) {
+                    if (!pumpEvents()) {
+                        stop();
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+                }
+            });
+
+            simulationThread.join();
+            renderThread.join();
+
+            m_window.makeCurrent();
+
+            if (m_error) {
+                std::rethrow_exception(m_error);
+            }
+        }
+
+        /**
+         * Sets a FrameLimiter to pace rendering with, or removes it if @p frameLimiter is null. The
+         * render thread calls FrameLimiter::beginFrame() before taking each snapshot, so that the
+         * snapshot is as fresh as possible once any waiting is done; the render function is
+         * responsible for calling FrameLimiter::endFrame() and FrameLimiter::presented(). Must not
+         * be called while the loop is running.
+         */
+
+        void setFrameLimiter(FrameLimiter * const frameLimiter) {
+            m_frameLimiter = frameLimiter;
+        }
+
+        /**
+         * Requests that the loop stop. May be called from any thread, including from within the
+         * functions passed to run().
+         */
+
+        void stop() {
+            m_running = false;
+        }
+
+    private:
+
+        /**
+         * Calls @p function, stopping the loop and recording the exception if it throws. Only the
+         * first exception thrown by any thread is kept.
+         */
+
+        template<typename Function>
+        void guard(const Function& function) {
+
+            try {
+                function();
+            }
+            catch (...) {
+
+                std::lock_guard<std::mutex> lock{m_errorMutex};
+                if (!m_error) {
+                    m_error = std::current_exception();
+                }
+
+                stop();
+            }
+        }
+
+        void renderLoop(const RenderFunction& render) {
+
+            m_window.makeCurrent();
+
+            try {
+                while (m_running) {
+
+                    if (m_frameLimiter) {
+                        m_frameLimiter->beginFrame();
+                    }
+
+                    m_snapshots.update();
+                    render(m_snapshots.front());
+                }
+            }
+            catch (...) {
+                m_window.releaseCurrent();
+                throw;
+            }
+
+            m_window.releaseCurrent();
+        }
+
+        void simulationLoop(const SimulateFunction& simulate) {
+
+            using Clock = std::chrono::steady_clock;
+
+            // Sleeping is imprecise, so the real time elapsed is fed through a FixedTimestep: if
+            // the thread oversleeps, it catches up by taking extra steps before publishing,
+            // keeping the simulation deterministic and in step with real time.
+
+            FixedTimestep timestep{std::chrono::duration<double>{m_simulationStep}.count()};
+
+            auto state = m_snapshots.back();
+            auto previous = Clock::now();
+            auto nextStep = previous;
+
+            while (m_running) {
+
+                const auto now = Clock::now();
+                const auto steps = timestep.advance(std::chrono::duration<double>{now - previous}.count());
+                previous = now;
+
+                if (steps > 0) {
+
+                    for (auto i = 0; i < steps; ++i) {
+                        simulate(state, timestep.step());
+                    }
+
+                    m_snapshots.back() = state;
+                    m_snapshots.publish();
+                }
+
+                nextStep += m_simulationStep;
+                std::this_thread::sleep_until(nextStep);
+            }
+        }
+
+        SDLWindow& m_window;
+        const std::chrono::nanoseconds m_simulationStep;
+
+        TripleBuffer<Snapshot> m_snapshots;
+        FrameLimiter * m_frameLimiter = nullptr;
+        std::atomic<bool> m_running{false};
+
+        std::mutex m_errorMutex;
+        std::exception_ptr m_error;
+    };
+}
+
+#endif
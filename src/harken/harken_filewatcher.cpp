@@ -0,0 +1,100 @@
+#include "harken_filewatcher.h"
+#include "harken_path.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace Harken {
+
+#ifdef __linux__
+
+    FileWatcher::FileWatcher()
+        : m_fd{inotify_init1(IN_NONBLOCK | IN_CLOEXEC)} {
+    }
+
+    FileWatcher::~FileWatcher() {
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+    }
+
+    std::vector<std::string> FileWatcher::poll() {
+
+        std::vector<std::string> changed;
+        if (m_fd < 0) {
+            return changed;
+        }
+
+        alignas(inotify_event) char buffer[4096];
+
+        ssize_t length;
+        while ((length = read(m_fd, buffer, sizeof(buffer))) > 0) {
+
+            for (auto offset = ssize_t{0}; offset < length;) {
+
+                inotify_event event;
+                std::memcpy(&event, buffer + offset, sizeof(event));
+
+                const auto directories = m_directories.find(event.wd);
+                if (event.len > 0 && directories != m_directories.end()) {
+
+                    for (const auto& directory : directories->second) {
+
+                        const auto path = directory + (buffer + offset + sizeof(event));
+                        if (m_paths.count(path) && std::find(changed.begin(), changed.end(), path) == changed.end()) {
+                            changed.push_back(path);
+                        }
+                    }
+                }
+
+                offset += static_cast<ssize_t>(sizeof(event) + event.len);
+            }
+        }
+
+        return changed;
+    }
+
+    bool FileWatcher::watch(const std::string& path) {
+
+        if (m_fd < 0) {
+            return false;
+        }
+
+        // Watching a directory a second time gives the same watch descriptor, so directories
+        // shared between files are only watched once (however the paths spell them).
+
+        const auto directory = directoryOf(path);
+        const auto wd = inotify_add_watch(m_fd, directory.empty() ? "." : directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (wd < 0) {
+            return false;
+        }
+
+        m_directories[wd].insert(directory);
+        m_paths.insert(path);
+        return true;
+    }
+
+#else
+
+    FileWatcher::FileWatcher() = default;
+    FileWatcher::~FileWatcher() = default;
+
+    std::vector<std::string> FileWatcher::poll() {
+        return {};
+    }
+
+    bool FileWatcher::watch(const std::string&) {
+        return false;
+    }
+
+#endif
+
+    bool FileWatcher::supported() const {
+        return m_fd >= 0;
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef HARKEN_FILEWATCHER_H
+#define HARKEN_FILEWATCHER_H
+
+#include "harken_global.h"
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * Reports changes to a set of files, using inotify. Each file is watched through its
+     * directory rather than by itself, since editors commonly save by writing a new file and
+     * renaming it over the old one, after which a watch on the old file would report nothing
+     * more. A file is reported as changed when a process that had it open for writing closes it,
+     * or when another file is renamed to it.
+     *
+     * Polling never blocks, so poll() may be called every frame. Where inotify is unavailable
+     * (on platforms other than Linux, or if the process has run out of inotify instances),
+     * supported() is @c false and no changes are ever reported.
+     */
+
+    class FileWatcher {
+    public:
+
+        FileWatcher();
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        /**
+         * Gets the paths of the watched files that have changed since the last call, each once,
+         * spelt as they were passed to watch().
+         */
+
+        std::vector<std::string> poll();
+
+        /**
+         * Determines whether changes can be watched for at all.
+         */
+
+        bool supported() const;
+
+        /**
+         * Starts watching the file at @p path, which need not exist yet, but whose directory
+         * must. Returns whether the file is now being watched.
+         */
+
+        bool watch(const std::string& path);
+
+    private:
+
+        int m_fd = -1;
+        std::unordered_map<int, std::set<std::string>> m_directories;
+        std::set<std::string> m_paths;
+    };
+}
+
+#endif
@@ -0,0 +1,55 @@
+#include "harken_fixedtimestep.h"
+
+#include <cassert>
+#include <cmath>
+
+namespace Harken {
+
+    FixedTimestep::FixedTimestep(const double step, const int maxStepsPerFrame)
+        : m_step{step}, m_maxStepsPerFrame{maxStepsPerFrame} {
+
+        assert(step > 0.0 && "Simulation steps must have a positive length.");
+        assert(maxStepsPerFrame > 0 && "At least one simulation step must be allowed per frame.");
+    }
+
+    int FixedTimestep::advance(const double elapsed) {
+
+        if (elapsed > 0.0) {
+            m_accumulator += elapsed;
+        }
+
+        auto steps = static_cast<int>(std::floor(m_accumulator / m_step));
+        if (steps > m_maxStepsPerFrame) {
+
+            // Keep the fractional part of the backlog so that alpha() remains continuous.
+
+            const auto excess = (steps - m_maxStepsPerFrame) * m_step;
+            m_droppedTime += excess;
+            m_accumulator -= excess;
+            steps = m_maxStepsPerFrame;
+        }
+
+        m_accumulator -= steps * m_step;
+        if (m_accumulator < 0.0) {
+            m_accumulator = 0.0;
+        }
+
+        return steps;
+    }
+
+    double FixedTimestep::alpha() const {
+        return m_accumulator / m_step;
+    }
+
+    double FixedTimestep::droppedTime() const {
+        return m_droppedTime;
+    }
+
+    void FixedTimestep::reset() {
+        m_accumulator = 0.0;
+    }
+
+    double FixedTimestep::step() const {
+        return m_step;
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef HARKEN_FIXEDTIMESTEP_H
+#define HARKEN_FIXEDTIMESTEP_H
+
+#include "harken_global.h"
+
+namespace Harken {
+
+    /**
+     * Accumulates elapsed real time and divides it into simulation steps of a fixed length, so that
+     * a simulation advances deterministically regardless of how long each rendered frame takes.
+     * Time left over that does not make up a whole step is carried forward to the next frame, and
+     * is exposed as an interpolation factor (alpha()) with which rendering can blend between the
+     * previous and current simulation states to present smooth motion at any display rate.
+     *
+     * To avoid the "spiral of death" (in which a slow frame requires more simulation steps, which
+     * make the next frame slower still), the number of steps taken in a single frame is capped;
+     * any backlog beyond the cap is discarded, making the simulation run slower than real time
+     * until the machine catches up.
+     */
+
+    class FixedTimestep {
+    public:
+
+        /**
+         * @param step             The length of each simulation step, in seconds.
+         * @param maxStepsPerFrame The greatest number of steps that advance() will return.
+         */
+
+        explicit FixedTimestep(double step, int maxStepsPerFrame = 8);
+
+        /**
+         * Adds @p elapsed seconds of real time to the accumulator and returns the number of whole
+         * simulation steps that should now be taken, removing them from the accumulator. Negative
+         * elapsed times are treated as zero.
+         */
+
+        int advance(double elapsed);
+
+        /**
+         * Gets the fraction of a step by which real time is ahead of the simulation, in the range
+         * [0, 1). Rendering should show the state that is this fraction of the way from the state
+         * before the most recent step to the state after it.
+         */
+
+        double alpha() const;
+
+        /**
+         * Gets the total simulation time, in seconds, that has been discarded because of the cap
+         * on the number of steps per frame.
+         */
+
+        double droppedTime() const;
+
+        /**
+         * Empties the accumulator, for example after a pause during which the simulation should
+         * not have advanced.
+         */
+
+        void reset();
+
+        double step() const;
+
+    private:
+
+        double m_step;
+        int m_maxStepsPerFrame;
+        double m_accumulator = 0.0;
+        double m_droppedTime = 0.0;
+    };
+}
+
+#endif
@@ -0,0 +1,134 @@
+#include "harken_framebufferobject.h"
+#include "harken_stringbuilder.h"
+
+#include <ios>
+
+namespace Harken {
+
+    FramebufferException::FramebufferException(const GLenum status)
+        : Exception{StringBuilder{} << "Framebuffer object is incomplete. Status: 0x" << std::hex << status},
+          m_status{status} {
+    }
+
+    GLenum FramebufferException::status() const {
+        return m_status;
+    }
+
+    Renderbuffer::Renderbuffer(const GLenum internalFormat, const Size2<int> size, const GLsizei samples)
+        : m_internalFormat{internalFormat}, m_size{size}, m_samples{samples} {
+
+        bind();
+
+        if (samples > 0) {
+            glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, internalFormat, size.width(), size.height());
+        }
+        else {
+            glRenderbufferStorage(GL_RENDERBUFFER, internalFormat, size.width(), size.height());
+        }
+    }
+
+    void Renderbuffer::bind() {
+        glBindRenderbuffer(GL_RENDERBUFFER, m_id);
+    }
+
+    void Renderbuffer::create() {
+        glGenRenderbuffers(1, &m_id);
+    }
+
+    void Renderbuffer::destroy() {
+        glDeleteRenderbuffers(1, &m_id);
+    }
+
+    GLenum Renderbuffer::internalFormat() const {
+        return m_internalFormat;
+    }
+
+    GLsizei Renderbuffer::samples() const {
+        return m_samples;
+    }
+
+    Size2<int> Renderbuffer::size() const {
+        return m_size;
+    }
+
+    RenderTexture::RenderTexture(const GLenum internalFormat, const Size2<int> size)
+        : m_internalFormat{internalFormat}, m_size{size} {
+
+        glBindTexture(GL_TEXTURE_2D, m_id);
+
+        if (GLEW_VERSION_4_2 || GLEW_ARB_texture_storage) {
+            glTexStorage2D(GL_TEXTURE_2D, 1, internalFormat, size.width(), size.height());
+        }
+        else {
+
+            GLenum format;
+            GLenum type;
+            transferFormat(internalFormat, format, type);
+
+            glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, size.width(), size.height(), 0, format, type, nullptr);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+        }
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    void RenderTexture::bind(const GLuint unit) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, m_id);
+    }
+
+    void RenderTexture::create() {
+        glGenTextures(1, &m_id);
+    }
+
+    void RenderTexture::destroy() {
+        glDeleteTextures(1, &m_id);
+    }
+
+    GLenum RenderTexture::internalFormat() const {
+        return m_internalFormat;
+    }
+
+    Size2<int> RenderTexture::size() const {
+        return m_size;
+    }
+
+    void FramebufferObject::attach(const GLenum attachment, Renderbuffer& renderbuffer) {
+        bind();
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, renderbuffer.id());
+    }
+
+    void FramebufferObject::attach(const GLenum attachment, RenderTexture& texture, const GLint level) {
+        bind();
+        glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, texture.id(), level);
+    }
+
+    void FramebufferObject::bind(const GLenum target) {
+        glBindFramebuffer(target, m_id);
+    }
+
+    void FramebufferObject::checkComplete() {
+
+        bind();
+
+        const auto status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            throw FramebufferException{status};
+        }
+    }
+
+    void FramebufferObject::create() {
+        glGenFramebuffers(1, &m_id);
+    }
+
+    void FramebufferObject::destroy() {
+        glDeleteFramebuffers(1, &m_id);
+    }
+
+    void FramebufferObject::unbind(const GLenum target) {
+        glBindFramebuffer(target, 0);
+    }
+}
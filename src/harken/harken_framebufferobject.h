@@ -0,0 +1,201 @@
+#ifndef HARKEN_FRAMEBUFFEROBJECT_H
+#define HARKEN_FRAMEBUFFEROBJECT_H
+
+#include "harken_global.h"
+#include "harken_exception.h"
+#include "harken_glhandle.h"
+#include "harken_size.h"
+#include "harken_texture.h"
+
+#include <GL/glew.h>
+
+namespace Harken {
+
+    /**
+     * Exception type thrown when a framebuffer object is found to be incomplete, and so cannot be
+     * rendered to.
+     */
+
+    class FramebufferException : public Exception {
+    public:
+
+        /**
+         * @param status The status returned by <tt>glCheckFramebufferStatus()</tt>.
+         */
+
+        explicit FramebufferException(GLenum status);
+
+        GLenum status() const;  ///< Gets the status with which the framebuffer was incomplete.
+
+    private:
+
+        GLenum m_status;
+    };
+
+    /**
+     * RAII class that provides a handle to an OpenGL renderbuffer: image storage that can be
+     * rendered to through a framebuffer object but not sampled from by shaders. Renderbuffers suit
+     * attachments such as depth buffers that are only needed while rendering, and multisampled
+     * images that are resolved by blitting.
+     */
+
+    class Renderbuffer : public GLHandle<Renderbuffer> {
+        friend class GLHandle<Renderbuffer>;
+
+    public:
+
+        /**
+         * Creates a renderbuffer and allocates its storage.
+         * @param internalFormat The sized internal format of the storage, such as @c GL_RGBA8 or
+         *                       @c GL_DEPTH24_STENCIL8.
+         * @param size           The dimensions of the storage, in pixels.
+         * @param samples        The number of samples per pixel, or @c 0 for a single-sampled
+         *                       renderbuffer.
+         */
+
+        Renderbuffer(GLenum internalFormat, Size2<int> size, GLsizei samples = 0);
+
+        void bind();                    ///< Makes this the current @c GL_RENDERBUFFER.
+        GLenum internalFormat() const;  ///< Gets the internal format of the storage.
+        GLsizei samples() const;        ///< Gets the number of samples per pixel.
+        Size2<int> size() const;        ///< Gets the dimensions of the storage.
+
+    private:
+
+        /**
+         * Instructs OpenGL to create a single renderbuffer and initialises this Renderbuffer as a
+         * handle to it. Called by the GLHandle base class.
+         */
+
+        void create();
+
+        /**
+         * Instructs OpenGL to delete the renderbuffer managed by this Renderbuffer. Called by the
+         * GLHandle base class.
+         */
+
+        void destroy();
+
+        GLenum m_internalFormat;
+        Size2<int> m_size;
+        GLsizei m_samples;
+    };
+
+    /**
+     * RAII class that provides a handle to a single-level 2D texture intended to be rendered to
+     * through a framebuffer object and later sampled from. Sampling is set up for use as a
+     * full-screen source: bilinear filtering, with coordinates clamped to the edges.
+     */
+
+    class RenderTexture : public GLHandle<RenderTexture> {
+        friend class GLHandle<RenderTexture>;
+
+    public:
+
+        /**
+         * Creates a texture and allocates its storage, using immutable storage where the context
+         * supports it. The texture is left bound to @c GL_TEXTURE_2D on the active texture unit.
+         * @param internalFormat The sized internal format of the texture, such as @c GL_RGBA16F.
+         * @param size           The dimensions of the texture, in pixels.
+         */
+
+        RenderTexture(GLenum internalFormat, Size2<int> size);
+
+        /**
+         * Binds the texture to @c GL_TEXTURE_2D on texture unit @p unit, which becomes the active
+         * texture unit.
+         */
+
+        void bind(GLuint unit = 0);
+
+        GLenum internalFormat() const;  ///< Gets the internal format of the texture.
+        Size2<int> size() const;        ///< Gets the dimensions of the texture.
+
+    private:
+
+        /**
+         * Instructs OpenGL to create a texture and initialises this RenderTexture as a handle to
+         * it. Called by the GLHandle base class.
+         */
+
+        void create();
+
+        /**
+         * Instructs OpenGL to delete the texture managed by this RenderTexture. Called by the
+         * GLHandle base class.
+         */
+
+        void destroy();
+
+        GLenum m_internalFormat;
+        Size2<int> m_size;
+    };
+
+    /**
+     * RAII class that provides a handle to an OpenGL framebuffer object, through which rendering
+     * can be directed into textures and renderbuffers rather than the window.
+     *
+     * The framebuffer object does not own its attachments, which must outlive it (or be detached
+     * first).
+     */
+
+    class FramebufferObject : public GLHandle<FramebufferObject> {
+        friend class GLHandle<FramebufferObject>;
+
+    public:
+
+        /**
+         * Attaches @p renderbuffer at @p attachment (such as @c GL_COLOR_ATTACHMENT0 or
+         * @c GL_DEPTH_STENCIL_ATTACHMENT). The framebuffer object is left bound to
+         * @c GL_FRAMEBUFFER.
+         */
+
+        void attach(GLenum attachment, Renderbuffer& renderbuffer);
+
+        /**
+         * Attaches mipmap level @p level of @p texture at @p attachment. The framebuffer object is
+         * left bound to @c GL_FRAMEBUFFER.
+         */
+
+        void attach(GLenum attachment, RenderTexture& texture, GLint level = 0);
+
+        /**
+         * Binds the framebuffer object to @p target, which may be @c GL_FRAMEBUFFER,
+         * @c GL_READ_FRAMEBUFFER or @c GL_DRAW_FRAMEBUFFER.
+         */
+
+        void bind(GLenum target = GL_FRAMEBUFFER);
+
+        /**
+         * Binds the framebuffer object to @c GL_FRAMEBUFFER and throws a FramebufferException if
+         * it cannot be rendered to with its current attachments. Checking is relatively expensive,
+         * so should be done once after the attachments are set up rather than every frame.
+         */
+
+        void checkComplete();
+
+        /**
+         * Binds the default framebuffer (that of the window) to @p target.
+         */
+
+        static void unbind(GLenum target = GL_FRAMEBUFFER);
+
+    private:
+
+        /**
+         * Instructs OpenGL to create a single framebuffer object and initialises this
+         * FramebufferObject as a handle to it. Called by the GLHandle base class.
+         */
+
+        void create();
+
+        /**
+         * Instructs OpenGL to delete the framebuffer object managed by this FramebufferObject.
+         * Called by the GLHandle base class.
+         */
+
+        void destroy();
+    };
+}
+
+#endif
@@ -0,0 +1,141 @@
+#include "harken_framelimiter.h"
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+namespace Harken {
+
+    namespace {
+
+        // The fraction of the difference between the work estimate and a quicker frame's work time
+        // that the estimate decays by each frame.
+
+        constexpr double WorkEstimateDecay = 0.05;
+
+        FrameLimiter::Clock::duration toDuration(const double seconds) {
+            return std::chrono::duration_cast<FrameLimiter::Clock::duration>(std::chrono::duration<double>{seconds});
+        }
+
+        double toSeconds(const FrameLimiter::Clock::duration duration) {
+            return std::chrono::duration<double>{duration}.count();
+        }
+    }
+
+    FrameLimiter::FrameLimiter(const FramePacing pacing, const double targetFrameTime)
+        : m_pacing{pacing}, m_targetFrameTime{toDuration(targetFrameTime)} {
+
+        assert((pacing == FramePacing::Unlimited || targetFrameTime > 0.0)
+               && "Limited frame pacing requires a positive target frame time.");
+    }
+
+    double FrameLimiter::beginFrame() {
+
+        const auto now = Clock::now();
+        auto start = now;
+
+        switch (m_pacing) {
+
+            case FramePacing::Unlimited:
+                break;
+
+            case FramePacing::Limited:
+
+                // Frames are scheduled a whole frame apart rather than a frame after the previous
+                // one actually started, so that oversleeping does not accumulate. If the schedule
+                // has fallen more than a frame behind, it is abandoned rather than letting several
+                // frames run back-to-back to catch up.
+
+                if (!m_scheduled || now > m_nextFrame + m_targetFrameTime) {
+                    m_nextFrame = now;
+                    m_scheduled = true;
+                }
+
+                start = std::max(now, m_nextFrame);
+                m_nextFrame += m_targetFrameTime;
+                break;
+
+            case FramePacing::LowLatency:
+
+                // The next refresh is assumed to come a refresh interval after the previous swap
+                // returned. Work should start early enough to finish, with a margin, before then.
+
+                if (m_hasPresented) {
+
+                    auto nextPresent = m_lastPresent + m_targetFrameTime;
+                    while (nextPresent < now) {
+                        nextPresent += m_targetFrameTime;
+                    }
+
+                    start = std::max(now, nextPresent - m_workEstimate - m_safetyMargin);
+                }
+                break;
+        }
+
+        if (start > now) {
+            waitUntil(start);
+        }
+
+        m_frameStart = Clock::now();
+        return toSeconds(m_frameStart - now);
+    }
+
+    void FrameLimiter::endFrame() {
+
+        const auto work = Clock::now() - m_frameStart;
+
+        if (work > m_workEstimate) {
+            m_workEstimate = work;
+        }
+        else {
+            m_workEstimate -= toDuration(toSeconds(m_workEstimate - work) * WorkEstimateDecay);
+        }
+    }
+
+    FramePacing FrameLimiter::pacing() const {
+        return m_pacing;
+    }
+
+    double FrameLimiter::predictedWorkTime() const {
+        return toSeconds(m_workEstimate);
+    }
+
+    void FrameLimiter::presented() {
+        m_lastPresent = Clock::now();
+        m_hasPresented = true;
+    }
+
+    void FrameLimiter::setPacing(const FramePacing pacing, const double targetFrameTime) {
+
+        assert((pacing == FramePacing::Unlimited || targetFrameTime > 0.0)
+               && "Limited frame pacing requires a positive target frame time.");
+
+        m_pacing = pacing;
+        m_targetFrameTime = toDuration(targetFrameTime);
+        m_scheduled = false;
+        m_hasPresented = false;
+    }
+
+    void FrameLimiter::setSafetyMargin(const double margin) {
+        m_safetyMargin = toDuration(margin);
+    }
+
+    void FrameLimiter::setSpinThreshold(const double threshold) {
+        m_spinThreshold = toDuration(threshold);
+    }
+
+    double FrameLimiter::targetFrameTime() const {
+        return toSeconds(m_targetFrameTime);
+    }
+
+    void FrameLimiter::waitUntil(const Clock::time_point deadline) const {
+
+        const auto sleepUntil = deadline - m_spinThreshold;
+        if (Clock::now() < sleepUntil) {
+            std::this_thread::sleep_until(sleepUntil);
+        }
+
+        while (Clock::now() < deadline) {
+        }
+    }
+}
@@ -0,0 +1,141 @@
+#ifndef HARKEN_FRAMELIMITER_H
+#define HARKEN_FRAMELIMITER_H
+
+#include "harken_global.h"
+
+#include <chrono>
+
+namespace Harken {
+
+    /**
+     * The policy by which a FrameLimiter paces frames.
+     */
+
+    enum class FramePacing {
+
+        /**
+         * Frames start as soon as the previous one ends, for benchmarking. Combined with
+         * SwapInterval::Immediate, this renders as many frames as the machine can manage.
+         */
+
+        Unlimited,
+
+        /**
+         * Frames start at most once per target frame time, which saves power and gives even frame
+         * times when vsync is off or the display's refresh rate is higher than the target.
+         */
+
+        Limited,
+
+        /**
+         * Frames start as late as possible while still being expected to finish just before the
+         * next swap, so that the input and simulation state they show are as fresh as possible.
+         * The target frame time should be the display's refresh interval. Requires vsync, and
+         * requires presented() to be called after each swap, since the time at which a swap
+         * returns is what indicates when the display refreshes.
+         */
+
+        LowLatency
+    };
+
+    /**
+     * Paces a render loop according to a FramePacing policy. Each frame, call beginFrame() before
+     * doing any work that depends on input or simulation state, endFrame() once the frame's
+     * rendering commands have been issued (just before swapping buffers), and presented() just
+     * after the swap returns.
+     *
+     * Waiting is precise: the limiter sleeps until shortly before the time it is waiting for, since
+     * the operating system may oversleep by a millisecond or more, then spins for the remainder.
+     */
+
+    class FrameLimiter {
+    public:
+
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @param pacing          The pacing policy.
+         * @param targetFrameTime The time between the starts of frames (or for LowLatency pacing,
+         *                        between refreshes of the display), in seconds. Ignored for
+         *                        Unlimited pacing.
+         */
+
+        explicit FrameLimiter(FramePacing pacing = FramePacing::Unlimited, double targetFrameTime = 0.0);
+
+        /**
+         * Waits as necessary until the next frame should start, and returns the time spent waiting,
+         * in seconds.
+         */
+
+        double beginFrame();
+
+        /**
+         * Records that the current frame's work is done, for estimating how long future frames will
+         * take.
+         */
+
+        void endFrame();
+
+        /**
+         * Records that the current frame has just been presented; that is, that the buffer swap
+         * has returned.
+         */
+
+        void presented();
+
+        FramePacing pacing() const;      ///< Gets the pacing policy.
+        double targetFrameTime() const;  ///< Gets the target frame time, in seconds.
+
+        /**
+         * Gets the estimated time that a frame's work takes, in seconds. The estimate rises
+         * immediately to meet any frame that takes longer, but only decays slowly after one that is
+         * quicker, so that an occasional quick frame does not make the next start too late.
+         */
+
+        double predictedWorkTime() const;
+
+        /**
+         * Sets the time to leave between a frame's work being expected to finish and the display
+         * refreshing under LowLatency pacing, to absorb variation in frame times. Defaults to one
+         * millisecond.
+         */
+
+        void setSafetyMargin(double margin);
+
+        /**
+         * Sets the time before a deadline at which waiting stops sleeping and starts spinning.
+         * Larger values are more precise but use more CPU time. Defaults to two milliseconds.
+         */
+
+        void setSpinThreshold(double threshold);
+
+        /**
+         * Changes the pacing policy and target frame time, for example to switch to unlimited
+         * frames for benchmarking. The schedule of frames starts afresh with the next frame.
+         */
+
+        void setPacing(FramePacing pacing, double targetFrameTime);
+
+    private:
+
+        /**
+         * Blocks until @p deadline, sleeping and then spinning as described above.
+         */
+
+        void waitUntil(Clock::time_point deadline) const;
+
+        FramePacing m_pacing;
+        Clock::duration m_targetFrameTime;
+        Clock::duration m_safetyMargin = std::chrono::milliseconds{1};
+        Clock::duration m_spinThreshold = std::chrono::milliseconds{2};
+
+        bool m_scheduled = false;
+        Clock::time_point m_nextFrame;
+        Clock::time_point m_frameStart;
+        Clock::time_point m_lastPresent;
+        bool m_hasPresented = false;
+        Clock::duration m_workEstimate = Clock::duration::zero();
+    };
+}
+
+#endif
@@ -0,0 +1,169 @@
+#include "harken_framesync.h"
+#include "harken_exception.h"
+
+#include <cassert>
+#include <chrono>
+
+namespace Harken {
+
+    namespace {
+
+        // How long each call to glClientWaitSync() may block before returning, in nanoseconds.
+        // Waiting repeats until the fence is signalled, so this only bounds how long the thread is
+        // out of our hands at a time.
+
+        constexpr GLuint64 FenceWaitTimeout = 100000000;
+
+        /**
+         * Blocks until @p fence is signalled, throwing an Exception if waiting fails.
+         */
+
+        void waitForFence(const GLsync fence) {
+
+            // Commands must be flushed for the fence to be reachable at all, but only once.
+
+            auto flags = static_cast<GLbitfield>(GL_SYNC_FLUSH_COMMANDS_BIT);
+            while (true) {
+
+                const auto result = glClientWaitSync(fence, flags, FenceWaitTimeout);
+                if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED) {
+                    return;
+                }
+
+                if (result == GL_WAIT_FAILED) {
+                    throw Exception{"Could not wait for a frame fence to be signalled."};
+                }
+
+                flags = 0;
+            }
+        }
+    }
+
+    FrameSync::FrameSync(const int framesInFlight)
+        : m_framesInFlight{framesInFlight},
+          m_timerQueries{GLEW_VERSION_3_3 || GLEW_ARB_timer_query} {
+
+        assert(framesInFlight >= 1 && framesInFlight <= MaxFramesInFlight && "Unsupported number of frames in flight.");
+
+        if (m_timerQueries) {
+            for (auto& slot : m_slots) {
+                glGenQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+            }
+        }
+    }
+
+    FrameSync::~FrameSync() {
+
+        for (auto& slot : m_slots) {
+
+            if (slot.fence) {
+                glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceWaitTimeout);
+                glDeleteSync(slot.fence);
+            }
+
+            if (m_timerQueries) {
+                glDeleteQueries(static_cast<GLsizei>(slot.queries.size()), slot.queries.data());
+            }
+        }
+    }
+
+    int FrameSync::beginFrame() {
+
+        m_frameIndex = static_cast<int>(m_frameNumber % static_cast<std::uint64_t>(m_framesInFlight));
+        ++m_frameNumber;
+
+        auto& slot = m_slots[m_frameIndex];
+
+        const auto waitStart = std::chrono::steady_clock::now();
+        retire(slot);
+        m_cpuWaitTime = std::chrono::duration<double>{std::chrono::steady_clock::now() - waitStart}.count();
+
+        if (m_timerQueries) {
+            glQueryCounter(slot.queries[0], GL_TIMESTAMP);
+        }
+
+        return m_frameIndex;
+    }
+
+    double FrameSync::cpuWaitTime() const {
+        return m_cpuWaitTime;
+    }
+
+    void FrameSync::endFrame() {
+
+        auto& slot = m_slots[m_frameIndex];
+
+        if (m_timerQueries) {
+            glQueryCounter(slot.queries[1], GL_TIMESTAMP);
+            slot.frameNumber = m_frameNumber;
+        }
+
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    int FrameSync::frameIndex() const {
+        return m_frameIndex;
+    }
+
+    std::uint64_t FrameSync::frameNumber() const {
+        return m_frameNumber;
+    }
+
+    int FrameSync::framesInFlight() const {
+        return m_framesInFlight;
+    }
+
+    const FrameGPUTimings& FrameSync::gpuTimings() const {
+        return m_gpuTimings;
+    }
+
+    void FrameSync::retire(Slot& slot) {
+
+        if (!slot.fence) {
+            return;
+        }
+
+        waitForFence(slot.fence);
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+
+        // The fence follows the end timestamp, so both query results are now available without
+        // stalling.
+
+        if (m_timerQueries && slot.frameNumber != 0) {
+
+            GLuint64 start = 0;
+            GLuint64 end = 0;
+            glGetQueryObjectui64v(slot.queries[0], GL_QUERY_RESULT, &start);
+            glGetQueryObjectui64v(slot.queries[1], GL_QUERY_RESULT, &end);
+
+            m_gpuTimings.frameNumber = slot.frameNumber;
+            m_gpuTimings.busyTime = static_cast<double>(end - start) * 1.0e-9;
+            m_gpuTimings.waitTime = m_lastGPUEnd != 0 && start > m_lastGPUEnd
+                ? static_cast<double>(start - m_lastGPUEnd) * 1.0e-9
+                : 0.0;
+
+            m_lastGPUEnd = end;
+            slot.frameNumber = 0;
+        }
+    }
+
+    void FrameSync::setFramesInFlight(const int framesInFlight) {
+
+        assert(framesInFlight >= 1 && framesInFlight <= MaxFramesInFlight && "Unsupported number of frames in flight.");
+
+        waitIdle();
+        m_framesInFlight = framesInFlight;
+    }
+
+    void FrameSync::waitIdle() {
+
+        // Frames finish in the order they were submitted, so retiring the slots oldest first keeps
+        // the GPU wait times meaningful.
+
+        for (auto i = 0; i < m_framesInFlight; ++i) {
+            const auto index = static_cast<int>((m_frameNumber + i) % static_cast<std::uint64_t>(m_framesInFlight));
+            retire(m_slots[index]);
+        }
+    }
+}
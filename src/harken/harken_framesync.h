@@ -0,0 +1,185 @@
+#ifndef HARKEN_FRAMESYNC_H
+#define HARKEN_FRAMESYNC_H
+
+#include "harken_global.h"
+
+#include <GL/glew.h>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * GPU timings of a single frame, measured with timestamp queries.
+     */
+
+    struct FrameGPUTimings {
+
+        std::uint64_t frameNumber = 0;  ///< The number of the frame measured (see FrameSync::frameNumber()).
+        double busyTime = 0.0;          ///< Seconds from the GPU starting the frame's commands to finishing them.
+
+        /**
+         * Seconds for which the GPU sat idle between finishing the previous frame and starting this
+         * one, waiting for the CPU to submit work. Consistently non-zero values mean the frame rate
+         * is limited by the CPU, and that allowing more frames in flight will not help.
+         */
+
+        double waitTime = 0.0;
+    };
+
+    /**
+     * Limits how far the CPU may run ahead of the GPU, using a fence per frame. Without such a
+     * limit, the driver may queue several frames of commands, each of which adds a frame of
+     * latency between input and its display. With one frame in flight, the CPU waits for each frame
+     * to finish on the GPU before starting the next, which minimises latency but serialises the two
+     * processors; with two or three, the CPU prepares the next frame while the GPU works on earlier
+     * ones, improving throughput at the cost of latency.
+     *
+     * Each frame in flight is given a slot index (frameIndex()), and the slot is only reused once
+     * the GPU has finished the frame that previously used it. Resources written by the CPU each
+     * frame (streaming buffers, uniform rings, and so on) should therefore be duplicated per slot
+     * (see PerFrame) so that the CPU never overwrites data the GPU is still reading, and never
+     * stalls in the driver waiting for it.
+     *
+     * Each frame, call beginFrame() before writing any per-frame resources, and endFrame() after
+     * swapping buffers. An OpenGL 3.2 (or @c GL_ARB_sync) context must be current whenever a
+     * FrameSync is used or destroyed.
+     */
+
+    class FrameSync {
+    public:
+
+        static constexpr int MaxFramesInFlight = 3;
+
+        /**
+         * @param framesInFlight The greatest number of frames that may be submitted but not yet
+         *                       finished by the GPU, from 1 to MaxFramesInFlight.
+         */
+
+        explicit FrameSync(int framesInFlight = 2);
+
+        /**
+         * Waits for every frame in flight to finish, then releases the fences and queries used.
+         */
+
+        ~FrameSync();
+
+        FrameSync(const FrameSync&) = delete;
+        FrameSync& operator=(const FrameSync&) = delete;
+
+        /**
+         * Waits until the GPU has finished the frame that last used the coming frame's slot, and
+         * returns the slot index. Throws an Exception if waiting fails.
+         */
+
+        int beginFrame();
+
+        /**
+         * Marks the end of the current frame's commands with a fence.
+         */
+
+        void endFrame();
+
+        /**
+         * Gets the number of seconds that the CPU spent blocked in the most recent beginFrame()
+         * waiting for the GPU. Consistently non-zero values mean the frame rate is limited by the
+         * GPU.
+         */
+
+        double cpuWaitTime() const;
+
+        int frameIndex() const;             ///< Gets the slot index of the current frame.
+        std::uint64_t frameNumber() const;  ///< Gets the number of frames begun so far.
+        int framesInFlight() const;         ///< Gets the greatest number of frames in flight.
+
+        /**
+         * Gets the GPU timings of the most recent frame to have finished, which is generally
+         * framesInFlight() frames behind the current one. Returns timings with a @c frameNumber of
+         * @c 0 if none are available yet, or if the context does not support timestamp queries.
+         */
+
+        const FrameGPUTimings& gpuTimings() const;
+
+        /**
+         * Changes the greatest number of frames in flight, waiting for every frame currently in
+         * flight to finish first.
+         */
+
+        void setFramesInFlight(int framesInFlight);
+
+        /**
+         * Waits for every frame in flight to finish.
+         */
+
+        void waitIdle();
+
+    private:
+
+        struct Slot {
+            GLsync fence = nullptr;
+            std::array<GLuint, 2> queries{{0, 0}};  ///< Timestamps of the start and end of the frame.
+            std::uint64_t frameNumber = 0;          ///< The frame last measured with this slot's queries.
+        };
+
+        /**
+         * Waits for the fence of @p slot (if it has one), then deletes it and reads back the
+         * slot's timestamp queries.
+         */
+
+        void retire(Slot& slot);
+
+        std::array<Slot, MaxFramesInFlight> m_slots;
+        int m_framesInFlight;
+        bool m_timerQueries;
+
+        std::uint64_t m_frameNumber = 0;
+        int m_frameIndex = 0;
+        double m_cpuWaitTime = 0.0;
+
+        FrameGPUTimings m_gpuTimings;
+        GLuint64 m_lastGPUEnd = 0;
+    };
+
+    /**
+     * A resource duplicated for each frame slot of a FrameSync, so that each frame in flight may
+     * write its own copy. All copies are constructed from the same arguments.
+     */
+
+    template<typename T>
+    class PerFrame {
+    public:
+
+        template<typename... Args>
+        explicit PerFrame(const Args&... args) {
+
+            m_resources.reserve(FrameSync::MaxFramesInFlight);
+            for (auto i = 0; i < FrameSync::MaxFramesInFlight; ++i) {
+                m_resources.emplace_back(args...);
+            }
+        }
+
+        /**
+         * Gets the copy belonging to the current frame of @p sync.
+         */
+
+        T& current(const FrameSync& sync) {
+            return m_resources[sync.frameIndex()];
+        }
+
+        T& operator[](const int frameIndex) {
+            return m_resources[frameIndex];
+        }
+
+        const T& operator[](const int frameIndex) const {
+            return m_resources[frameIndex];
+        }
+
+    private:
+
+        std::vector<T> m_resources;
+    };
+}
+
+#endif
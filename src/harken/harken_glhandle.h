@@ -72,6 +72,15 @@ namespace Harken {
 
             return *this;
         }
+
+        /**
+         * Gets the name assigned by OpenGL to the object managed by this handle, or @c 0 if the
+         * handle is null (having been moved from).
+         */
+
+        GLuint id() const {
+            return m_id;
+        }
         
     protected:
         
@@ -9,6 +9,7 @@
 
 namespace Harken {
     
+    using Vector2f = Vector2<GLfloat>;
     using Vector3f = Vector3<GLfloat>;
     using Vector4f = Vector4<GLfloat>;
     using Matrix4f = Matrix4<GLfloat>;
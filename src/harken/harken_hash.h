@@ -0,0 +1,68 @@
+#ifndef HARKEN_HASH_H
+#define HARKEN_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace Harken {
+
+    /**
+     * Computes a 64-bit FNV-1a hash incrementally over a sequence of values. The hash is stable
+     * across runs and platforms of the same endianness, so (unlike @c std::hash) it may be used to
+     * key data stored on disk. It is not cryptographic.
+     */
+
+    class Hasher {
+    public:
+
+        /**
+         * Adds @p size bytes starting at @p data to the hash.
+         */
+
+        Hasher& add(const void * const data, const std::size_t size) {
+
+            const auto bytes = static_cast<const unsigned char *>(data);
+            for (std::size_t i = 0; i < size; ++i) {
+                m_value = (m_value ^ bytes[i]) * 0x100000001b3ull;
+            }
+
+            return *this;
+        }
+
+        /**
+         * Adds the length and then the contents of @p string to the hash, so that (for example)
+         * adding "ab" then "c" gives a different hash to adding "a" then "bc".
+         */
+
+        Hasher& add(const std::string& string) {
+            add(static_cast<std::uint64_t>(string.size()));
+            return add(string.data(), string.size());
+        }
+
+        /**
+         * Adds the object representation of @p value, which must be of an arithmetic or
+         * enumeration type, to the hash.
+         */
+
+        template<typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value || std::is_enum<T>::value>>
+        Hasher& add(const T value) {
+            return add(&value, sizeof(value));
+        }
+
+        /**
+         * Gets the hash of everything added so far.
+         */
+
+        std::uint64_t value() const {
+            return m_value;
+        }
+
+    private:
+
+        std::uint64_t m_value = 0xcbf29ce484222325ull;
+    };
+}
+
+#endif
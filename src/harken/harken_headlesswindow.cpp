@@ -0,0 +1,326 @@
+#include "harken_headlesswindow.h"
+#include "harken_stringbuilder.h"
+
+// Nothing here needs the native windowing system types, so EGL is kept from including the X11
+// headers (whose macros collide with all sorts of names).
+
+#define EGL_NO_X11
+#define MESA_EGL_NO_X11_HEADERS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstring>
+#include <ios>
+#include <vector>
+
+namespace Harken {
+
+    namespace {
+
+        /**
+         * Determines whether the space-separated extension string @p extensions includes
+         * @p extension.
+         */
+
+        bool hasExtension(const char * const extensions, const char * const extension) {
+
+            if (!extensions) {
+                return false;
+            }
+
+            const auto length = std::strlen(extension);
+            for (auto start = extensions; (start = std::strstr(start, extension)) != nullptr; start += length) {
+
+                const auto atStart = start == extensions || start[-1] == ' ';
+                const auto atEnd = start[length] == ' ' || start[length] == '\0';
+
+                if (atStart && atEnd) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /**
+         * Gets a display that needs no windowing system, if the EGL implementation offers one, or
+         * the default display otherwise.
+         */
+
+        EGLDisplay openDisplay() {
+
+            const auto clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+            const auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+            if (getPlatformDisplay && hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+
+                const auto display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+                if (display != EGL_NO_DISPLAY) {
+                    return display;
+                }
+            }
+
+            const auto queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+
+            if (getPlatformDisplay && queryDevices && hasExtension(clientExtensions, "EGL_EXT_platform_device")) {
+
+                EGLDeviceEXT device;
+                EGLint deviceCount = 0;
+
+                if (queryDevices(1, &device, &deviceCount) && deviceCount > 0) {
+                    const auto display = getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, device, nullptr);
+                    if (display != EGL_NO_DISPLAY) {
+                        return display;
+                    }
+                }
+            }
+
+            return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        }
+
+        /**
+         * A context sharing objects with a HeadlessWindow's, with a pbuffer of its own to be
+         * current with.
+         */
+
+        class EGLSharedContext : public SharedGLContext {
+        public:
+
+            EGLSharedContext(const EGLDisplay display, const EGLSurface surface, const EGLContext context)
+                : m_display{display}, m_surface{surface}, m_context{context} {
+            }
+
+            ~EGLSharedContext() override {
+
+                if (eglGetCurrentContext() == m_context) {
+                    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+                }
+
+                eglDestroyContext(m_display, m_context);
+                eglDestroySurface(m_display, m_surface);
+            }
+
+            void makeCurrent() override {
+                if (!eglMakeCurrent(m_display, m_surface, m_surface, m_context)) {
+                    throw EGLException{"Could not make a shared EGL OpenGL context current."};
+                }
+            }
+
+            void releaseCurrent() override {
+                if (!eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT)) {
+                    throw EGLException{"Could not release a shared EGL OpenGL context."};
+                }
+            }
+
+        private:
+
+            EGLDisplay m_display;
+            EGLSurface m_surface;
+            EGLContext m_context;
+        };
+
+        /**
+         * Gets the attributes with which to create a core profile context of the given version.
+         */
+
+        std::vector<EGLint> contextAttributes(const int majorVersion, const int minorVersion) {
+            return {
+                EGL_CONTEXT_MAJOR_VERSION, majorVersion,
+                EGL_CONTEXT_MINOR_VERSION, minorVersion,
+                EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                EGL_NONE
+            };
+        }
+    }
+
+    EGLException::EGLException(const char * const message)
+        : Exception{StringBuilder{} << message << " Error: 0x" << std::hex << eglGetError()} {
+    }
+
+    HeadlessWindow::HeadlessWindow(const int width, const int height, const int majorVersion, const int minorVersion)
+        : m_width{width}, m_height{height}, m_majorVersion{majorVersion}, m_minorVersion{minorVersion} {
+
+        const auto display = openDisplay();
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+            throw EGLException{"Could not initialise an EGL display."};
+        }
+
+        m_display = display;
+
+        if (!eglBindAPI(EGL_OPENGL_API)) {
+            throw EGLException{"Could not bind the OpenGL API through EGL."};
+        }
+
+        const EGLint configAttributes[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_BLUE_SIZE, 8,
+            EGL_ALPHA_SIZE, 8,
+            EGL_DEPTH_SIZE, 24,
+            EGL_STENCIL_SIZE, 8,
+            EGL_NONE
+        };
+
+        EGLConfig config;
+        EGLint configCount = 0;
+
+        if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount == 0) {
+            throw EGLException{"Could not find an EGL configuration for offscreen OpenGL rendering."};
+        }
+
+        m_config = config;
+
+        const EGLint surfaceAttributes[] = {
+            EGL_WIDTH, width,
+            EGL_HEIGHT, height,
+            EGL_NONE
+        };
+
+        m_surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+        if (m_surface == EGL_NO_SURFACE) {
+            throw EGLException{"Could not create an EGL pbuffer surface."};
+        }
+
+        m_context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes(majorVersion, minorVersion).data());
+        if (m_context == EGL_NO_CONTEXT) {
+            const EGLException exception{"Could not create an EGL OpenGL context."};
+            destroy();
+            throw exception;
+        }
+
+        try {
+            makeCurrent();
+        }
+        catch (...) {
+            destroy();
+            throw;
+        }
+    }
+
+    HeadlessWindow::HeadlessWindow(HeadlessWindow&& rhs)
+        : m_display{rhs.m_display}, m_config{rhs.m_config}, m_surface{rhs.m_surface}, m_context{rhs.m_context},
+          m_width{rhs.m_width}, m_height{rhs.m_height},
+          m_majorVersion{rhs.m_majorVersion}, m_minorVersion{rhs.m_minorVersion} {
+
+        rhs.m_display = nullptr;
+        rhs.m_config  = nullptr;
+        rhs.m_surface = nullptr;
+        rhs.m_context = nullptr;
+    }
+
+    HeadlessWindow::~HeadlessWindow() {
+        destroy();
+    }
+
+    HeadlessWindow& HeadlessWindow::operator=(HeadlessWindow&& rhs) {
+
+        destroy();
+
+        m_display      = rhs.m_display;
+        m_config       = rhs.m_config;
+        m_surface      = rhs.m_surface;
+        m_context      = rhs.m_context;
+        m_width        = rhs.m_width;
+        m_height       = rhs.m_height;
+        m_majorVersion = rhs.m_majorVersion;
+        m_minorVersion = rhs.m_minorVersion;
+
+        rhs.m_display = nullptr;
+        rhs.m_config  = nullptr;
+        rhs.m_surface = nullptr;
+        rhs.m_context = nullptr;
+
+        return *this;
+    }
+
+    float HeadlessWindow::aspectRatio() const {
+        return m_height ? static_cast<float>(m_width) / static_cast<float>(m_height) : 0.0f;
+    }
+
+    std::unique_ptr<SharedGLContext> HeadlessWindow::createSharedContext() {
+
+        const EGLint surfaceAttributes[] = {
+            EGL_WIDTH, 1,
+            EGL_HEIGHT, 1,
+            EGL_NONE
+        };
+
+        const auto surface = eglCreatePbufferSurface(m_display, m_config, surfaceAttributes);
+        if (surface == EGL_NO_SURFACE) {
+            throw EGLException{"Could not create an EGL pbuffer surface for a shared context."};
+        }
+
+        const auto context = eglCreateContext(m_display, m_config, m_context,
+                                              contextAttributes(m_majorVersion, m_minorVersion).data());
+
+        if (context == EGL_NO_CONTEXT) {
+            const EGLException exception{"Could not create a shared EGL OpenGL context."};
+            eglDestroySurface(m_display, surface);
+            throw exception;
+        }
+
+        return std::make_unique<EGLSharedContext>(m_display, surface, context);
+    }
+
+    void HeadlessWindow::destroy() {
+
+        if (!m_display) {
+            return;
+        }
+
+        // The display itself is left initialised: EGL returns the same display to every caller in
+        // the process, and terminating it would destroy the contexts of other HeadlessWindows.
+
+        if (eglGetCurrentContext() == m_context) {
+            eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        }
+
+        if (m_context) {
+            eglDestroyContext(m_display, m_context);
+        }
+
+        if (m_surface) {
+            eglDestroySurface(m_display, m_surface);
+        }
+
+        m_display = nullptr;
+        m_config  = nullptr;
+        m_surface = nullptr;
+        m_context = nullptr;
+    }
+
+    void HeadlessWindow::makeCurrent() {
+        if (!eglMakeCurrent(m_display, m_surface, m_surface, m_context)) {
+            throw EGLException{"Could not make an EGL OpenGL context current."};
+        }
+    }
+
+    std::vector<GLubyte> HeadlessWindow::readPixels() const {
+
+        std::vector<GLubyte> pixels(static_cast<std::size_t>(m_width) * static_cast<std::size_t>(m_height) * 4);
+
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+        return pixels;
+    }
+
+    void HeadlessWindow::releaseCurrent() {
+        if (!eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT)) {
+            throw EGLException{"Could not release an EGL OpenGL context."};
+        }
+    }
+
+    Size2<int> HeadlessWindow::size() const {
+        return {m_width, m_height};
+    }
+
+    void HeadlessWindow::swapBuffers() {
+        if (m_context) {
+            glFinish();
+        }
+    }
+}
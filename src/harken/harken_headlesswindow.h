@@ -0,0 +1,131 @@
+#ifndef HARKEN_HEADLESSWINDOW_H
+#define HARKEN_HEADLESSWINDOW_H
+
+#include "harken_global.h"
+#include "harken_exception.h"
+#include "harken_sharedglcontext.h"
+#include "harken_size.h"
+
+#include <GL/glew.h>
+
+#include <memory>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * Exception type thrown when an error is reported by the EGL API. In addition to the message
+     * provided to the constructor, objects of this class report the code returned by
+     * <tt>eglGetError()</tt> in the string returned by what().
+     */
+
+    class EGLException : public Exception {
+    public:
+
+        /**
+         * Constructs the EGLException to display a specified message along with the EGL error
+         * code. @p message need not exist beyond the construction of the EGLException object.
+         */
+
+        explicit EGLException(const char * message);
+    };
+
+    /**
+     * An OpenGL rendering context with an offscreen drawable, for running the rendering pipeline
+     * on machines with no display and (using Mesa's llvmpipe) no GPU, such as build and CI
+     * machines. The context is created through EGL, preferring Mesa's surfaceless platform, then
+     * the first EGL device, and finally the default display, and renders to a pbuffer surface;
+     * since a pbuffer is the context's default framebuffer, code that renders to framebuffer
+     * @c 0 works unchanged.
+     *
+     * HeadlessWindow offers the same interface as SDLWindow for querying its size, swapping and
+     * managing which thread its context is current on, so code written against one works with the
+     * other. The context is made current on the constructing thread.
+     *
+     * GLEW can be initialised as usual once a HeadlessWindow exists, with one caveat: GLEW builds
+     * that load extensions through GLX report @c GLEW_ERROR_NO_GLX_DISPLAY when there is no X
+     * display, after having loaded the core and extension entry points successfully. That error
+     * may be ignored.
+     */
+
+    class HeadlessWindow {
+    public:
+
+        /**
+         * Creates a context of the given OpenGL core profile version, rendering to a drawable of
+         * @p width by @p height pixels. Throws an EGLException if no such context can be created.
+         */
+
+        HeadlessWindow(int width, int height, int majorVersion = 3, int minorVersion = 3);
+
+        /**
+         * Destroys the context and its drawable.
+         */
+
+        ~HeadlessWindow();
+
+        HeadlessWindow(const HeadlessWindow&) = delete;
+        HeadlessWindow& operator=(const HeadlessWindow&) = delete;
+
+        /**
+         * Constructs a new HeadlessWindow that takes over the context of @p rhs, which is left
+         * without one.
+         */
+
+        HeadlessWindow(HeadlessWindow&& rhs);
+
+        /**
+         * @see HeadlessWindow(HeadlessWindow&&)
+         */
+
+        HeadlessWindow& operator=(HeadlessWindow&& rhs);
+
+        float aspectRatio() const;  ///< Gets the aspect ratio of the drawable.
+        Size2<int> size() const;    ///< Gets the pixel dimensions of the drawable.
+
+        /**
+         * Creates another OpenGL context sharing objects with this one, for use on another thread
+         * (see SharedGLContext). The new context has a drawable of its own, a single pixel in
+         * size, and is not made current. Throws an EGLException if it cannot be created.
+         */
+
+        std::unique_ptr<SharedGLContext> createSharedContext();
+
+        /**
+         * Finishes the frame. Since nothing is presented, this waits for all rendering to finish
+         * instead (with <tt>glFinish()</tt>), so that frame times measured around calls to it
+         * include the full cost of rendering rather than just that of issuing commands.
+         */
+
+        void swapBuffers();
+
+        void makeCurrent();     ///< @see SDLWindow::makeCurrent()
+        void releaseCurrent();  ///< @see SDLWindow::releaseCurrent()
+
+        /**
+         * Reads back the contents of the drawable as rows of 8-bit RGBA pixels, bottom row first,
+         * for comparing rendered output against reference images. The context must be current.
+         */
+
+        std::vector<GLubyte> readPixels() const;
+
+    private:
+
+        void destroy();
+
+        // The EGL handle types are all pointers, and are stored as such so that this header need
+        // not include EGL's, which pull in the windowing system's headers on some platforms.
+
+        void * m_display = nullptr;
+        void * m_config = nullptr;
+        void * m_surface = nullptr;
+        void * m_context = nullptr;
+
+        int m_width = 0;
+        int m_height = 0;
+        int m_majorVersion = 0;
+        int m_minorVersion = 0;
+    };
+}
+
+#endif
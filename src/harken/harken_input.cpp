@@ -0,0 +1,272 @@
+#include "harken_input.h"
+
+#include <algorithm>
+
+namespace Harken {
+
+    namespace {
+
+        // The number of events fetched from SDL by each call to SDL_PeepEvents(). Bursts of mouse
+        // motion can produce many events per frame, and fetching them in batches avoids a call
+        // (and a lock of SDL's event queue) per event.
+
+        constexpr int DrainBatchSize = 64;
+
+        // The weight given to each new sample in the moving average of the input latency.
+
+        constexpr double LatencySmoothing = 0.1;
+
+        bool isValidButton(const int button) {
+            return button >= 1 && button <= InputState::MouseButtonCount;
+        }
+
+        bool isValidScancode(const SDL_Scancode scancode) {
+            return scancode >= 0 && scancode < SDL_NUM_SCANCODES;
+        }
+    }
+
+    void InputState::apply(const SDL_Event& event, const Uint64 timestamp) {
+
+        switch (event.type) {
+
+            case SDL_KEYDOWN:
+                if (isValidScancode(event.key.keysym.scancode) && !event.key.repeat) {
+                    m_keysDown.set(event.key.keysym.scancode);
+                    m_keysPressed.set(event.key.keysym.scancode);
+                }
+                break;
+
+            case SDL_KEYUP:
+                if (isValidScancode(event.key.keysym.scancode)) {
+                    m_keysDown.reset(event.key.keysym.scancode);
+                    m_keysReleased.set(event.key.keysym.scancode);
+                }
+                break;
+
+            case SDL_MOUSEMOTION:
+                m_mousePosition = Vector2<int>{event.motion.x, event.motion.y};
+                m_mouseMotion += Vector2<int>{event.motion.xrel, event.motion.yrel};
+                break;
+
+            case SDL_MOUSEBUTTONDOWN:
+                if (isValidButton(event.button.button)) {
+                    m_buttonsDown.set(event.button.button - 1);
+                    m_buttonsPressed.set(event.button.button - 1);
+                }
+                break;
+
+            case SDL_MOUSEBUTTONUP:
+                if (isValidButton(event.button.button)) {
+                    m_buttonsDown.reset(event.button.button - 1);
+                    m_buttonsReleased.set(event.button.button - 1);
+                }
+                break;
+
+            case SDL_MOUSEWHEEL:
+                m_wheelMotion += Vector2<int>{event.wheel.x, event.wheel.y};
+                break;
+
+            default:
+                return;
+        }
+
+        ++m_eventCount;
+        m_newestEventTime = timestamp;
+
+        if (m_oldestFrameEventTime == 0) {
+            m_oldestFrameEventTime = timestamp;
+        }
+    }
+
+    void InputState::beginFrame() {
+
+        m_keysPressed.reset();
+        m_keysReleased.reset();
+        m_buttonsPressed.reset();
+        m_buttonsReleased.reset();
+
+        m_mouseMotion = Vector2<int>{0, 0};
+        m_wheelMotion = Vector2<int>{0, 0};
+
+        m_eventCount = 0;
+        m_oldestFrameEventTime = 0;
+    }
+
+    std::size_t InputState::eventCount() const {
+        return m_eventCount;
+    }
+
+    bool InputState::keyDown(const SDL_Scancode scancode) const {
+        return isValidScancode(scancode) && m_keysDown.test(scancode);
+    }
+
+    bool InputState::keyPressed(const SDL_Scancode scancode) const {
+        return isValidScancode(scancode) && m_keysPressed.test(scancode);
+    }
+
+    bool InputState::keyReleased(const SDL_Scancode scancode) const {
+        return isValidScancode(scancode) && m_keysReleased.test(scancode);
+    }
+
+    bool InputState::mouseButtonDown(const int button) const {
+        return isValidButton(button) && m_buttonsDown.test(button - 1);
+    }
+
+    bool InputState::mouseButtonPressed(const int button) const {
+        return isValidButton(button) && m_buttonsPressed.test(button - 1);
+    }
+
+    bool InputState::mouseButtonReleased(const int button) const {
+        return isValidButton(button) && m_buttonsReleased.test(button - 1);
+    }
+
+    Vector2<int> InputState::mouseMotion() const {
+        return m_mouseMotion;
+    }
+
+    Vector2<int> InputState::mousePosition() const {
+        return m_mousePosition;
+    }
+
+    Uint64 InputState::newestEventTime() const {
+        return m_newestEventTime;
+    }
+
+    Uint64 InputState::oldestFrameEventTime() const {
+        return m_oldestFrameEventTime;
+    }
+
+    Vector2<int> InputState::wheelMotion() const {
+        return m_wheelMotion;
+    }
+
+    InputSystem::InputSystem()
+        : m_eventThread{std::this_thread::get_id()} {
+    }
+
+    InputState InputSystem::beginFrame() {
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        const auto snapshot = m_state;
+        m_state.beginFrame();
+
+        return snapshot;
+    }
+
+    void InputSystem::collect() {
+
+        SDL_PumpEvents();
+
+        const auto frequency = SDL_GetPerformanceFrequency();
+        SDL_Event batch[DrainBatchSize];
+
+        while (true) {
+
+            const auto count = SDL_PeepEvents(batch, DrainBatchSize, SDL_GETEVENT, SDL_FIRSTEVENT, SDL_LASTEVENT);
+            if (count <= 0) {
+                break;
+            }
+
+            // Events may have sat in SDL's queue for a while before being drained, so each is
+            // backdated from the time of draining by the age that its (millisecond-resolution) SDL
+            // timestamp indicates.
+
+            const auto now = SDL_GetPerformanceCounter();
+            const auto ticks = SDL_GetTicks();
+
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+
+                for (auto i = 0; i < count; ++i) {
+
+                    const Uint32 ageMilliseconds = ticks - batch[i].common.timestamp;
+                    const auto age = std::min<Uint64>(ageMilliseconds * frequency / 1000, now - 1);
+
+                    m_state.apply(batch[i], now - age);
+                }
+            }
+
+            m_events.insert(m_events.end(), batch, batch + count);
+
+            if (count < DrainBatchSize) {
+                break;
+            }
+        }
+    }
+
+    bool InputSystem::drain(const EventHandler& handler) {
+
+        collect();
+
+        // The events are moved out of m_events before being handled, since a handler may itself
+        // call latch() and so collect more.
+
+        std::vector<SDL_Event> events;
+        events.swap(m_events);
+
+        auto quit = false;
+        for (const auto& event : events) {
+
+            if (event.type == SDL_QUIT) {
+                quit = true;
+            }
+
+            if (handler) {
+                handler(event);
+            }
+        }
+
+        return !quit;
+    }
+
+    InputState InputSystem::latch() {
+
+        if (std::this_thread::get_id() == m_eventThread) {
+            collect();
+        }
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_state;
+    }
+
+    InputLatencyStats InputSystem::latency() const {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_latency;
+    }
+
+    void InputSystem::presented(const InputState& latched) {
+
+        const auto now = SDL_GetPerformanceCounter();
+        const auto newest = latched.newestEventTime();
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        if (newest == 0 || newest <= m_lastPresentedEventTime) {
+            return;
+        }
+
+        // Input that was already reflected in an earlier presented frame has been counted, so the
+        // latency is measured from the oldest input that has not.
+
+        auto oldest = latched.oldestFrameEventTime();
+        if (oldest <= m_lastPresentedEventTime) {
+            oldest = newest;
+        }
+
+        const auto latency = toSeconds(now - oldest);
+
+        m_latency.last = latency;
+        m_latency.maximum = std::max(m_latency.maximum, latency);
+        m_latency.average = m_latency.samples == 0
+            ? latency
+            : m_latency.average + LatencySmoothing * (latency - m_latency.average);
+
+        ++m_latency.samples;
+        m_lastPresentedEventTime = newest;
+    }
+
+    double InputSystem::toSeconds(const Uint64 ticks) {
+        return static_cast<double>(ticks) / static_cast<double>(SDL_GetPerformanceFrequency());
+    }
+}
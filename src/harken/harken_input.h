@@ -0,0 +1,218 @@
+#ifndef HARKEN_INPUT_H
+#define HARKEN_INPUT_H
+
+#include "harken_global.h"
+#include "harken_vector.h"
+
+#include <SDL.h>
+
+#include <bitset>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * The state of the keyboard and mouse as of some instant, together with the transitions
+     * (presses and releases) and relative motion that have accumulated since the start of the
+     * current frame. InputState is a plain value type: it is built up by applying events to it in
+     * order, and copies of it serve as immutable per-frame snapshots.
+     *
+     * Times are measured in ticks of SDL's high-resolution performance counter (see
+     * <tt>SDL_GetPerformanceCounter()</tt>), rather than in the milliseconds of SDL's own event
+     * timestamps, so that they may be compared precisely with the times at which frames are
+     * rendered and presented.
+     */
+
+    class InputState {
+    public:
+
+        static constexpr int MouseButtonCount = 8;
+
+        /**
+         * Updates the state according to @p event, which was received at @p timestamp. Events
+         * that do not concern the keyboard or mouse are ignored.
+         */
+
+        void apply(const SDL_Event& event, Uint64 timestamp);
+
+        /**
+         * Clears the transitions and relative motion accumulated so far, leaving what is held down
+         * and the position of the mouse as they are.
+         */
+
+        void beginFrame();
+
+        /**
+         * Gets the number of keyboard and mouse events applied since beginFrame() was last called.
+         */
+
+        std::size_t eventCount() const;
+
+        bool keyDown(SDL_Scancode scancode) const;      ///< Determines whether a key is held down.
+        bool keyPressed(SDL_Scancode scancode) const;   ///< Determines whether a key went down during the frame.
+        bool keyReleased(SDL_Scancode scancode) const;  ///< Determines whether a key went up during the frame.
+
+        /**
+         * Determines whether the mouse button numbered @p button (counting from 1, as SDL does) is
+         * held down. Buttons outside the range SDL reports are never down.
+         */
+
+        bool mouseButtonDown(int button) const;
+        bool mouseButtonPressed(int button) const;   ///< @see mouseButtonDown()
+        bool mouseButtonReleased(int button) const;  ///< @see mouseButtonDown()
+
+        Vector2<int> mouseMotion() const;    ///< Gets the relative motion of the mouse during the frame.
+        Vector2<int> mousePosition() const;  ///< Gets the position of the mouse within the window.
+        Vector2<int> wheelMotion() const;    ///< Gets the scrolling of the mouse wheel during the frame.
+
+        /**
+         * Gets the time at which the newest event was applied, or @c 0 if none has been.
+         */
+
+        Uint64 newestEventTime() const;
+
+        /**
+         * Gets the time at which the oldest event applied since beginFrame() was received, or
+         * @c 0 if there have been none. This is the event whose effects have waited longest to be
+         * shown, and therefore the one that determines the frame's input latency.
+         */
+
+        Uint64 oldestFrameEventTime() const;
+
+    private:
+
+        std::bitset<SDL_NUM_SCANCODES> m_keysDown;
+        std::bitset<SDL_NUM_SCANCODES> m_keysPressed;
+        std::bitset<SDL_NUM_SCANCODES> m_keysReleased;
+
+        std::bitset<MouseButtonCount> m_buttonsDown;
+        std::bitset<MouseButtonCount> m_buttonsPressed;
+        std::bitset<MouseButtonCount> m_buttonsReleased;
+
+        Vector2<int> m_mousePosition{0, 0};
+        Vector2<int> m_mouseMotion{0, 0};
+        Vector2<int> m_wheelMotion{0, 0};
+
+        std::size_t m_eventCount = 0;
+        Uint64 m_newestEventTime = 0;
+        Uint64 m_oldestFrameEventTime = 0;
+    };
+
+    /**
+     * Running statistics of the time between input arriving and a frame that reflects it being
+     * presented, in seconds.
+     */
+
+    struct InputLatencyStats {
+
+        double last = 0.0;
+        double average = 0.0;  ///< An exponential moving average over recent frames.
+        double maximum = 0.0;
+        std::size_t samples = 0;
+    };
+
+    /**
+     * Collects keyboard and mouse input from SDL's event queue. Events are drained in bulk with
+     * <tt>SDL_PeepEvents()</tt> rather than one at a time, each batch being timestamped with the
+     * high-resolution performance counter as it is drained, and are folded into an InputState.
+     *
+     * Consumers see that state in one of two ways. beginFrame() takes the snapshot that a frame's
+     * simulation should be based on, and starts accumulating the transitions for the next frame.
+     * latch() instead gets the newest state available at the moment it is called, and is intended
+     * to be called by the renderer at the last moment before submitting draws that depend on input
+     * (such as the camera orientation), so that those draws reflect input that arrived after the
+     * frame was simulated. Calling presented() after swapping buffers then records how old the
+     * input reflected in the frame was.
+     *
+     * Draining must happen on the thread that initialised SDL, but snapshots may be taken from any
+     * thread, so the renderer may run elsewhere.
+     */
+
+    class InputSystem {
+    public:
+
+        /**
+         * Called with each event drained, on the draining thread.
+         */
+
+        using EventHandler = std::function<void(const SDL_Event&)>;
+
+        /**
+         * Prepares to collect input. Must be constructed on the thread that initialised SDL.
+         */
+
+        InputSystem();
+
+        InputSystem(const InputSystem&) = delete;
+        InputSystem& operator=(const InputSystem&) = delete;
+
+        /**
+         * Returns the input accumulated since the previous call as a snapshot for the coming frame,
+         * and starts accumulating afresh. May be called from any thread.
+         */
+
+        InputState beginFrame();
+
+        /**
+         * Drains every pending event from the SDL event queue, applying each to the current input
+         * state and passing it to @p handler (if it is provided). Returns @c false if an
+         * @c SDL_QUIT event was drained. Must be called from the thread that initialised SDL.
+         */
+
+        bool drain(const EventHandler& handler = nullptr);
+
+        /**
+         * Gets the newest input state, without starting a new frame. If called from the thread
+         * that initialised SDL, any pending events are drained first; they are applied to the
+         * input state immediately, but are only passed to a handler (or checked for
+         * @c SDL_QUIT) by the next call to drain(). Otherwise, the state is as of the last drain.
+         */
+
+        InputState latch();
+
+        /**
+         * Gets the latency statistics recorded by presented().
+         */
+
+        InputLatencyStats latency() const;
+
+        /**
+         * Records that a frame built from @p latched (as returned by latch() or beginFrame()) has
+         * just been presented. If any input had arrived during that frame, the time since the
+         * oldest such input was received is added to the latency statistics.
+         */
+
+        void presented(const InputState& latched);
+
+        /**
+         * Converts a difference between two performance counter readings into seconds.
+         */
+
+        static double toSeconds(Uint64 ticks);
+
+    private:
+
+        /**
+         * Moves every pending event from the SDL event queue to the end of m_events and applies
+         * them to the input state.
+         */
+
+        void collect();
+
+        const std::thread::id m_eventThread;
+        std::vector<SDL_Event> m_events;  ///< Events collected but not yet passed to a handler.
+
+        // Guards everything below, which may be accessed from threads other than the event thread.
+
+        mutable std::mutex m_mutex;
+        InputState m_state;
+        InputLatencyStats m_latency;
+        Uint64 m_lastPresentedEventTime = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,34 @@
+#include "harken_instancebuffer.h"
+
+#include <utility>
+
+namespace Harken {
+
+    InstanceBuffer::InstanceBuffer(VertexFormat format)
+        : m_format{std::move(format)} {
+    }
+
+    void InstanceBuffer::attach(VertexArrayObject& vertexArray, const GLuint firstLocation) {
+        vertexArray.setFormat(m_buffer, m_format, firstLocation, 1);
+    }
+
+    void InstanceBuffer::drawArrays(const GLenum mode, const GLint first, const GLsizei count) const {
+        glDrawArraysInstanced(mode, first, count, m_instanceCount);
+    }
+
+    void InstanceBuffer::drawElements(const ElementBufferObject& elements, const GLenum mode) const {
+        elements.drawInstanced(m_instanceCount, mode);
+    }
+
+    const VertexFormat& InstanceBuffer::format() const {
+        return m_format;
+    }
+
+    GLsizei InstanceBuffer::instanceCount() const {
+        return m_instanceCount;
+    }
+
+    void InstanceBuffer::setTransforms(const std::vector<Matrix4f>& transforms, const GLenum usage) {
+        setInstances(transforms, usage);
+    }
+}
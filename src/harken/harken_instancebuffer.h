@@ -0,0 +1,122 @@
+#ifndef HARKEN_INSTANCEBUFFER_H
+#define HARKEN_INSTANCEBUFFER_H
+
+#include "harken_global.h"
+#include "harken_glmath.h"
+#include "harken_vertexarrayobject.h"
+#include "harken_vertexbufferobject.h"
+#include "harken_vertexlayout.h"
+
+#include <GL/glew.h>
+
+#include <cassert>
+#include <vector>
+
+namespace Harken {
+
+    static_assert(sizeof(Matrix4f) == 16 * sizeof(GLfloat),
+                  "Matrix4f must be tightly packed to be uploaded as instance data.");
+
+    /**
+     * Vertex layout of per-instance data beginning with a Matrix4f transformation. The matrix is
+     * supplied to OpenGL as its four columns, which occupy four consecutive attribute locations
+     * (as a @c mat4 vertex shader input does); @p ExtraAttributes, if any, follow the matrix.
+     */
+
+    template<typename... ExtraAttributes>
+    using InstanceLayout = VertexLayout<VertexAttribute<Vector4f>,
+                                        VertexAttribute<Vector4f>,
+                                        VertexAttribute<Vector4f>,
+                                        VertexAttribute<Vector4f>,
+                                        ExtraAttributes...>;
+
+    /**
+     * Holds per-instance data for instanced rendering in a vertex buffer, and issues instanced
+     * draw calls that render every instance in the buffer at once. Rather than issuing one draw
+     * call per copy of a mesh with a uniform update between each, the transformations of all
+     * copies are uploaded together and the mesh is drawn with a single
+     * <tt>glDrawArraysInstanced()</tt> or <tt>glDrawElementsInstanced()</tt> call.
+     *
+     * The buffer's instance data are wired into a VertexArrayObject by attach(), after which any
+     * draw through that vertex array object reads one element of instance data per instance.
+     */
+
+    class InstanceBuffer {
+    public:
+
+        /**
+         * Creates an empty instance buffer whose instances are laid out according to @p format.
+         * The default format holds nothing but a single Matrix4f transformation per instance.
+         */
+
+        explicit InstanceBuffer(VertexFormat format = InstanceLayout<>::format());
+
+        /**
+         * Configures @p vertexArray to read the attributes of this buffer's format from
+         * consecutive locations starting at @p firstLocation, advancing once per instance. A
+         * Matrix4f occupies the first four of these locations.
+         */
+
+        void attach(VertexArrayObject& vertexArray, GLuint firstLocation);
+
+        /**
+         * Draws @p count vertices starting from @p first, once for every instance currently held
+         * by the buffer. See <tt>glDrawArraysInstanced()</tt>.
+         */
+
+        void drawArrays(GLenum mode, GLint first, GLsizei count) const;
+
+        /**
+         * Draws the indexed mesh described by @p elements once for every instance currently held
+         * by the buffer. See ElementBufferObject::drawInstanced().
+         */
+
+        void drawElements(const ElementBufferObject& elements, GLenum mode = GL_TRIANGLES) const;
+
+        /**
+         * Gets the format of each instance held by the buffer.
+         */
+
+        const VertexFormat& format() const;
+
+        /**
+         * Gets the number of instances that were last uploaded to the buffer.
+         */
+
+        GLsizei instanceCount() const;
+
+        /**
+         * Replaces the contents of the buffer with @p instances. @c Instance must be a standard
+         * layout type whose size matches the stride of the buffer's format; typically it is a
+         * structure beginning with a Matrix4f followed by members matching the extra attributes
+         * of an InstanceLayout.
+         * @param usage A hint to OpenGL of how often the instances will be updated. Instance data
+         *              are typically rewritten every frame, hence the default.
+         */
+
+        template<typename Instance>
+        void setInstances(const std::vector<Instance>& instances, const GLenum usage = GL_STREAM_DRAW) {
+
+            assert(sizeof(Instance) == static_cast<std::size_t>(m_format.stride())
+                   && "Instance type does not match the format of the instance buffer.");
+
+            m_instanceCount = static_cast<GLsizei>(instances.size());
+            m_buffer.setData(instances, usage);
+        }
+
+        /**
+         * Replaces the contents of the buffer with one instance per element of @p transforms. The
+         * buffer's format must contain no extra attributes.
+         */
+
+        void setTransforms(const std::vector<Matrix4f>& transforms, GLenum usage = GL_STREAM_DRAW);
+
+    private:
+
+        VertexBufferObject m_buffer{GL_ARRAY_BUFFER};
+        VertexFormat m_format;
+        GLsizei m_instanceCount = 0;
+    };
+}
+
+#endif
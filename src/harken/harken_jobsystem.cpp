@@ -0,0 +1,250 @@
+#include "harken_jobsystem.h"
+
+#include <cassert>
+#include <cstdint>
+
+namespace Harken {
+
+    namespace {
+
+        // Each thread may be a worker of at most one JobSystem at a time; these record which, and
+        // with what index.
+
+        thread_local const JobSystem * t_jobSystem = nullptr;
+        thread_local int t_workerIndex = -1;
+
+        // Number of times an idle worker looks for work (yielding in between) before going to
+        // sleep. Spinning briefly avoids the cost of a sleep and wake-up when jobs arrive in
+        // quick succession, as they do during a parallel for.
+
+        constexpr int IdleSpinCount = 64;
+
+        /**
+         * Gets a pseudo-random number for choosing a victim to steal from. Quality is
+         * unimportant; it need only differ between threads and be cheap.
+         */
+
+        std::uint32_t nextRandom() {
+
+            thread_local std::uint32_t state = static_cast<std::uint32_t>(
+                reinterpret_cast<std::uintptr_t>(&state) >> 4) | 1;
+
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+    }
+
+    void JobCounter::fail(std::exception_ptr error) {
+
+        std::lock_guard<std::mutex> lock{m_errorMutex};
+        if (!m_error) {
+            m_error = std::move(error);
+        }
+    }
+
+    void JobCounter::rethrowError() {
+
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock{m_errorMutex};
+            std::swap(error, m_error);
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    JobSystem::JobSystem(const unsigned workerThreadCount, const JobSystemCaller caller)
+        : m_callerIsWorker{caller == JobSystemCaller::Worker} {
+
+        const auto threadCount = workerThreadCount + 1;
+        for (auto i = 0u; i < threadCount; ++i) {
+            m_deques.push_back(std::make_unique<WorkStealingDeque<Job *>>());
+        }
+
+        if (m_callerIsWorker) {
+            assert(!t_jobSystem);
+            t_jobSystem = this;
+            t_workerIndex = 0;
+        }
+
+        for (auto i = 1u; i < threadCount; ++i) {
+            m_threads.emplace_back([this, i]() { workerLoop(static_cast<int>(i)); });
+        }
+    }
+
+    JobSystem::~JobSystem() {
+
+        {
+            std::lock_guard<std::mutex> lock{m_sleepMutex};
+            m_stopping = true;
+        }
+
+        m_wake.notify_all();
+
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+
+        Job * job = nullptr;
+        for (auto& deque : m_deques) {
+            while (deque->steal(job)) {
+                delete job;
+            }
+        }
+
+        for (const auto sharedJob : m_sharedJobs) {
+            delete sharedJob;
+        }
+
+        if (m_callerIsWorker) {
+            assert(t_jobSystem == this);
+            t_jobSystem = nullptr;
+            t_workerIndex = -1;
+        }
+    }
+
+    int JobSystem::currentWorkerIndex() const {
+        return t_jobSystem == this ? t_workerIndex : -1;
+    }
+
+    unsigned JobSystem::defaultWorkerThreadCount() {
+        const auto hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    bool JobSystem::executeOne(const int workerIndex) {
+
+        const auto job = take(workerIndex);
+        if (!job) {
+            return false;
+        }
+
+        m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+
+        // The job is destroyed before its counter is released, since whoever is waiting on the
+        // counter may well destroy things that the job's function object refers to. A job that
+        // throws still releases its counter, or its waiter would never return.
+
+        const auto counter = job->counter;
+        try {
+            job->execute();
+        }
+        catch (...) {
+            counter->fail(std::current_exception());
+        }
+
+        delete job;
+
+        counter->m_pending.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    void JobSystem::submit(std::unique_ptr<Job> job) {
+
+        job->counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+
+        const auto workerIndex = currentWorkerIndex();
+        if (workerIndex >= 0) {
+            m_deques[workerIndex]->push(job.release());
+        }
+        else {
+            std::lock_guard<std::mutex> lock{m_sharedMutex};
+            m_sharedJobs.push_back(job.release());
+        }
+
+        // A worker may take the job before it is counted here, leaving the count briefly
+        // negative; that is harmless, since it is only compared against zero.
+
+        auto wake = false;
+        {
+            std::lock_guard<std::mutex> lock{m_sleepMutex};
+            m_queuedJobs.fetch_add(1, std::memory_order_relaxed);
+            wake = m_sleepingWorkers > 0;
+        }
+
+        if (wake) {
+            m_wake.notify_one();
+        }
+    }
+
+    Job * JobSystem::take(const int workerIndex) {
+
+        Job * job = nullptr;
+
+        if (workerIndex >= 0 && m_deques[workerIndex]->pop(job)) {
+            return job;
+        }
+
+        const auto dequeCount = m_deques.size();
+        const auto start = nextRandom() % dequeCount;
+
+        for (std::size_t i = 0; i < dequeCount; ++i) {
+
+            const auto victim = (start + i) % dequeCount;
+            if (static_cast<int>(victim) != workerIndex && m_deques[victim]->steal(job)) {
+                return job;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock{m_sharedMutex};
+        if (!m_sharedJobs.empty()) {
+            job = m_sharedJobs.front();
+            m_sharedJobs.pop_front();
+        }
+
+        return job;
+    }
+
+    unsigned JobSystem::threadCount() const {
+        return static_cast<unsigned>(m_deques.size());
+    }
+
+    void JobSystem::wait(JobCounter& counter) {
+
+        const auto workerIndex = currentWorkerIndex();
+
+        while (!counter.done()) {
+            if (!executeOne(workerIndex)) {
+                std::this_thread::yield();
+            }
+        }
+
+        counter.rethrowError();
+    }
+
+    void JobSystem::workerLoop(const int workerIndex) {
+
+        t_jobSystem = this;
+        t_workerIndex = workerIndex;
+
+        auto idleCount = 0;
+
+        while (!m_stopping.load(std::memory_order_acquire)) {
+
+            if (executeOne(workerIndex)) {
+                idleCount = 0;
+                continue;
+            }
+
+            if (++idleCount < IdleSpinCount) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock{m_sleepMutex};
+            ++m_sleepingWorkers;
+
+            m_wake.wait(lock, [this]() {
+                return m_stopping.load(std::memory_order_acquire)
+                    || m_queuedJobs.load(std::memory_order_relaxed) > 0;
+            });
+
+            --m_sleepingWorkers;
+            idleCount = 0;
+        }
+    }
+}
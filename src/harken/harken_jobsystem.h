@@ -0,0 +1,273 @@
+#ifndef HARKEN_JOBSYSTEM_H
+#define HARKEN_JOBSYSTEM_H
+
+#include "harken_global.h"
+#include "harken_workstealingdeque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * Tracks the completion of a group of jobs. Each job run against a counter increments it when
+     * submitted and decrements it when finished, so the jobs are all complete when the counter
+     * reaches zero. A counter may be waited upon with JobSystem::wait(), and expresses
+     * dependencies between jobs: a job that needs the results of others simply waits on their
+     * counter, executing other jobs in the meantime. If any of the jobs throws, the first exception
+     * is kept by the counter until it is rethrown by JobSystem::wait().
+     */
+
+    class JobCounter {
+    public:
+
+        JobCounter() = default;
+
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        /**
+         * Determines whether every job run against the counter has finished.
+         */
+
+        bool done() const {
+            return m_pending.load(std::memory_order_acquire) == 0;
+        }
+
+    private:
+
+        friend class JobSystem;
+
+        /**
+         * Records @p error as the reason the jobs failed, unless an earlier job already failed.
+         */
+
+        void fail(std::exception_ptr error);
+
+        /**
+         * Rethrows the first recorded exception, if any, and clears it so that the counter may
+         * be reused.
+         */
+
+        void rethrowError();
+
+        std::atomic<int> m_pending{0};
+        std::mutex m_errorMutex;
+        std::exception_ptr m_error;
+    };
+
+    /**
+     * Whether the thread that constructs a JobSystem becomes one of its workers.
+     */
+
+    enum class JobSystemCaller {
+
+        /**
+         * The constructing thread is treated like any other thread that is not a worker: the
+         * jobs it submits go through the shared queue.
+         */
+
+        External,
+
+        /**
+         * The constructing thread becomes the worker with index @c 0, so the jobs it submits go
+         * onto a deque of its own and can be taken without locking. A thread can be a worker of
+         * only one JobSystem at a time, and the JobSystem must be destroyed on the thread that
+         * constructed it.
+         */
+
+        Worker
+    };
+
+    /**
+     * A unit of work executed by a JobSystem.
+     */
+
+    class Job {
+    public:
+
+        virtual ~Job() = default;
+        virtual void execute() = 0;
+
+        JobCounter * counter = nullptr;
+    };
+
+    /**
+     * A Job that calls a function object.
+     */
+
+    template<typename Function>
+    class FunctionJob : public Job {
+    public:
+
+        explicit FunctionJob(Function function)
+            : m_function(std::move(function)) {
+        }
+
+        void execute() override {
+            m_function();
+        }
+
+    private:
+
+        Function m_function;
+    };
+
+    /**
+     * A work-stealing job scheduler. Each worker thread owns a WorkStealingDeque onto which the
+     * jobs it spawns are pushed; it executes jobs from its own deque most recently spawned first
+     * (which keeps the data they touch warm in its cache), and when that runs dry it steals the
+     * oldest jobs from the deques of randomly chosen workers. Spawning and executing a job is
+     * therefore a handful of uncontended atomic operations plus one allocation in the common
+     * case.
+     *
+     * The thread that constructs the JobSystem may opt to become a worker too (with the index
+     * @c 0), though it only executes jobs while it is inside wait() or parallelFor(). Jobs may also
+     * be submitted from threads that are not workers at all, in which case they are placed in a
+     * shared, locked queue from which workers take them once their own deques are empty; such
+     * threads also execute jobs while they wait.
+     */
+
+    class JobSystem {
+    public:
+
+        /**
+         * Starts @p workerThreadCount worker threads. By default, one worker is started for every
+         * hardware thread other than the calling one. @p caller determines whether the calling
+         * thread becomes a worker as well.
+         */
+
+        explicit JobSystem(unsigned workerThreadCount = defaultWorkerThreadCount(),
+                           JobSystemCaller caller = JobSystemCaller::External);
+
+        /**
+         * Waits for every worker thread to finish its current job and stop. Jobs that have not
+         * started by then are discarded, so callers should wait on their counters beforehand.
+         */
+
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /**
+         * Gets the number of hardware threads less one (or one, if that cannot be determined).
+         */
+
+        static unsigned defaultWorkerThreadCount();
+
+        /**
+         * Executes @p function for every index in [@p begin, @p end), spread across all workers,
+         * and returns once every call has finished. The range is divided into jobs of at most
+         * @p grainSize indices each; the grain should be large enough that each job does
+         * appreciably more work than the cost of spawning it. If any call throws, the first
+         * exception is rethrown once every job has finished.
+         */
+
+        template<typename Function>
+        void parallelFor(const std::size_t begin, const std::size_t end,
+                         const std::size_t grainSize, const Function& function) {
+
+            JobCounter counter;
+            const auto grain = std::max<std::size_t>(grainSize, 1);
+
+            for (auto first = begin; first < end; first += grain) {
+
+                const auto last = std::min(first + grain, end);
+                run([&function, first, last]() {
+                    for (auto i = first; i < last; ++i) {
+                        function(i);
+                    }
+                }, counter);
+            }
+
+            wait(counter);
+        }
+
+        /**
+         * Schedules @p function to be executed by some worker, incrementing @p counter until it
+         * finishes. @p counter must outlive the job.
+         */
+
+        template<typename Function>
+        void run(Function function, JobCounter& counter) {
+
+            auto job = std::make_unique<FunctionJob<Function>>(std::move(function));
+            job->counter = &counter;
+
+            submit(std::move(job));
+        }
+
+        /**
+         * Gets the total number of threads that execute jobs: the worker threads plus one for the
+         * thread waiting on them.
+         */
+
+        unsigned threadCount() const;
+
+        /**
+         * Blocks until every job run against @p counter has finished. If the calling thread is a
+         * worker, it executes other jobs while waiting rather than sitting idle; this is what
+         * allows jobs to wait on jobs of their own without deadlocking. If any of the jobs threw,
+         * the first exception is rethrown once they have all finished.
+         */
+
+        void wait(JobCounter& counter);
+
+    private:
+
+        /**
+         * Pushes @p job onto the calling worker's deque, or onto the shared queue if the calling
+         * thread is not a worker, and wakes a sleeping worker if there is one.
+         */
+
+        void submit(std::unique_ptr<Job> job);
+
+        /**
+         * Finds a job (from the calling worker's own deque, another worker's deque or the shared
+         * queue, in that order), executes it and marks it as finished. Returns @c false if no job
+         * could be found. @p workerIndex is @c -1 if the calling thread is not a worker.
+         */
+
+        bool executeOne(int workerIndex);
+
+        /**
+         * Gets the index of the calling thread among this system's workers, or @c -1 if it is not
+         * one of them.
+         */
+
+        int currentWorkerIndex() const;
+
+        Job * take(int workerIndex);
+
+        void workerLoop(int workerIndex);
+
+        std::vector<std::unique_ptr<WorkStealingDeque<Job *>>> m_deques;
+        std::vector<std::thread> m_threads;
+
+        std::mutex m_sharedMutex;
+        std::deque<Job *> m_sharedJobs;
+
+        // Jobs are counted into m_queuedJobs, and workers go to sleep, only with m_sleepMutex
+        // held, so that a worker cannot miss a job submitted between its last look for work and
+        // going to sleep.
+
+        std::mutex m_sleepMutex;
+        std::condition_variable m_wake;
+        std::atomic<int> m_queuedJobs{0};
+        int m_sleepingWorkers = 0;
+        std::atomic<bool> m_stopping{false};
+        bool m_callerIsWorker;
+    };
+}
+
+#endif
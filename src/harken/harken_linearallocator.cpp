@@ -0,0 +1,68 @@
+#include "harken_linearallocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+namespace Harken {
+
+    constexpr std::size_t LinearAllocator::DefaultChunkSize;
+
+    LinearAllocator::LinearAllocator(const std::size_t chunkSize)
+        : m_chunkSize{chunkSize} {
+    }
+
+    void * LinearAllocator::allocate(const std::size_t size, const std::size_t alignment) {
+
+        assert(alignment > 0 && (alignment & (alignment - 1)) == 0 && "Alignment must be a power of two.");
+        assert(alignment <= alignof(std::max_align_t) && "Alignment exceeds that of the allocator's chunks.");
+
+        while (m_currentChunk < m_chunks.size()) {
+
+            const auto& chunk = m_chunks[m_currentChunk];
+            const auto alignedOffset = (m_offset + alignment - 1) & ~(alignment - 1);
+
+            if (alignedOffset + size <= chunk.size) {
+
+                m_bytesAllocated += alignedOffset + size - m_offset;
+                m_offset = alignedOffset + size;
+                return chunk.data.get() + alignedOffset;
+            }
+
+            // Whatever is left of this chunk is wasted until the next reset(); chunks are large
+            // relative to typical allocations, so this is normally only a few bytes.
+
+            ++m_currentChunk;
+            m_offset = 0;
+        }
+
+        const auto chunkSize = std::max(m_chunkSize, size);
+        m_chunks.push_back(Chunk{std::unique_ptr<unsigned char[]>{new unsigned char[chunkSize]}, chunkSize});
+
+        m_currentChunk = m_chunks.size() - 1;
+        m_offset = size;
+        m_bytesAllocated += size;
+
+        return m_chunks.back().data.get();
+    }
+
+    std::size_t LinearAllocator::bytesAllocated() const {
+        return m_bytesAllocated;
+    }
+
+    std::size_t LinearAllocator::capacity() const {
+
+        auto result = std::size_t{0};
+        for (const auto& chunk : m_chunks) {
+            result += chunk.size;
+        }
+
+        return result;
+    }
+
+    void LinearAllocator::reset() {
+        m_currentChunk = 0;
+        m_offset = 0;
+        m_bytesAllocated = 0;
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef HARKEN_LINEARALLOCATOR_H
+#define HARKEN_LINEARALLOCATOR_H
+
+#include "harken_global.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * A bump allocator that hands out memory from a list of large chunks and frees it all at once.
+     * Allocation is a pointer increment in the common case, and reset() makes all of the memory
+     * available again without returning any chunks to the system, so that an allocator reused
+     * every frame soon stops allocating altogether.
+     *
+     * LinearAllocator is not thread-safe; it is intended to be owned by a single thread (such as
+     * a worker recording a CommandList) so that no synchronisation is needed at all. Objects
+     * created in its memory are never destroyed, so only trivially destructible types should be
+     * constructed there.
+     */
+
+    class LinearAllocator {
+    public:
+
+        static constexpr std::size_t DefaultChunkSize = 64 * 1024;
+
+        explicit LinearAllocator(std::size_t chunkSize = DefaultChunkSize);
+
+        LinearAllocator(const LinearAllocator&) = delete;
+        LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+        LinearAllocator(LinearAllocator&&) = default;
+        LinearAllocator& operator=(LinearAllocator&&) = default;
+
+        /**
+         * Allocates @p size bytes aligned to @p alignment, which must be a power of two no greater
+         * than <tt>alignof(std::max_align_t)</tt>. Requests larger than the chunk size are given a
+         * chunk of their own. The memory remains valid until reset() is called or the allocator
+         * is destroyed.
+         */
+
+        void * allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * Allocates memory for an object of type @c T and constructs it from @p args.
+         */
+
+        template<typename T, typename... Args>
+        T * create(Args&&... args) {
+
+            static_assert(std::is_trivially_destructible<T>::value,
+                          "Only trivially destructible types may be created by a LinearAllocator.");
+
+            return new (allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+        }
+
+        /**
+         * Gets the number of bytes handed out since the allocator was created or last reset,
+         * including any padding inserted for alignment.
+         */
+
+        std::size_t bytesAllocated() const;
+
+        /**
+         * Gets the total size of the chunks owned by the allocator.
+         */
+
+        std::size_t capacity() const;
+
+        /**
+         * Makes all of the allocator's memory available for reuse. Any memory previously returned
+         * by allocate() must no longer be used.
+         */
+
+        void reset();
+
+    private:
+
+        struct Chunk {
+            std::unique_ptr<unsigned char[]> data;
+            std::size_t size;
+        };
+
+        std::vector<Chunk> m_chunks;
+        std::size_t m_chunkSize;
+        std::size_t m_currentChunk = 0;
+        std::size_t m_offset = 0;
+        std::size_t m_bytesAllocated = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,214 @@
+#include "harken_lz4.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace Harken {
+
+    namespace {
+
+        // Limits imposed by the block format, so that decoders may copy in wide chunks near the
+        // end of a block without overrunning it: the last five bytes are always literals, and the
+        // last match starts at least twelve bytes before the end.
+
+        constexpr std::size_t minMatch = 4;
+        constexpr std::size_t lastLiterals = 5;
+        constexpr std::size_t matchLimit = 12;
+        constexpr std::size_t maxOffset = 65535;
+
+        constexpr unsigned hashBits = 12;
+
+        std::uint32_t read32(const unsigned char * const bytes) {
+            std::uint32_t value;
+            std::memcpy(&value, bytes, sizeof(value));
+            return value;
+        }
+
+        std::uint32_t hash(const std::uint32_t sequence) {
+            return (sequence * 2654435761u) >> (32 - hashBits);
+        }
+
+        /**
+         * Appends the part of a length that does not fit in its token's nibble, as a run of 255s
+         * followed by the remainder.
+         */
+
+        void writeLength(std::vector<char>& output, std::size_t length) {
+
+            for (; length >= 255; length -= 255) {
+                output.push_back(static_cast<char>(255));
+            }
+
+            output.push_back(static_cast<char>(length));
+        }
+
+        /**
+         * Reads the part of a length beyond its token's nibble (which was 15), adding it to
+         * @p length and returning whether the block held it all.
+         */
+
+        bool readLength(const unsigned char *& input, const unsigned char * const end, std::size_t& length) {
+
+            unsigned char byte;
+            do {
+                if (input == end) {
+                    return false;
+                }
+
+                byte = *input++;
+                length += byte;
+            }
+            while (byte == 255);
+
+            return true;
+        }
+
+        /**
+         * Appends a sequence of the @p literalLength literals starting at @p literals, followed
+         * by a match of @p matchLength bytes at @p offset (or by nothing, for the last sequence of
+         * a block, whose @p matchLength is zero).
+         */
+
+        void writeSequence(std::vector<char>& output,
+                           const unsigned char * const literals,
+                           const std::size_t literalLength,
+                           const std::size_t offset,
+                           const std::size_t matchLength) {
+
+            const auto tokenPosition = output.size();
+            output.push_back(0);
+
+            auto token = static_cast<unsigned char>(literalLength < 15 ? literalLength : 15) << 4;
+            if (literalLength >= 15) {
+                writeLength(output, literalLength - 15);
+            }
+
+            output.insert(output.end(), literals, literals + literalLength);
+
+            if (matchLength > 0) {
+
+                output.push_back(static_cast<char>(offset & 0xff));
+                output.push_back(static_cast<char>(offset >> 8));
+
+                const auto extraLength = matchLength - minMatch;
+                token |= static_cast<unsigned char>(extraLength < 15 ? extraLength : 15);
+                if (extraLength >= 15) {
+                    writeLength(output, extraLength - 15);
+                }
+            }
+
+            output[tokenPosition] = static_cast<char>(token);
+        }
+    }
+
+    std::vector<char> lz4Compress(const void * const data, const std::size_t size) {
+
+        const auto input = static_cast<const unsigned char *>(data);
+
+        std::vector<char> output;
+        output.reserve(size + size / 255 + 16);
+
+        // Positions are stored plus one, so that zero marks an empty slot.
+
+        std::vector<std::uint32_t> table(std::size_t{1} << hashBits, 0);
+
+        std::size_t anchor = 0;
+        std::size_t position = 0;
+
+        while (size >= matchLimit && position <= size - matchLimit) {
+
+            const auto sequence = read32(input + position);
+            auto& slot = table[hash(sequence)];
+            const auto candidate = static_cast<std::size_t>(slot);
+            slot = static_cast<std::uint32_t>(position + 1);
+
+            if (candidate == 0 || position - (candidate - 1) > maxOffset || read32(input + candidate - 1) != sequence) {
+                ++position;
+                continue;
+            }
+
+            const auto match = candidate - 1;
+
+            auto length = minMatch;
+            while (position + length < size - lastLiterals && input[match + length] == input[position + length]) {
+                ++length;
+            }
+
+            writeSequence(output, input + anchor, position - anchor, position - match, length);
+
+            position += length;
+            anchor = position;
+        }
+
+        writeSequence(output, input + anchor, size - anchor, 0, 0);
+        return output;
+    }
+
+    bool lz4Decompress(const void * const data, const std::size_t size, void * const output, const std::size_t outputSize) {
+
+        auto input = static_cast<const unsigned char *>(data);
+        const auto inputEnd = input + size;
+
+        const auto outputStart = static_cast<unsigned char *>(output);
+        const auto outputEnd = outputStart + outputSize;
+        auto out = outputStart;
+
+        while (input < inputEnd) {
+
+            const auto token = *input++;
+
+            std::size_t literalLength = token >> 4;
+            if (literalLength == 15 && !readLength(input, inputEnd, literalLength)) {
+                return false;
+            }
+
+            if (literalLength > static_cast<std::size_t>(inputEnd - input)
+                    || literalLength > static_cast<std::size_t>(outputEnd - out)) {
+                return false;
+            }
+
+            std::memcpy(out, input, literalLength);
+            input += literalLength;
+            out += literalLength;
+
+            // The last sequence of a block has literals only.
+
+            if (input == inputEnd) {
+                break;
+            }
+
+            if (inputEnd - input < 2) {
+                return false;
+            }
+
+            const auto offset = static_cast<std::size_t>(input[0]) | static_cast<std::size_t>(input[1]) << 8;
+            input += 2;
+
+            if (offset == 0 || offset > static_cast<std::size_t>(out - outputStart)) {
+                return false;
+            }
+
+            std::size_t matchLength = token & 15;
+            if (matchLength == 15 && !readLength(input, inputEnd, matchLength)) {
+                return false;
+            }
+
+            matchLength += minMatch;
+            if (matchLength > static_cast<std::size_t>(outputEnd - out)) {
+                return false;
+            }
+
+            // Matches may overlap the bytes they produce (an offset of one repeats a single byte),
+            // so are copied a byte at a time.
+
+            const auto match = out - offset;
+            for (std::size_t i = 0; i < matchLength; ++i) {
+                out[i] = match[i];
+            }
+
+            out += matchLength;
+        }
+
+        return out == outputEnd;
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef HARKEN_LZ4_H
+#define HARKEN_LZ4_H
+
+#include "harken_global.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * Compresses @p size bytes starting at @p data into an LZ4 block (the raw block format, with
+     * no frame around it), which may be decompressed by lz4Decompress() or by the reference
+     * implementation's @c LZ4_decompress_safe(). Compression is greedy and single-pass, favouring
+     * speed over ratio, which suits assets that are compressed once, offline, and decompressed
+     * many times. The size of the uncompressed data is not recorded, so must be kept alongside
+     * the block.
+     */
+
+    std::vector<char> lz4Compress(const void * data, std::size_t size);
+
+    /**
+     * Decompresses the LZ4 block of @p size bytes starting at @p data into the @p outputSize bytes
+     * starting at @p output, returning whether the block was valid and decompressed to exactly
+     * @p outputSize bytes. Every read and write is checked against the bounds of the buffers, so
+     * corrupted or malicious blocks are rejected rather than overrunning them.
+     */
+
+    bool lz4Decompress(const void * data, std::size_t size, void * output, std::size_t outputSize);
+}
+
+#endif
@@ -0,0 +1,267 @@
+#include "harken_meshoptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Harken {
+
+    namespace {
+
+        // Tuning constants for the Forsyth algorithm, taken from the original article. The cache
+        // modelled while scoring vertices is an LRU cache that is somewhat larger than the FIFO
+        // cache that the result is measured against; this is deliberate, and gives orderings
+        // that perform well across a range of real cache sizes.
+
+        constexpr int ScoringCacheSize = 32;
+        constexpr float CacheDecayPower = 1.5f;
+        constexpr float LastTriangleScore = 0.75f;
+        constexpr float ValenceBoostScale = 2.0f;
+        constexpr float ValenceBoostPower = 0.5f;
+
+        /**
+         * Scores a vertex by how desirable it is to emit a triangle that uses it, given its
+         * position in the modelled LRU cache (or @c -1 if it is not cached) and the number of
+         * triangles that use it but have not yet been emitted.
+         */
+
+        float vertexScore(const int cachePosition, const int remainingTriangles) {
+
+            if (remainingTriangles == 0) {
+                return -1.0f;
+            }
+
+            auto score = 0.0f;
+            if (cachePosition >= 0) {
+
+                // Vertices of the triangle that was just emitted are deliberately scored slightly
+                // lower than the most recent vertices beyond them, since the next triangle will
+                // have to leave out at least one of them anyway.
+
+                if (cachePosition < 3) {
+                    score = LastTriangleScore;
+                }
+                else {
+                    const auto scaler = 1.0f / (ScoringCacheSize - 3);
+                    score = std::pow(1.0f - (cachePosition - 3) * scaler, CacheDecayPower);
+                }
+            }
+
+            // Boost vertices with few remaining triangles so that lone triangles are not left
+            // behind to be picked up (with no cache reuse) at the very end.
+
+            score += ValenceBoostScale * std::pow(static_cast<float>(remainingTriangles), -ValenceBoostPower);
+            return score;
+        }
+    }
+
+    double averageCacheMissRatio(const std::vector<GLuint>& indices,
+                                 const std::size_t vertexCount,
+                                 const int cacheSize) {
+
+        assert(indices.size() % 3 == 0 && "Indices do not describe a triangle list.");
+
+        const auto triangleCount = indices.size() / 3;
+        if (triangleCount == 0) {
+            return 0.0;
+        }
+
+        // The timestamp at which each vertex entered the FIFO cache; a vertex is cached if it
+        // entered within the last cacheSize misses.
+
+        std::vector<std::size_t> entryTime(vertexCount, 0);
+        auto misses = std::size_t{0};
+
+        for (const auto index : indices) {
+
+            assert(index < vertexCount && "Index out of range of vertex data.");
+
+            if (entryTime[index] == 0 || misses + 1 - entryTime[index] > static_cast<std::size_t>(cacheSize)) {
+                ++misses;
+                entryTime[index] = misses;
+            }
+        }
+
+        return static_cast<double>(misses) / static_cast<double>(triangleCount);
+    }
+
+    void optimizeVertexCache(std::vector<GLuint>& indices, const std::size_t vertexCount) {
+
+        assert(indices.size() % 3 == 0 && "Indices do not describe a triangle list.");
+
+        const auto triangleCount = indices.size() / 3;
+        if (triangleCount == 0) {
+            return;
+        }
+
+        // Build the vertex-to-triangle adjacency in compressed form: the triangles using vertex v
+        // occupy adjacency[adjacencyOffset[v]] onwards, of which the first remaining[v] have not
+        // yet been emitted.
+
+        std::vector<int> remaining(vertexCount, 0);
+        for (const auto index : indices) {
+            assert(index < vertexCount && "Index out of range of vertex data.");
+            ++remaining[index];
+        }
+
+        std::vector<std::size_t> adjacencyOffset(vertexCount + 1, 0);
+        for (std::size_t v = 0; v < vertexCount; ++v) {
+            adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+        }
+
+        std::vector<std::size_t> adjacency(indices.size());
+        std::vector<std::size_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            adjacency[fill[indices[i]]++] = i / 3;
+        }
+
+        std::vector<int> cachePosition(vertexCount, -1);
+        std::vector<float> scores(vertexCount);
+        for (std::size_t v = 0; v < vertexCount; ++v) {
+            scores[v] = vertexScore(-1, remaining[v]);
+        }
+
+        std::vector<float> triangleScores(triangleCount);
+        std::vector<bool> emitted(triangleCount, false);
+
+        auto bestTriangle = std::size_t{0};
+        for (std::size_t t = 0; t < triangleCount; ++t) {
+
+            triangleScores[t] = scores[indices[3 * t]] + scores[indices[3 * t + 1]] + scores[indices[3 * t + 2]];
+            if (triangleScores[t] > triangleScores[bestTriangle]) {
+                bestTriangle = t;
+            }
+        }
+
+        std::vector<GLuint> result;
+        result.reserve(indices.size());
+
+        std::vector<GLuint> cache;
+        std::vector<GLuint> nextCache;
+        cache.reserve(ScoringCacheSize + 3);
+        nextCache.reserve(ScoringCacheSize + 3);
+
+        auto deadEndCursor = std::size_t{0};
+
+        while (result.size() < indices.size()) {
+
+            emitted[bestTriangle] = true;
+
+            const GLuint * const triangle = &indices[3 * bestTriangle];
+            result.insert(result.end(), triangle, triangle + 3);
+
+            // Remove the emitted triangle from the remaining adjacency of each of its vertices.
+
+            for (auto k = 0; k < 3; ++k) {
+
+                const auto v = triangle[k];
+                const auto begin = adjacency.begin() + adjacencyOffset[v];
+                const auto end = begin + remaining[v];
+
+                std::iter_swap(std::find(begin, end, bestTriangle), end - 1);
+                --remaining[v];
+            }
+
+            // Move the triangle's vertices to the front of the LRU cache, and push everything else
+            // back; the cache may temporarily overflow by up to three vertices.
+
+            nextCache.assign(triangle, triangle + 3);
+            for (const auto v : cache) {
+                if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                    nextCache.push_back(v);
+                }
+            }
+
+            for (std::size_t i = 0; i < nextCache.size(); ++i) {
+
+                const auto v = nextCache[i];
+                cachePosition[v] = i < static_cast<std::size_t>(ScoringCacheSize) ? static_cast<int>(i) : -1;
+                scores[v] = vertexScore(cachePosition[v], remaining[v]);
+            }
+
+            if (nextCache.size() > static_cast<std::size_t>(ScoringCacheSize)) {
+                nextCache.resize(ScoringCacheSize);
+            }
+
+            cache.swap(nextCache);
+
+            // Only triangles touching the cache can have changed score, so the next triangle is
+            // chosen from among those.
+
+            auto bestScore = -std::numeric_limits<float>::infinity();
+            auto found = false;
+
+            for (const auto v : cache) {
+
+                const auto begin = adjacency.begin() + adjacencyOffset[v];
+                const auto end = begin + remaining[v];
+
+                for (auto it = begin; it != end; ++it) {
+
+                    const auto t = *it;
+                    triangleScores[t] = scores[indices[3 * t]] + scores[indices[3 * t + 1]] + scores[indices[3 * t + 2]];
+
+                    if (triangleScores[t] > bestScore) {
+                        bestScore = triangleScores[t];
+                        bestTriangle = t;
+                        found = true;
+                    }
+                }
+            }
+
+            // If the cache has run dry, restart from the next unemitted triangle in the original
+            // order. This keeps the algorithm linear in the number of triangles.
+
+            if (!found && result.size() < indices.size()) {
+
+                while (emitted[deadEndCursor]) {
+                    ++deadEndCursor;
+                }
+
+                bestTriangle = deadEndCursor;
+            }
+        }
+
+        indices.swap(result);
+    }
+
+    std::vector<GLuint> optimizeVertexFetch(std::vector<GLuint>& indices, const std::size_t vertexCount) {
+
+        constexpr auto Unassigned = std::numeric_limits<GLuint>::max();
+
+        std::vector<GLuint> remap(vertexCount, Unassigned);
+        auto next = GLuint{0};
+
+        for (auto& index : indices) {
+
+            assert(index < vertexCount && "Index out of range of vertex data.");
+
+            if (remap[index] == Unassigned) {
+                remap[index] = next++;
+            }
+
+            index = remap[index];
+        }
+
+        for (auto& entry : remap) {
+            if (entry == Unassigned) {
+                entry = next++;
+            }
+        }
+
+        return remap;
+    }
+
+    MeshOptimizationReport optimizeMesh(std::vector<GLuint>& indices, const std::size_t vertexCount) {
+
+        MeshOptimizationReport report;
+        report.acmrBefore = averageCacheMissRatio(indices, vertexCount);
+
+        optimizeVertexCache(indices, vertexCount);
+        report.vertexRemap = optimizeVertexFetch(indices, vertexCount);
+
+        report.acmrAfter = averageCacheMissRatio(indices, vertexCount);
+        return report;
+    }
+}
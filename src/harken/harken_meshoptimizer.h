@@ -0,0 +1,94 @@
+#ifndef HARKEN_MESHOPTIMIZER_H
+#define HARKEN_MESHOPTIMIZER_H
+
+#include "harken_global.h"
+
+#include <GL/glew.h>
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * The number of entries assumed for the post-transform vertex cache when measuring the
+     * average cache miss ratio of a mesh. Sixteen entries is a conservative approximation of the
+     * FIFO caches found on most hardware.
+     */
+
+    constexpr int DefaultVertexCacheSize = 16;
+
+    /**
+     * Computes the average cache miss ratio (ACMR) of the triangle list described by @p indices:
+     * the average number of vertices that must be transformed per triangle when the mesh is drawn
+     * through a FIFO post-transform cache holding @p cacheSize vertices. The result ranges from
+     * <tt>3.0</tt> (no vertex reuse at all) down to approximately <tt>0.5</tt> for an ideally
+     * ordered regular grid. Returns <tt>0.0</tt> if @p indices is empty.
+     */
+
+    double averageCacheMissRatio(const std::vector<GLuint>& indices,
+                                 std::size_t vertexCount,
+                                 int cacheSize = DefaultVertexCacheSize);
+
+    /**
+     * Reorders the triangles of the triangle list described by @p indices so as to maximise the
+     * reuse of vertices from the post-transform vertex cache, using Tom Forsyth's "Linear-Speed
+     * Vertex Cache Optimisation" algorithm. Every triangle is preserved (including its winding),
+     * but triangles may be emitted in any order.
+     * @param indices     The indices of a triangle list, three per triangle. Every index must be
+     *                    less than @p vertexCount.
+     * @param vertexCount The number of vertices referenced by @p indices.
+     */
+
+    void optimizeVertexCache(std::vector<GLuint>& indices, std::size_t vertexCount);
+
+    /**
+     * Renumbers the vertices referenced by @p indices in the order in which they are first used,
+     * so that vertex fetches during drawing proceed through memory as linearly as possible.
+     * @p indices is rewritten in place to use the new numbering; vertices that are not referenced
+     * at all are moved to the end. Returns a table mapping each original vertex index onto its
+     * new index, which should be applied to the vertex data with remapVertices().
+     */
+
+    std::vector<GLuint> optimizeVertexFetch(std::vector<GLuint>& indices, std::size_t vertexCount);
+
+    /**
+     * Reorders @p vertices according to a @p remap table produced by optimizeVertexFetch(), such
+     * that the vertex previously at index @c i is moved to index <tt>remap[i]</tt>.
+     */
+
+    template<typename Vertex>
+    std::vector<Vertex> remapVertices(const std::vector<Vertex>& vertices, const std::vector<GLuint>& remap) {
+
+        assert(vertices.size() == remap.size() && "Vertex remap table does not match vertex data.");
+
+        std::vector<Vertex> result(vertices.size());
+        for (std::size_t i = 0; i < vertices.size(); ++i) {
+            result[remap[i]] = vertices[i];
+        }
+
+        return result;
+    }
+
+    /**
+     * Summarises the outcome of a call to optimizeMesh().
+     */
+
+    struct MeshOptimizationReport {
+        std::vector<GLuint> vertexRemap;  ///< The table to pass to remapVertices().
+        double acmrBefore;                ///< The ACMR of the mesh before optimisation.
+        double acmrAfter;                 ///< The ACMR of the mesh after optimisation.
+    };
+
+    /**
+     * Optimises the triangle list described by @p indices for both the post-transform vertex
+     * cache and vertex fetch locality, by applying optimizeVertexCache() and then
+     * optimizeVertexFetch(). The vertex data of the mesh must then be reordered by passing the
+     * returned MeshOptimizationReport::vertexRemap to remapVertices().
+     */
+
+    MeshOptimizationReport optimizeMesh(std::vector<GLuint>& indices, std::size_t vertexCount);
+}
+
+#endif
@@ -0,0 +1,613 @@
+#include "harken_mipgenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace Harken {
+
+    namespace {
+
+        /**
+         * The filter taps that produce each pixel along one axis of a level from a row (or
+         * column) of the level above: pixel @c i of the level is the sum of <tt>weights[j] *
+         * source[indices[j]]</tt> for @c j in [<tt>offsets[i]</tt>, <tt>offsets[i + 1]</tt>).
+         */
+
+        struct FilterTaps {
+            std::vector<std::size_t> offsets;
+            std::vector<int> indices;
+            std::vector<float> weights;
+        };
+
+        /**
+         * The radius of the Kaiser filter, in pixels of the level being produced.
+         */
+
+        const double kaiserRadius = 3.0;
+
+        const double pi = 3.14159265358979323846;
+
+        /**
+         * Evaluates the zeroth-order modified Bessel function of the first kind, which shapes the
+         * Kaiser window.
+         */
+
+        double bessel0(const double x) {
+
+            auto sum = 1.0;
+            auto term = 1.0;
+
+            for (auto k = 1; term > sum * 1e-12; ++k) {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum += term;
+            }
+
+            return sum;
+        }
+
+        /**
+         * Evaluates the Kaiser-windowed sinc at @p x, measured in pixels of the level being
+         * produced.
+         */
+
+        double kaiser(const double x) {
+
+            const auto alpha = 4.0;
+            const auto t = x / kaiserRadius;
+
+            if (t * t >= 1.0) {
+                return 0.0;
+            }
+
+            const auto sinc = x == 0.0 ? 1.0 : std::sin(pi * x) / (pi * x);
+            return sinc * bessel0(alpha * std::sqrt(1.0 - t * t)) / bessel0(alpha);
+        }
+
+        FilterTaps makeTaps(const int sourceSize, const int targetSize, const MipFilter filter) {
+
+            FilterTaps taps;
+            taps.offsets.push_back(0);
+
+            const auto scale = static_cast<double>(sourceSize) / targetSize;
+
+            for (auto target = 0; target < targetSize; ++target) {
+
+                const auto first = taps.indices.size();
+                auto total = 0.0;
+
+                const auto addTap = [&](const int index, const double weight) {
+
+                    // Taps beyond the edges are clamped to it, so merge into the edge pixel's tap.
+
+                    const auto clamped = std::min(std::max(index, 0), sourceSize - 1);
+
+                    if (taps.indices.size() > first && taps.indices.back() == clamped) {
+                        taps.weights.back() += static_cast<float>(weight);
+                    }
+                    else {
+                        taps.indices.push_back(clamped);
+                        taps.weights.push_back(static_cast<float>(weight));
+                    }
+
+                    total += weight;
+                };
+
+                const auto centre = (target + 0.5) * scale;
+
+                if (sourceSize == targetSize) {
+                    addTap(target, 1.0);
+                }
+                else if (filter == MipFilter::Box) {
+
+                    // Each source pixel is weighted by how much of it the target pixel covers, which
+                    // matters where an odd size is halved.
+
+                    const auto low = target * scale;
+                    const auto high = (target + 1) * scale;
+
+                    for (auto source = static_cast<int>(std::floor(low)); source < high; ++source) {
+
+                        const auto coverage = std::min(high, source + 1.0) - std::max(low, static_cast<double>(source));
+                        if (coverage > 0.0) {
+                            addTap(source, coverage);
+                        }
+                    }
+                }
+                else {
+
+                    const auto low = static_cast<int>(std::floor(centre - kaiserRadius * scale));
+                    const auto high = static_cast<int>(std::ceil(centre + kaiserRadius * scale));
+
+                    for (auto source = low; source <= high; ++source) {
+
+                        const auto weight = kaiser((source + 0.5 - centre) / scale);
+                        if (weight != 0.0) {
+                            addTap(source, weight);
+                        }
+                    }
+                }
+
+                for (auto i = first; i < taps.weights.size(); ++i) {
+                    taps.weights[i] = static_cast<float>(taps.weights[i] / total);
+                }
+
+                taps.offsets.push_back(taps.indices.size());
+            }
+
+            return taps;
+        }
+
+        /**
+         * Gets the linear value of each sRGB-encoded byte.
+         */
+
+        const std::array<float, 256>& srgbDecodeTable() {
+
+            static const auto table = []() {
+
+                std::array<float, 256> table;
+                for (auto i = 0; i < 256; ++i) {
+                    const auto value = i / 255.0;
+                    table[i] = static_cast<float>(value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4));
+                }
+
+                return table;
+            }();
+
+            return table;
+        }
+
+        /**
+         * Encodes linear values as sRGB bytes, rounding to the nearest in sRGB. Each byte but the
+         * last has a threshold, the linear value halfway (in sRGB) between it and the next, at or
+         * above which values encode to the next byte; a coarse table of the byte at the start of
+         * each of a range of linear values finds the byte at or just below the answer, sparing a
+         * power (or a binary search) per channel. The ranges are narrower than the gap between
+         * any two thresholds, so at most one step is needed, which is taken without a branch
+         * (branching on random images mispredicts half the time).
+         */
+
+        const std::size_t srgbStartCount = 4096;
+
+        class SrgbEncoder {
+        public:
+
+            static const SrgbEncoder& instance() {
+                static const SrgbEncoder encoder;
+                return encoder;
+            }
+
+            char encode(const float value) const {
+
+                const auto clamped = std::min(std::max(value, 0.0f), 1.0f);
+                const auto byte = m_starts[std::min(static_cast<std::size_t>(clamped * srgbStartCount), srgbStartCount - 1)];
+
+                return static_cast<char>(byte + (clamped >= m_thresholds[byte] ? 1 : 0));
+            }
+
+        private:
+
+            SrgbEncoder() {
+
+                for (auto i = 0; i < 255; ++i) {
+                    const auto value = (i + 0.5) / 255.0;
+                    m_thresholds[i] = static_cast<float>(value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4));
+                }
+
+                // No value reaches the last byte's threshold, which lets it be looked up like the others.
+
+                m_thresholds[255] = 2.0f;
+
+                for (std::size_t i = 0; i < srgbStartCount; ++i) {
+                    const auto start = static_cast<float>(i) / srgbStartCount;
+                    m_starts[i] = static_cast<std::uint8_t>(std::upper_bound(m_thresholds.begin(), m_thresholds.end() - 1, start) - m_thresholds.begin());
+                }
+            }
+
+            std::array<float, 256> m_thresholds;
+            std::array<std::uint8_t, srgbStartCount> m_starts;
+        };
+
+        char encodeLinear(const float value) {
+            return static_cast<char>(static_cast<int>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f));
+        }
+
+        /**
+         * Encodes the @p count linear values of @p values, pixels of @p channels channels, as
+         * bytes. The first @p srgbChannels channels of each pixel are sRGB-encoded, and the rest
+         * linearly.
+         */
+
+        void encodeRow(const float * const values, const std::size_t count, const std::size_t channels,
+                       const std::size_t srgbChannels, char * const bytes) {
+
+            std::size_t i = 0;
+
+#ifdef __SSE2__
+
+            // Linear rows are encoded sixteen values at a time, which rounds exactly as
+            // encodeLinear() does. sRGB encoding looks up tables, so gains nothing from SSE2.
+
+            if (srgbChannels == 0) {
+
+                const auto zero = _mm_setzero_ps();
+                const auto one = _mm_set1_ps(1.0f);
+                const auto scale = _mm_set1_ps(255.0f);
+                const auto half = _mm_set1_ps(0.5f);
+
+                const auto encode = [&](const float * const input) {
+                    const auto clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(input), zero), one);
+                    return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale), half));
+                };
+
+                for (; i + 16 <= count; i += 16) {
+
+                    const auto low = _mm_packs_epi32(encode(values + i), encode(values + i + 4));
+                    const auto high = _mm_packs_epi32(encode(values + i + 8), encode(values + i + 12));
+
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(bytes + i), _mm_packus_epi16(low, high));
+                }
+            }
+
+#endif
+
+            const auto& encoder = SrgbEncoder::instance();
+
+            for (auto channel = i % channels; i < count; ++i) {
+
+                bytes[i] = channel < srgbChannels ? encoder.encode(values[i]) : encodeLinear(values[i]);
+
+                if (++channel == channels) {
+                    channel = 0;
+                }
+            }
+        }
+
+        /**
+         * The tables through which each channel of the base level's bytes is decoded to linear
+         * values.
+         */
+
+        using DecodeTables = std::array<std::array<float, 256>, 4>;
+
+        /**
+         * Produces row @p row of the column-filtered level, @p rowLength values long, from the
+         * base level @p base, decoding its bytes with @p tables as they are read.
+         */
+
+        void filterColumns(const char * const base, const std::size_t rowLength, const std::size_t channels,
+                           const DecodeTables& tables, const FilterTaps& taps, const std::size_t row, float * const output) {
+
+            const auto first = taps.offsets[row];
+            const auto last = taps.offsets[row + 1];
+
+            std::size_t i = 0;
+
+#ifdef __SSE2__
+
+            // SSE2 has no gather, so each lane looks up its own table, and the four are then
+            // weighted and summed together. Lane k of the block at i holds channel
+            // (i + k) % channels, so the lanes' tables repeat every block, or every third block
+            // for three channels.
+
+            std::array<std::array<const float *, 4>, 3> phases;
+            for (std::size_t phase = 0; phase < phases.size(); ++phase) {
+                for (std::size_t lane = 0; lane < 4; ++lane) {
+                    phases[phase][lane] = tables[(phase * 4 + lane) % channels].data();
+                }
+            }
+
+            const std::size_t phaseCount = channels == 3 ? 3 : 1;
+            std::size_t phase = 0;
+
+            for (; i + 4 <= rowLength; i += 4) {
+
+                const auto& lanes = phases[phase];
+                auto sum = _mm_setzero_ps();
+
+                for (auto tap = first; tap < last; ++tap) {
+
+                    const auto input = reinterpret_cast<const unsigned char *>(base) + static_cast<std::size_t>(taps.indices[tap]) * rowLength + i;
+                    const auto decoded = _mm_setr_ps(lanes[0][input[0]], lanes[1][input[1]], lanes[2][input[2]], lanes[3][input[3]]);
+
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(taps.weights[tap]), decoded));
+                }
+
+                _mm_storeu_ps(output + i, sum);
+
+                if (++phase == phaseCount) {
+                    phase = 0;
+                }
+            }
+
+#endif
+
+            for (auto channel = i % channels; i < rowLength; ++i) {
+
+                auto sum = 0.0f;
+                for (auto tap = first; tap < last; ++tap) {
+                    const auto input = base + static_cast<std::size_t>(taps.indices[tap]) * rowLength;
+                    sum += taps.weights[tap] * tables[channel][static_cast<unsigned char>(input[i])];
+                }
+
+                output[i] = sum;
+
+                if (++channel == channels) {
+                    channel = 0;
+                }
+            }
+        }
+
+        /**
+         * Produces row @p row of the column-filtered level, @p rowLength values long, from the
+         * linear level @p source.
+         */
+
+        void filterColumns(const float * const source, const std::size_t rowLength, const FilterTaps& taps,
+                           const std::size_t row, float * const output) {
+
+            const auto first = taps.offsets[row];
+            const auto last = taps.offsets[row + 1];
+
+            std::size_t i = 0;
+
+#ifdef __SSE2__
+
+            // Eight values are summed at once, in two registers, to keep two additions in flight.
+
+            for (; i + 8 <= rowLength; i += 8) {
+
+                auto low = _mm_setzero_ps();
+                auto high = _mm_setzero_ps();
+
+                for (auto tap = first; tap < last; ++tap) {
+
+                    const auto input = source + static_cast<std::size_t>(taps.indices[tap]) * rowLength + i;
+                    const auto weight = _mm_set1_ps(taps.weights[tap]);
+
+                    low = _mm_add_ps(low, _mm_mul_ps(weight, _mm_loadu_ps(input)));
+                    high = _mm_add_ps(high, _mm_mul_ps(weight, _mm_loadu_ps(input + 4)));
+                }
+
+                _mm_storeu_ps(output + i, low);
+                _mm_storeu_ps(output + i + 4, high);
+            }
+
+#endif
+
+            for (; i < rowLength; ++i) {
+
+                auto sum = 0.0f;
+                for (auto tap = first; tap < last; ++tap) {
+                    sum += taps.weights[tap] * source[static_cast<std::size_t>(taps.indices[tap]) * rowLength + i];
+                }
+
+                output[i] = sum;
+            }
+        }
+
+        /**
+         * Filters the row @p input of the column-filtered level along its length, producing the
+         * @p width pixels of @p output. With SSE2, @p input must be readable for three values
+         * beyond the last pixel.
+         */
+
+        void filterRow(const float * const input, const std::size_t channels, const FilterTaps& taps,
+                       const std::size_t width, float * const output) {
+
+#ifdef __SSE2__
+            const auto rowLength = width * channels;
+#endif
+
+            for (std::size_t x = 0; x < width; ++x) {
+
+#ifdef __SSE2__
+
+                // A whole pixel is filtered in one register, whatever its channel count; lanes
+                // beyond its channels pick up the next pixel's values, which are simply discarded.
+
+                auto sum = _mm_setzero_ps();
+
+                for (auto tap = taps.offsets[x]; tap < taps.offsets[x + 1]; ++tap) {
+                    const auto pixel = input + static_cast<std::size_t>(taps.indices[tap]) * channels;
+                    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(taps.weights[tap]), _mm_loadu_ps(pixel)));
+                }
+
+                // Excess lanes may be stored over the following pixels, which are written
+                // afterwards, but not beyond the row, which another job may be writing.
+
+                if (x * channels + 4 <= rowLength) {
+                    _mm_storeu_ps(output + x * channels, sum);
+                }
+                else {
+                    float values[4];
+                    _mm_storeu_ps(values, sum);
+                    std::copy(values, values + channels, output + x * channels);
+                }
+
+#else
+
+                float sum[4] = {};
+
+                for (auto tap = taps.offsets[x]; tap < taps.offsets[x + 1]; ++tap) {
+
+                    const auto pixel = input + static_cast<std::size_t>(taps.indices[tap]) * channels;
+                    const auto weight = taps.weights[tap];
+
+                    for (std::size_t channel = 0; channel < channels; ++channel) {
+                        sum[channel] += weight * pixel[channel];
+                    }
+                }
+
+                std::copy(sum, sum + channels, output + x * channels);
+
+#endif
+
+            }
+        }
+
+        /**
+         * Gets a number of rows to process per job, for rows of @p rowLength values, such that each
+         * job has appreciably more work than the cost of spawning it.
+         */
+
+        std::size_t rowGrain(const std::size_t rowLength) {
+            return std::max<std::size_t>(16384 / std::max<std::size_t>(rowLength, 1), 1);
+        }
+    }
+
+    GLenum MipChain::format() const {
+
+        switch (channels) {
+            case 1: return GL_RED;
+            case 2: return GL_RG;
+            case 3: return GL_RGB;
+            default: return GL_RGBA;
+        }
+    }
+
+    MipGenerator::MipGenerator(JobSystem& jobs)
+        : m_jobs(jobs) {
+    }
+
+    MipChain MipGenerator::generate(std::vector<char> pixels, const Size2<int> size, const MipSettings& settings) const {
+
+        const auto channels = static_cast<std::size_t>(settings.channels);
+
+        assert(channels >= 1 && channels <= 4 && "Images must have between one and four channels.");
+        assert(pixels.size() == static_cast<std::size_t>(size.width()) * size.height() * channels
+               && "An image's pixels must fill its size.");
+
+        const auto levelCount = settings.levels > 0 ? std::min(settings.levels, mipLevelCount(size)) : mipLevelCount(size);
+
+        // Alpha, if present, is always linear.
+
+        const auto colourChannels = channels == 4 ? 3 : channels;
+
+        MipChain chain;
+        chain.size = size;
+        chain.channels = settings.channels;
+        chain.levels.resize(static_cast<std::size_t>(levelCount));
+
+        // The base level is decoded as the first level is reduced from it, rather than into a
+        // copy of its own, which (being the largest level by far) would cost more to fill than
+        // the decoding itself.
+
+        DecodeTables decodeTables;
+        for (std::size_t channel = 0; channel < channels; ++channel) {
+            for (auto byte = 0; byte < 256; ++byte) {
+                decodeTables[channel][byte] = settings.srgb && channel < colourChannels ? srgbDecodeTable()[byte] : byte / 255.0f;
+            }
+        }
+
+        chain.levels[0] = std::move(pixels);
+        const auto& base = chain.levels[0];
+
+        const auto srgbChannels = settings.srgb ? colourChannels : 0;
+
+        // Each level is reduced from the linear values of the one above, which are then no longer
+        // needed, so its buffer is reused two levels down.
+
+        std::vector<float> source;
+        std::vector<float> target;
+
+        for (GLint level = 1; level < levelCount; ++level) {
+
+            const auto sourceSize = mipLevelSize(size, level - 1);
+            const auto targetSize = mipLevelSize(size, level);
+
+            const auto sourceRowLength = static_cast<std::size_t>(sourceSize.width()) * channels;
+            const auto targetRowLength = static_cast<std::size_t>(targetSize.width()) * channels;
+
+            const auto columnTaps = makeTaps(sourceSize.height(), targetSize.height(), settings.filter);
+            const auto rowTaps = makeTaps(sourceSize.width(), targetSize.width(), settings.filter);
+
+            target.resize(targetRowLength * static_cast<std::size_t>(targetSize.height()));
+
+            auto& bytes = chain.levels[static_cast<std::size_t>(level)];
+            bytes.resize(target.size());
+
+            // Each row is filtered down its columns, a whole row at a time so that the innermost
+            // loop runs along contiguous values, four to an SSE2 register, then along its length,
+            // a pixel to a register, then encoded back to bytes, all while it is still in cache.
+
+            m_jobs.parallelFor(0, static_cast<std::size_t>(targetSize.height()), rowGrain(sourceRowLength), [&](const std::size_t row) {
+
+                // Each thread keeps its row between jobs. The padding lets the row filter load a
+                // whole register for the last pixel.
+
+                thread_local std::vector<float> columnsFiltered;
+                columnsFiltered.resize(sourceRowLength + 3);
+
+                if (level == 1) {
+                    filterColumns(base.data(), sourceRowLength, channels, decodeTables, columnTaps, row, columnsFiltered.data());
+                }
+                else {
+                    filterColumns(source.data(), sourceRowLength, columnTaps, row, columnsFiltered.data());
+                }
+
+                const auto output = target.data() + row * targetRowLength;
+
+                filterRow(columnsFiltered.data(), channels, rowTaps, static_cast<std::size_t>(targetSize.width()), output);
+                encodeRow(output, targetRowLength, channels, srgbChannels, bytes.data() + row * targetRowLength);
+            });
+
+            std::swap(source, target);
+        }
+
+        return chain;
+    }
+
+    std::vector<char> convertChannels(const char * const pixels, const Size2<int> size, const int fromChannels,
+                                      const int toChannels) {
+
+        assert(fromChannels >= 1 && fromChannels <= 4 && toChannels >= 1 && toChannels <= 4);
+
+        const auto pixelCount = static_cast<std::size_t>(size.width()) * size.height();
+        const auto copied = static_cast<std::size_t>(std::min(fromChannels, toChannels));
+
+        std::vector<char> converted(pixelCount * static_cast<std::size_t>(toChannels));
+
+        for (std::size_t i = 0; i < pixelCount; ++i) {
+
+            const auto input = pixels + i * static_cast<std::size_t>(fromChannels);
+            const auto output = converted.data() + i * static_cast<std::size_t>(toChannels);
+
+            std::copy(input, input + copied, output);
+
+            if (toChannels == 4 && fromChannels < 4) {
+                output[3] = static_cast<char>(255);
+            }
+        }
+
+        return converted;
+    }
+
+    void uploadMipChain(TextureUploader& uploader, Texture2D& texture, MipChain chain) {
+
+        const auto levels = std::min(static_cast<GLsizei>(chain.levels.size()), texture.levels());
+
+        for (GLint level = 0; level < levels; ++level) {
+            uploader.upload(texture, level, chain.format(), GL_UNSIGNED_BYTE, std::move(chain.levels[static_cast<std::size_t>(level)]));
+        }
+    }
+
+    void uploadMipChain(TextureUploader& uploader, TextureArray& texture, const GLint layer, MipChain chain) {
+
+        const auto levels = std::min(static_cast<GLsizei>(chain.levels.size()), texture.levels());
+
+        for (GLint level = 0; level < levels; ++level) {
+            uploader.upload(texture, layer, level, chain.format(), GL_UNSIGNED_BYTE,
+                            std::move(chain.levels[static_cast<std::size_t>(level)]));
+        }
+    }
+}
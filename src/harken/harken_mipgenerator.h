@@ -0,0 +1,113 @@
+#ifndef HARKEN_MIPGENERATOR_H
+#define HARKEN_MIPGENERATOR_H
+
+#include "harken_global.h"
+#include "harken_jobsystem.h"
+#include "harken_size.h"
+#include "harken_texture.h"
+#include "harken_textureuploader.h"
+
+#include <GL/glew.h>
+
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * The filter with which each mipmap level is reduced from the one above.
+     */
+
+    enum class MipFilter {
+        Box,    ///< Averages the pixels each pixel covers. Cheap, but slightly blurry and prone to aliasing.
+        Kaiser  ///< A Kaiser-windowed sinc, which keeps levels sharper without aliasing, at several times the cost.
+    };
+
+    /**
+     * How MipGenerator interprets and filters an image.
+     */
+
+    struct MipSettings {
+
+        int channels = 4;                   ///< The number of channels, from 1 to 4, each a byte.
+        bool srgb = false;                  ///< Whether colour channels are sRGB-encoded, as for @c GL_SRGB8_ALPHA8.
+        MipFilter filter = MipFilter::Box;  ///< The filter levels are reduced with.
+        GLsizei levels = 0;                 ///< The number of levels to generate, including the base, or @c 0 for all.
+    };
+
+    /**
+     * A mipmap chain generated by MipGenerator: tightly packed pixels of each level, bottom row
+     * first, ready to be handed to a TextureUploader.
+     */
+
+    struct MipChain {
+
+        Size2<int> size;                        ///< The size of the base level.
+        int channels = 0;                       ///< The number of channels, from 1 to 4, each a byte.
+        std::vector<std::vector<char>> levels;  ///< The pixels of each level, from the base down.
+
+        /**
+         * Gets the pixel transfer format for the chain's pixels, such as @c GL_RGBA.
+         */
+
+        GLenum format() const;
+    };
+
+    /**
+     * Generates mipmap chains on the CPU, spreading the work across the workers of a JobSystem,
+     * for drivers on which <tt>glGenerateMipmap()</tt> is slow (software renderers especially)
+     * or for images loaded off the rendering thread, where it cannot be called at all.
+     *
+     * Each level is reduced from the one above in linear floating point, with colour channels of
+     * sRGB images decoded as they are read and encoded again afterwards, so that averages of sRGB
+     * colours come out as bright as they should (averaging the encoded values, as many drivers
+     * do, darkens every level). Filters are separable: each row of a level is filtered down the
+     * columns of the level above, then along its length, then encoded back to bytes, a job per
+     * band of rows. Alpha is the fourth channel, and is always linear.
+     */
+
+    class MipGenerator {
+    public:
+
+        /**
+         * Creates a generator that runs on @p jobs, which must outlive it.
+         */
+
+        explicit MipGenerator(JobSystem& jobs);
+
+        /**
+         * Generates the mipmap chain of the image @p pixels, of the given @p size, whose pixels
+         * are tightly packed rows (bottom row first) of the channels given by @p settings, and
+         * which becomes the chain's base level.
+         */
+
+        MipChain generate(std::vector<char> pixels, Size2<int> size, const MipSettings& settings) const;
+
+    private:
+
+        JobSystem& m_jobs;
+    };
+
+    /**
+     * Converts @p pixels, of the given @p size, from @p fromChannels channels per pixel to
+     * @p toChannels, each a byte. Colour channels that are added are zero, and an alpha channel
+     * that is added is opaque.
+     */
+
+    std::vector<char> convertChannels(const char * pixels, Size2<int> size, int fromChannels, int toChannels);
+
+    /**
+     * Queues the upload of as many levels of @p chain as @p texture has, by handing their pixels
+     * to @p uploader without copying them.
+     */
+
+    void uploadMipChain(TextureUploader& uploader, Texture2D& texture, MipChain chain);
+
+    /**
+     * Queues the upload of as many levels of @p chain as @p texture has, to layer @p layer.
+     * @see uploadMipChain(TextureUploader&, Texture2D&, MipChain)
+     */
+
+    void uploadMipChain(TextureUploader& uploader, TextureArray& texture, GLint layer, MipChain chain);
+}
+
+#endif
@@ -0,0 +1,9 @@
+#include "harken_path.h"
+
+namespace Harken {
+
+    std::string directoryOf(const std::string& path) {
+        const auto separator = path.find_last_of('/');
+        return separator == std::string::npos ? std::string{} : path.substr(0, separator + 1);
+    }
+}
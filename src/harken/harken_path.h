@@ -0,0 +1,18 @@
+#ifndef HARKEN_PATH_H
+#define HARKEN_PATH_H
+
+#include "harken_global.h"
+
+#include <string>
+
+namespace Harken {
+
+    /**
+     * Gets the directory part of @p path, including the trailing separator, or an empty string
+     * if @p path has none. Only @c '/' is treated as a separator.
+     */
+
+    std::string directoryOf(const std::string& path);
+}
+
+#endif
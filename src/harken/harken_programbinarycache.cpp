@@ -0,0 +1,209 @@
+#include "harken_programbinarycache.h"
+#include "harken_hash.h"
+#include "harken_stringbuilder.h"
+
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <utility>
+
+namespace Harken {
+
+    namespace {
+
+        /**
+         * Precedes each binary in its file, so that files written by some other version of the
+         * cache, truncated files and (however unlikely) files whose keys merely share a name can
+         * be told apart from valid ones.
+         */
+
+        struct BinaryHeader {
+            char magic[4];
+            std::uint32_t version;
+            std::uint64_t key;
+            std::uint32_t format;
+            std::uint32_t length;
+        };
+
+        constexpr char binaryMagic[4] = {'H', 'K', 'P', 'B'};
+        constexpr std::uint32_t binaryVersion = 1;
+
+        /**
+         * Gets the OpenGL string @p name, or an empty string if the driver returns none.
+         */
+
+        std::string glString(const GLenum name) {
+            const auto string = glGetString(name);
+            return string ? reinterpret_cast<const char *>(string) : "";
+        }
+    }
+
+    ProgramBinaryCache::ProgramBinaryCache(std::string directory)
+        : m_directory{std::move(directory)} {
+
+        // Failure (most often because the directory already exists) is not an error here: if the
+        // directory cannot be written to, binaries simply fail to be stored.
+
+        mkdir(m_directory.c_str(), 0755);
+
+        m_driver = StringBuilder{} << glString(GL_VENDOR) << '\n'
+                                   << glString(GL_RENDERER) << '\n'
+                                   << glString(GL_VERSION);
+
+        if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary) {
+            GLint formatCount = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+            m_supported = formatCount > 0;
+        }
+    }
+
+    std::uint64_t ProgramBinaryCache::key(const std::vector<ShaderSource>& sources) const {
+
+        Hasher hasher;
+        hasher.add(m_driver);
+
+        for (const auto& source : sources) {
+            hasher.add(source.hash);
+        }
+
+        return hasher.value();
+    }
+
+    ShaderProgram ProgramBinaryCache::link(const std::vector<ShaderSource>& sources) {
+
+        const auto programKey = key(sources);
+
+        ShaderProgram cachedProgram;
+        if (load(programKey, cachedProgram)) {
+            return cachedProgram;
+        }
+
+        ShaderProgram program;
+        for (const auto& source : sources) {
+            program.attach(std::make_shared<Shader>(source));
+        }
+
+        if (m_supported) {
+            program.setBinaryRetrievable(true);
+        }
+
+        program.link();
+        store(programKey, program);
+
+        return program;
+    }
+
+    bool ProgramBinaryCache::load(const std::uint64_t key, ShaderProgram& program) {
+
+        if (!m_supported) {
+            ++m_stats.misses;
+            return false;
+        }
+
+        const auto filePath = path(key);
+
+        std::ifstream file{filePath, std::ios::binary | std::ios::ate};
+        if (!file) {
+            ++m_stats.misses;
+            return false;
+        }
+
+        const auto fileSize = static_cast<std::size_t>(file.tellg());
+        file.seekg(0);
+
+        BinaryHeader header;
+        std::vector<char> binary;
+
+        const auto valid = [&]() {
+
+            if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+                return false;
+            }
+
+            if (std::memcmp(header.magic, binaryMagic, sizeof(binaryMagic)) != 0
+                    || header.version != binaryVersion || header.key != key
+                    || header.length != fileSize - sizeof(header)) {
+                return false;
+            }
+
+            binary.resize(header.length);
+            return static_cast<bool>(file.read(binary.data(), header.length));
+        }();
+
+        file.close();
+
+        if (valid && program.loadBinary(header.format, binary.data(), static_cast<GLsizei>(binary.size()))) {
+            ++m_stats.hits;
+            return true;
+        }
+
+        // Whatever is wrong with the file, it is no use; the binary that replaces it is written
+        // when the program has been linked from source.
+
+        ++m_stats.rejected;
+        ++m_stats.misses;
+        std::remove(filePath.c_str());
+        return false;
+    }
+
+    std::string ProgramBinaryCache::path(const std::uint64_t key) const {
+        return StringBuilder{} << m_directory << '/' << std::hex << std::setw(16) << std::setfill('0') << key << ".bin";
+    }
+
+    const ProgramBinaryCacheStats& ProgramBinaryCache::stats() const {
+        return m_stats;
+    }
+
+    void ProgramBinaryCache::store(const std::uint64_t key, const ShaderProgram& program) {
+
+        if (!m_supported) {
+            return;
+        }
+
+        GLenum format = GL_NONE;
+        const auto binary = program.binary(format);
+        if (binary.empty()) {
+            return;
+        }
+
+        BinaryHeader header;
+        std::memcpy(header.magic, binaryMagic, sizeof(binaryMagic));
+        header.version = binaryVersion;
+        header.key = key;
+        header.format = format;
+        header.length = static_cast<std::uint32_t>(binary.size());
+
+        // The binary is written to a temporary file that is then renamed over the final one, so
+        // that another process starting up concurrently never reads a partly written binary.
+
+        const auto filePath = path(key);
+        const auto temporaryPath = filePath + ".tmp";
+
+        {
+            std::ofstream file{temporaryPath, std::ios::binary | std::ios::trunc};
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+
+            if (!file) {
+                file.close();
+                std::remove(temporaryPath.c_str());
+                return;
+            }
+        }
+
+        if (std::rename(temporaryPath.c_str(), filePath.c_str()) == 0) {
+            ++m_stats.stored;
+        }
+        else {
+            std::remove(temporaryPath.c_str());
+        }
+    }
+
+    bool ProgramBinaryCache::supported() const {
+        return m_supported;
+    }
+}
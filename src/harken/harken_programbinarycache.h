@@ -0,0 +1,101 @@
+#ifndef HARKEN_PROGRAMBINARYCACHE_H
+#define HARKEN_PROGRAMBINARYCACHE_H
+
+#include "harken_global.h"
+#include "harken_shader.h"
+#include "harken_shaderprogram.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * Counts of what a ProgramBinaryCache has done since it was created.
+     */
+
+    struct ProgramBinaryCacheStats {
+
+        std::size_t hits = 0;      ///< Programs loaded from a cached binary.
+        std::size_t misses = 0;    ///< Programs compiled and linked from source.
+        std::size_t rejected = 0;  ///< Cached binaries the driver refused (also counted as misses).
+        std::size_t stored = 0;    ///< Binaries written to the cache.
+    };
+
+    /**
+     * Keeps the binaries of linked shader programs on disk, so that later runs can load programs
+     * with <tt>glProgramBinary()</tt> rather than compiling and linking them from source. Each
+     * binary is keyed by a hash of the content hashes of the program's shaders (which cover the
+     * source code as handed to the compiler, with includes resolved and definitions inserted) and
+     * of the vendor, renderer and version strings of the driver, since binaries are only valid for
+     * the driver that produced them.
+     *
+     * Drivers may still reject a binary whose key matches (after a driver update that does not
+     * change the version string, say), in which case the program is compiled from source and the
+     * stale binary replaced. Where the context does not support program binaries at all, the cache
+     * does nothing but compile and link.
+     */
+
+    class ProgramBinaryCache {
+    public:
+
+        /**
+         * Creates a cache that keeps binaries in @p directory, creating the directory if it does
+         * not exist. An OpenGL context must be current, and every program the cache links will
+         * belong to it.
+         */
+
+        explicit ProgramBinaryCache(std::string directory);
+
+        /**
+         * Computes the key under which the binary of a program linked from @p sources is cached.
+         */
+
+        std::uint64_t key(const std::vector<ShaderSource>& sources) const;
+
+        /**
+         * Gets a program linked from @p sources, loading it from the cache if a binary that the
+         * driver accepts is there, or compiling and linking it (and storing its binary) otherwise.
+         * Throws a ShaderCompilationException or ShaderLinkException if the sources contain
+         * errors.
+         */
+
+        ShaderProgram link(const std::vector<ShaderSource>& sources);
+
+        /**
+         * Loads the binary cached under @p key into @p program, which must be newly created, and
+         * returns whether it was loaded (counting a hit) or not (counting a miss). If not,
+         * @p program must be discarded, and a new program linked from source; once it is linked,
+         * it should be passed to store(). This lets programs whose links are deferred use the
+         * cache.
+         */
+
+        bool load(std::uint64_t key, ShaderProgram& program);
+
+        /**
+         * Stores the binary of @p program, which must have been linked (and, for the binary to be
+         * available, made retrievable with ShaderProgram::setBinaryRetrievable() beforehand),
+         * under @p key.
+         */
+
+        void store(std::uint64_t key, const ShaderProgram& program);
+
+        const ProgramBinaryCacheStats& stats() const;  ///< Gets the cache's statistics.
+        bool supported() const;                        ///< Gets whether the context supports program binaries.
+
+    private:
+
+        std::string path(std::uint64_t key) const;
+
+        std::string m_directory;
+        std::string m_driver;
+        bool m_supported = false;
+        ProgramBinaryCacheStats m_stats;
+    };
+}
+
+#endif
@@ -0,0 +1,196 @@
+#include "harken_renderqueue.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace Harken {
+
+    namespace {
+
+        constexpr int RadixBits = 8;
+        constexpr int RadixSize = 1 << RadixBits;
+        constexpr int KeyBits = 64;
+
+        // A value that no 16-bit material identifier can take, marking that no material has yet
+        // been applied to the current program.
+
+        constexpr auto NoMaterial = std::uint32_t{0x10000};
+
+        /**
+         * Records in @p stats the number of times each piece of state would change if the draws in
+         * @p items were executed in the order they were submitted.
+         */
+
+        void countUnsortedStateChanges(const std::vector<DrawItem>& items, RenderQueueStats& stats) {
+
+            const ShaderProgram * program = nullptr;
+            const VertexArrayObject * vertexArray = nullptr;
+            auto material = NoMaterial;
+
+            for (const auto& item : items) {
+
+                if (item.program != program) {
+                    program = item.program;
+                    ++stats.unsortedProgramChanges;
+                    material = NoMaterial;
+                }
+
+                if (item.vertexArray != vertexArray) {
+                    vertexArray = item.vertexArray;
+                    ++stats.unsortedVertexArrayChanges;
+                }
+
+                if (item.material != material) {
+                    material = item.material;
+                    ++stats.unsortedMaterialChanges;
+                }
+            }
+        }
+    }
+
+    RenderKey makeRenderKey(const GLuint program,
+                            const GLuint vertexArray,
+                            const std::uint16_t material,
+                            const float depth) {
+
+        const auto clampedDepth = std::min(std::max(depth, 0.0f), 1.0f);
+        const auto quantisedDepth = static_cast<RenderKey>(std::lround(clampedDepth * 0xFFFF));
+
+        return (static_cast<RenderKey>(program & 0xFFFF) << 48)
+             | (static_cast<RenderKey>(vertexArray & 0xFFFF) << 32)
+             | (static_cast<RenderKey>(material) << 16)
+             | quantisedDepth;
+    }
+
+    void sortRenderQueueEntries(std::vector<RenderQueueEntry>& entries, std::vector<RenderQueueEntry>& scratch) {
+
+        if (entries.size() < 2) {
+            return;
+        }
+
+        scratch.resize(entries.size());
+
+        // Bits that are the same in every key cannot affect the order, so any digit made up only
+        // of such bits need not be sorted on.
+
+        auto differingBits = RenderKey{0};
+        for (const auto& entry : entries) {
+            differingBits |= entry.key ^ entries.front().key;
+        }
+
+        for (auto shift = 0; shift < KeyBits; shift += RadixBits) {
+
+            if (((differingBits >> shift) & (RadixSize - 1)) == 0) {
+                continue;
+            }
+
+            std::array<std::size_t, RadixSize> offsets{};
+            for (const auto& entry : entries) {
+                ++offsets[(entry.key >> shift) & (RadixSize - 1)];
+            }
+
+            auto total = std::size_t{0};
+            for (auto& offset : offsets) {
+                const auto count = offset;
+                offset = total;
+                total += count;
+            }
+
+            for (const auto& entry : entries) {
+                scratch[offsets[(entry.key >> shift) & (RadixSize - 1)]++] = entry;
+            }
+
+            entries.swap(scratch);
+        }
+    }
+
+    std::size_t RenderQueueStats::changesSaved() const {
+
+        const auto unsorted = unsortedProgramChanges + unsortedVertexArrayChanges + unsortedMaterialChanges;
+        const auto sorted = programChanges + vertexArrayChanges + materialChanges;
+
+        return unsorted > sorted ? unsorted - sorted : 0;
+    }
+
+    void RenderQueue::clear() {
+        m_items.clear();
+        m_entries.clear();
+    }
+
+    const RenderQueueStats& RenderQueue::flush(const MaterialBinder& bindMaterial) {
+
+        m_stats = RenderQueueStats{};
+        m_stats.draws = m_items.size();
+
+        countUnsortedStateChanges(m_items, m_stats);
+
+        sortRenderQueueEntries(m_entries, m_scratch);
+
+        ShaderProgram * program = nullptr;
+        VertexArrayObject * vertexArray = nullptr;
+        auto material = NoMaterial;
+
+        for (const auto& entry : m_entries) {
+
+            const auto& item = m_items[entry.index];
+
+            // Changing program invalidates whatever material uniforms were set on the previous
+            // one, so the material must always be reapplied afterwards.
+
+            if (item.program != program) {
+                program = item.program;
+                program->use();
+                ++m_stats.programChanges;
+                material = NoMaterial;
+            }
+
+            if (item.vertexArray != vertexArray) {
+                vertexArray = item.vertexArray;
+                vertexArray->bind();
+                ++m_stats.vertexArrayChanges;
+            }
+
+            if (item.material != material) {
+
+                material = item.material;
+                ++m_stats.materialChanges;
+
+                if (bindMaterial) {
+                    bindMaterial(*program, item.material);
+                }
+            }
+
+            if (item.indexType == GL_NONE) {
+                glDrawArraysInstanced(item.mode, item.first, item.count, item.instanceCount);
+            }
+            else {
+
+                const auto indexSize = std::uintptr_t{item.indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint)};
+                const auto offset = reinterpret_cast<const GLvoid *>(item.first * indexSize);
+
+                glDrawElementsInstanced(item.mode, item.count, item.indexType, offset, item.instanceCount);
+            }
+        }
+
+        clear();
+        return m_stats;
+    }
+
+    std::size_t RenderQueue::size() const {
+        return m_items.size();
+    }
+
+    const RenderQueueStats& RenderQueue::stats() const {
+        return m_stats;
+    }
+
+    void RenderQueue::submit(const DrawItem& item, const float depth) {
+
+        const auto key = makeRenderKey(item.program->id(), item.vertexArray->id(), item.material, depth);
+
+        m_entries.push_back(RenderQueueEntry{key, static_cast<std::uint32_t>(m_items.size())});
+        m_items.push_back(item);
+    }
+}
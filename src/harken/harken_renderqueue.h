@@ -0,0 +1,157 @@
+#ifndef HARKEN_RENDERQUEUE_H
+#define HARKEN_RENDERQUEUE_H
+
+#include "harken_global.h"
+#include "harken_shaderprogram.h"
+#include "harken_vertexarrayobject.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * A 64-bit key by which draws are ordered in a RenderQueue. From most to least significant,
+     * the key holds 16 bits each of: the shader program name, the vertex array object name, the
+     * material identifier and the quantised depth. Sorting by key therefore groups together draws
+     * sharing a shader program (the most expensive state to change), then those sharing a vertex
+     * array object, then those sharing a material, and finally orders each group front to back.
+     */
+
+    using RenderKey = std::uint64_t;
+
+    /**
+     * Packs the components of a RenderKey. OpenGL object names are truncated to 16 bits; two
+     * distinct objects whose names collide in this way are merely not grouped optimally.
+     * @param depth The distance of the draw from the viewer, normalised to the range [0, 1]; out
+     *              of range values are clamped. Draws that should be drawn back to front (such
+     *              as translucent ones) should pass <tt>1 - depth</tt> instead.
+     */
+
+    RenderKey makeRenderKey(GLuint program, GLuint vertexArray, std::uint16_t material, float depth);
+
+    /**
+     * An entry in a RenderQueue: a sort key together with the index of the draw it refers to.
+     */
+
+    struct RenderQueueEntry {
+        RenderKey key;
+        std::uint32_t index;
+    };
+
+    /**
+     * Sorts @p entries into ascending order of key using an LSD radix sort over 8-bit digits,
+     * which is stable and runs in linear time. Digits that are identical across every entry
+     * (such as the program bits, when only one program is in use) are skipped entirely.
+     * @param scratch Working storage; its contents are overwritten. Reusing the same vector
+     *                across frames avoids reallocating it.
+     */
+
+    void sortRenderQueueEntries(std::vector<RenderQueueEntry>& entries, std::vector<RenderQueueEntry>& scratch);
+
+    /**
+     * The payload of a single draw recorded in a RenderQueue: the state it requires and the
+     * parameters of the draw call itself. Non-indexed draws leave @c indexType as @c GL_NONE.
+     */
+
+    struct DrawItem {
+        ShaderProgram * program;
+        VertexArrayObject * vertexArray;
+        std::uint16_t material;
+        GLenum mode;
+        GLint first;
+        GLsizei count;
+        GLenum indexType = GL_NONE;
+        GLsizei instanceCount = 1;
+    };
+
+    /**
+     * Counts of the state changes made while executing a RenderQueue, together with the counts
+     * that would have been made had its draws been executed in the order they were submitted.
+     */
+
+    struct RenderQueueStats {
+
+        std::size_t draws = 0;
+
+        std::size_t programChanges = 0;
+        std::size_t vertexArrayChanges = 0;
+        std::size_t materialChanges = 0;
+
+        std::size_t unsortedProgramChanges = 0;
+        std::size_t unsortedVertexArrayChanges = 0;
+        std::size_t unsortedMaterialChanges = 0;
+
+        /**
+         * Gets the total number of state changes avoided by sorting the queue.
+         */
+
+        std::size_t changesSaved() const;
+    };
+
+    /**
+     * Records draws for a frame, then sorts and executes them in one pass. Rather than issuing
+     * OpenGL calls in whatever order the caller happens to visit objects, each draw is recorded
+     * as a compact RenderKey plus a DrawItem payload; flush() radix-sorts the keys so that draws
+     * sharing state are adjacent, and only changes shader program, vertex array object or
+     * material when the next draw actually requires it.
+     */
+
+    class RenderQueue {
+    public:
+
+        /**
+         * A function invoked during flush() whenever the material changes between draws, which
+         * should make whatever OpenGL calls (such as setting uniforms or binding textures) are
+         * needed to apply the material with the given identifier to the current program.
+         */
+
+        using MaterialBinder = std::function<void(ShaderProgram&, std::uint16_t)>;
+
+        /**
+         * Discards every draw recorded since the last flush() without executing it.
+         */
+
+        void clear();
+
+        /**
+         * Sorts and executes every draw recorded since the last flush(), then clears the queue.
+         * Returns statistics on the state changes made (which are also available from stats()
+         * until the next flush()).
+         */
+
+        const RenderQueueStats& flush(const MaterialBinder& bindMaterial = nullptr);
+
+        /**
+         * Gets the number of draws recorded since the last flush().
+         */
+
+        std::size_t size() const;
+
+        /**
+         * Gets the statistics recorded by the most recent call to flush().
+         */
+
+        const RenderQueueStats& stats() const;
+
+        /**
+         * Records @p item to be drawn when the queue is next flushed.
+         * @param depth The normalised depth of the draw; see makeRenderKey().
+         */
+
+        void submit(const DrawItem& item, float depth);
+
+    private:
+
+        std::vector<DrawItem> m_items;
+        std::vector<RenderQueueEntry> m_entries;
+        std::vector<RenderQueueEntry> m_scratch;
+        RenderQueueStats m_stats;
+    };
+}
+
+#endif
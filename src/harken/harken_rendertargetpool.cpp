@@ -0,0 +1,143 @@
+#include "harken_rendertargetpool.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace Harken {
+
+    namespace {
+
+        void hashCombine(std::size_t& seed, const std::size_t value) {
+            seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+
+        bool hasStencil(const GLenum depthFormat) {
+            return depthFormat == GL_DEPTH24_STENCIL8 || depthFormat == GL_DEPTH32F_STENCIL8;
+        }
+    }
+
+    std::size_t bytesPerPixel(const GLenum internalFormat) {
+
+        // Formats with three components, or with a depth of 24 bits, are stored padded to four
+        // bytes (or eight, for 32-bit depth with stencil) by practically every implementation.
+
+        switch (internalFormat) {
+
+            case GL_R8:
+                return 1;
+
+            case GL_RG8:
+            case GL_R16F:
+            case GL_DEPTH_COMPONENT16:
+                return 2;
+
+            case GL_RGB8:
+            case GL_RGBA8:
+            case GL_SRGB8:
+            case GL_SRGB8_ALPHA8:
+            case GL_RGB10_A2:
+            case GL_R11F_G11F_B10F:
+            case GL_RG16F:
+            case GL_R32F:
+            case GL_DEPTH_COMPONENT24:
+            case GL_DEPTH_COMPONENT32:
+            case GL_DEPTH_COMPONENT32F:
+            case GL_DEPTH24_STENCIL8:
+                return 4;
+
+            case GL_RGB16F:
+            case GL_RGBA16F:
+            case GL_RG32F:
+            case GL_DEPTH32F_STENCIL8:
+                return 8;
+
+            case GL_RGB32F:
+            case GL_RGBA32F:
+                return 16;
+
+            default:
+                return 0;
+        }
+    }
+
+    std::size_t RenderTargetDesc::estimatedBytes() const {
+
+        const auto pixels = static_cast<std::size_t>(size.width()) * static_cast<std::size_t>(size.height());
+        const auto samplesPerPixel = static_cast<std::size_t>(std::max(samples, 1));
+
+        return pixels * samplesPerPixel * (bytesPerPixel(colorFormat) + bytesPerPixel(depthFormat));
+    }
+
+    std::size_t RenderTargetDesc::hash() const {
+
+        std::size_t seed = 0;
+        hashCombine(seed, std::hash<int>{}(size.width()));
+        hashCombine(seed, std::hash<int>{}(size.height()));
+        hashCombine(seed, std::hash<GLenum>{}(colorFormat));
+        hashCombine(seed, std::hash<GLenum>{}(depthFormat));
+        hashCombine(seed, std::hash<GLsizei>{}(samples));
+
+        return seed;
+    }
+
+    bool operator==(const RenderTargetDesc& lhs, const RenderTargetDesc& rhs) {
+        return lhs.size.width() == rhs.size.width()
+            && lhs.size.height() == rhs.size.height()
+            && lhs.colorFormat == rhs.colorFormat
+            && lhs.depthFormat == rhs.depthFormat
+            && lhs.samples == rhs.samples;
+    }
+
+    bool operator!=(const RenderTargetDesc& lhs, const RenderTargetDesc& rhs) {
+        return !(lhs == rhs);
+    }
+
+    RenderTarget::RenderTarget(const RenderTargetDesc& desc)
+        : m_desc(desc) {
+
+        if (desc.colorFormat == GL_NONE) {
+
+            m_framebuffer.bind();
+            glDrawBuffer(GL_NONE);
+            glReadBuffer(GL_NONE);
+        }
+        else if (desc.samples > 0) {
+
+            m_colorRenderbuffer = std::make_unique<Renderbuffer>(desc.colorFormat, desc.size, desc.samples);
+            m_framebuffer.attach(GL_COLOR_ATTACHMENT0, *m_colorRenderbuffer);
+        }
+        else {
+
+            m_colorTexture = std::make_unique<RenderTexture>(desc.colorFormat, desc.size);
+            m_framebuffer.attach(GL_COLOR_ATTACHMENT0, *m_colorTexture);
+        }
+
+        if (desc.depthFormat != GL_NONE) {
+
+            const auto attachment = hasStencil(desc.depthFormat) ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+
+            m_depthRenderbuffer = std::make_unique<Renderbuffer>(desc.depthFormat, desc.size, desc.samples);
+            m_framebuffer.attach(attachment, *m_depthRenderbuffer);
+        }
+
+        m_framebuffer.checkComplete();
+        FramebufferObject::unbind();
+    }
+
+    void RenderTarget::bind() {
+        m_framebuffer.bind();
+        glViewport(0, 0, m_desc.size.width(), m_desc.size.height());
+    }
+
+    RenderTexture * RenderTarget::colorTexture() {
+        return m_colorTexture.get();
+    }
+
+    const RenderTargetDesc& RenderTarget::desc() const {
+        return m_desc;
+    }
+
+    FramebufferObject& RenderTarget::framebuffer() {
+        return m_framebuffer;
+    }
+}
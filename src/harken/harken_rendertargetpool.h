@@ -0,0 +1,273 @@
+#ifndef HARKEN_RENDERTARGETPOOL_H
+#define HARKEN_RENDERTARGETPOOL_H
+
+#include "harken_global.h"
+#include "harken_framebufferobject.h"
+#include "harken_size.h"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * Gets the number of bytes that each pixel of an image with the sized internal format
+     * @p internalFormat occupies, or @c 0 if the format is not one that is commonly rendered to.
+     * Drivers may pad storage, so this is only an estimate of the memory an image uses.
+     */
+
+    std::size_t bytesPerPixel(GLenum internalFormat);
+
+    /**
+     * Describes a render target: its size and the formats of its attachments. Two targets with
+     * equal descriptions are interchangeable.
+     */
+
+    struct RenderTargetDesc {
+
+        Size2<int> size;
+        GLenum colorFormat = GL_RGBA8;  ///< The colour attachment's format, or @c GL_NONE.
+        GLenum depthFormat = GL_NONE;   ///< The depth (or depth-stencil) attachment's format, or @c GL_NONE.
+
+        /**
+         * The number of samples per pixel, or @c 0 for single-sampled targets. Multisampled
+         * targets store colour in a renderbuffer, which must be resolved into a single-sampled
+         * target by blitting before it can be sampled from.
+         */
+
+        GLsizei samples = 0;
+
+        /**
+         * Estimates the video memory used by a target of this description, in bytes.
+         */
+
+        std::size_t estimatedBytes() const;
+
+        /**
+         * Computes a hash of the description, for use as a lookup key.
+         */
+
+        std::size_t hash() const;
+    };
+
+    bool operator==(const RenderTargetDesc& lhs, const RenderTargetDesc& rhs);
+    bool operator!=(const RenderTargetDesc& lhs, const RenderTargetDesc& rhs);
+
+    /**
+     * A framebuffer object together with the attachments it owns, as described by a
+     * RenderTargetDesc. Single-sampled colour is stored in a RenderTexture, so that later passes can
+     * sample it; everything else is stored in renderbuffers.
+     */
+
+    class RenderTarget {
+    public:
+
+        /**
+         * Creates the framebuffer object and attachments that @p desc describes. Throws a
+         * FramebufferException if the combination of formats cannot be rendered to.
+         */
+
+        explicit RenderTarget(const RenderTargetDesc& desc);
+
+        /**
+         * Binds the target's framebuffer object to @c GL_FRAMEBUFFER and sets the viewport to
+         * cover the whole target.
+         */
+
+        void bind();
+
+        /**
+         * Gets the texture holding the target's colour, or @c nullptr if the target has no colour
+         * attachment or is multisampled.
+         */
+
+        RenderTexture * colorTexture();
+
+        const RenderTargetDesc& desc() const;  ///< Gets the description of the target.
+        FramebufferObject& framebuffer();      ///< Gets the target's framebuffer object.
+
+    private:
+
+        RenderTargetDesc m_desc;
+        FramebufferObject m_framebuffer;
+        std::unique_ptr<RenderTexture> m_colorTexture;
+        std::unique_ptr<Renderbuffer> m_colorRenderbuffer;
+        std::unique_ptr<Renderbuffer> m_depthRenderbuffer;
+    };
+
+    /**
+     * Counts of what a RenderTargetPool has done since it was created.
+     */
+
+    struct RenderTargetPoolStats {
+
+        std::size_t created = 0;    ///< Targets created because no idle target matched.
+        std::size_t reused = 0;     ///< Requests satisfied by an idle target.
+        std::size_t destroyed = 0;  ///< Targets destroyed, by endFrame() or clear().
+        std::size_t liveBytes = 0;  ///< Estimated memory used by every target the pool owns.
+    };
+
+    /**
+     * Recycles render targets between passes and across frames, so that intermediate targets
+     * (offscreen passes, downsampled effect buffers and so on) are not created and destroyed every
+     * frame. A pass acquires a target matching its description, renders to it, and releases it once
+     * the target's contents are no longer needed, whereupon it is free for any later pass (in the
+     * same frame or a later one) that needs a target of the same description.
+     *
+     * Targets left idle for a number of consecutive frames (for example, because the window was
+     * resized, so targets of the old size will never be requested again) are destroyed by
+     * endFrame().
+     *
+     * @tparam Target The type of target pooled: constructible from a RenderTargetDesc, and
+     *                providing <tt>desc()</tt>. The pool only keeps the books, so that they can
+     *                be exercised with a stand-in for RenderTarget where there is no OpenGL
+     *                context; applications use RenderTargetPool.
+     */
+
+    template<typename Target>
+    class BasicRenderTargetPool {
+    public:
+
+        /**
+         * @param maxIdleFrames The number of whole frames for which a target may go unacquired
+         *                      before it is destroyed.
+         */
+
+        explicit BasicRenderTargetPool(const int maxIdleFrames = 3)
+            : m_maxIdleFrames{maxIdleFrames} {
+
+            assert(maxIdleFrames >= 0 && "Render targets cannot be kept for a negative number of frames.");
+        }
+
+        BasicRenderTargetPool(const BasicRenderTargetPool&) = delete;
+        BasicRenderTargetPool& operator=(const BasicRenderTargetPool&) = delete;
+
+        /**
+         * Gets an idle target matching @p desc, or creates one if there is none. The target is
+         * owned by the pool, and remains valid until it is released and subsequently destroyed.
+         */
+
+        Target& acquire(const RenderTargetDesc& desc) {
+
+            const auto hash = desc.hash();
+
+            for (auto& entry : m_entries) {
+                if (!entry.acquired && entry.hash == hash && entry.target->desc() == desc) {
+
+                    entry.acquired = true;
+                    entry.lastUsedFrame = m_frame;
+                    ++m_stats.reused;
+
+                    return *entry.target;
+                }
+            }
+
+            m_entries.push_back(Entry{std::make_unique<Target>(desc), hash, true, m_frame});
+
+            ++m_stats.created;
+            m_stats.liveBytes += desc.estimatedBytes();
+
+            return *m_entries.back().target;
+        }
+
+        /**
+         * Destroys every target, whether acquired or not.
+         */
+
+        void clear() {
+
+            m_stats.destroyed += m_entries.size();
+            m_stats.liveBytes = 0;
+
+            m_entries.clear();
+        }
+
+        /**
+         * Ends the current frame, destroying targets that have been idle for too long.
+         */
+
+        void endFrame() {
+
+            ++m_frame;
+
+            const auto expired = [this](const Entry& entry) {
+                return !entry.acquired && m_frame - entry.lastUsedFrame > static_cast<std::uint64_t>(m_maxIdleFrames);
+            };
+
+            for (const auto& entry : m_entries) {
+                if (expired(entry)) {
+                    ++m_stats.destroyed;
+                    m_stats.liveBytes -= entry.target->desc().estimatedBytes();
+                }
+            }
+
+            m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), expired), m_entries.end());
+        }
+
+        /**
+         * Returns @p target, which must have been acquired from this pool, to the idle targets.
+         * Releasing a target the pool does not own does nothing, though it fails an assertion in
+         * debug builds.
+         */
+
+        void release(Target& target) {
+
+            const auto entry = std::find_if(m_entries.begin(), m_entries.end(), [&target](const Entry& candidate) {
+                return candidate.target.get() == &target;
+            });
+
+            assert(entry != m_entries.end() && entry->acquired && "Render target was not acquired from this pool.");
+
+            if (entry == m_entries.end()) {
+                return;
+            }
+
+            entry->acquired = false;
+            entry->lastUsedFrame = m_frame;
+        }
+
+        /**
+         * Gets the number of targets the pool owns.
+         */
+
+        std::size_t size() const {
+            return m_entries.size();
+        }
+
+        /**
+         * Gets the pool's statistics.
+         */
+
+        const RenderTargetPoolStats& stats() const {
+            return m_stats;
+        }
+
+    private:
+
+        struct Entry {
+            std::unique_ptr<Target> target;
+            std::size_t hash;
+            bool acquired;
+            std::uint64_t lastUsedFrame;
+        };
+
+        std::vector<Entry> m_entries;
+        int m_maxIdleFrames;
+        std::uint64_t m_frame = 0;
+        RenderTargetPoolStats m_stats;
+    };
+
+    /**
+     * A pool of RenderTarget objects; see BasicRenderTargetPool.
+     */
+
+    using RenderTargetPool = BasicRenderTargetPool<RenderTarget>;
+}
+
+#endif
@@ -0,0 +1,209 @@
+#include "harken_resourceloader.h"
+#include "harken_exception.h"
+
+#include <chrono>
+#include <future>
+#include <iterator>
+
+namespace Harken {
+
+    GLsync GLUploadFences::insert() {
+
+        // The flush is what makes the fence visible to the rendering thread's context; without
+        // it, the fence might sit in this context's command queue indefinitely.
+
+        const auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+
+        return fence;
+    }
+
+    GLenum GLUploadFences::poll(const GLsync fence) {
+        return glClientWaitSync(fence, 0, 0);
+    }
+
+    void GLUploadFences::remove(const GLsync fence) {
+        glDeleteSync(fence);
+    }
+
+    ResourceLoader::ResourceLoader(JobSystem& jobs, std::unique_ptr<SharedGLContext> context, std::unique_ptr<UploadFences> fences)
+        : m_jobs(jobs), m_context{std::move(context)}, m_fences{std::move(fences)} {
+
+        std::promise<void> started;
+        auto startedFuture = started.get_future();
+
+        m_thread = std::thread{[this, &started]() {
+
+            try {
+                m_context->makeCurrent();
+            }
+            catch (...) {
+                started.set_exception(std::current_exception());
+                return;
+            }
+
+            started.set_value();
+            uploadLoop();
+        }};
+
+        try {
+            startedFuture.get();
+        }
+        catch (...) {
+            m_thread.join();
+            throw;
+        }
+    }
+
+    ResourceLoader::~ResourceLoader() {
+
+        m_jobs.wait(m_jobCounter);
+
+        {
+            const std::lock_guard<std::mutex> lock{m_mutex};
+            m_stopping = true;
+        }
+
+        m_uploadsQueued.notify_one();
+        m_thread.join();
+
+        m_fenced.insert(m_fenced.end(), m_uploaded.begin(), m_uploaded.end());
+        for (const auto& task : m_fenced) {
+            if (task->fence) {
+                m_fences->remove(task->fence);
+            }
+        }
+    }
+
+    void ResourceLoader::finish() {
+
+        // Waiting on the jobs first lets the calling thread help prepare loads if it is one of
+        // the job system's workers.
+
+        m_jobs.wait(m_jobCounter);
+
+        while (update(), m_pending > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+    }
+
+    void ResourceLoader::finishUpload(std::shared_ptr<LoadTask> task) {
+        const std::lock_guard<std::mutex> lock{m_mutex};
+        m_uploaded.push_back(std::move(task));
+    }
+
+    std::size_t ResourceLoader::pending() const {
+        return m_pending;
+    }
+
+    void ResourceLoader::queueUpload(std::shared_ptr<LoadTask> task) {
+
+        {
+            const std::lock_guard<std::mutex> lock{m_mutex};
+            m_uploads.push_back(std::move(task));
+        }
+
+        m_uploadsQueued.notify_one();
+    }
+
+    std::size_t ResourceLoader::update() {
+
+        {
+            const std::lock_guard<std::mutex> lock{m_mutex};
+            m_fenced.insert(m_fenced.end(), std::make_move_iterator(m_uploaded.begin()), std::make_move_iterator(m_uploaded.end()));
+            m_uploaded.clear();
+        }
+
+        std::size_t finished = 0;
+
+        for (auto it = m_fenced.begin(); it != m_fenced.end();) {
+
+            auto& task = **it;
+
+            if (!task.failed) {
+
+                // A timeout of zero only polls the fence, so the rendering thread never waits here
+                // for the GPU to finish an upload.
+
+                const auto result = m_fences->poll(task.fence);
+                if (result == GL_TIMEOUT_EXPIRED) {
+                    ++it;
+                    continue;
+                }
+
+                m_fences->remove(task.fence);
+                task.fence = nullptr;
+
+                if (result == GL_WAIT_FAILED) {
+                    task.failed = true;
+                    task.error = "Could not wait for a resource to be uploaded.";
+                }
+            }
+
+            if (task.failed) {
+                task.fail();
+            }
+            else {
+                task.complete();
+            }
+
+            it = m_fenced.erase(it);
+            ++finished;
+        }
+
+        m_pending -= finished;
+        return finished;
+    }
+
+    void ResourceLoader::uploadLoop() {
+
+        for (;;) {
+
+            std::shared_ptr<LoadTask> task;
+
+            {
+                std::unique_lock<std::mutex> lock{m_mutex};
+                m_uploadsQueued.wait(lock, [this]() {
+                    return m_stopping || !m_uploads.empty();
+                });
+
+                if (m_stopping) {
+                    break;
+                }
+
+                task = std::move(m_uploads.front());
+                m_uploads.pop_front();
+            }
+
+            try {
+                task->upload();
+            }
+            catch (const std::exception& ex) {
+                task->failed = true;
+                task->error = ex.what();
+            }
+            catch (...) {
+                task->failed = true;
+                task->error = "Uploading a resource threw an exception of unknown type.";
+            }
+
+            if (!task->failed) {
+                task->fence = m_fences->insert();
+
+                if (!task->fence) {
+                    task->failed = true;
+                    task->error = "Could not insert a fence after uploading a resource.";
+                }
+            }
+
+            finishUpload(std::move(task));
+        }
+
+        try {
+            m_context->releaseCurrent();
+        }
+        catch (const Exception&) {
+            // The context is about to be destroyed anyway.
+        }
+    }
+}
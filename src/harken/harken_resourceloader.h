@@ -0,0 +1,316 @@
+#ifndef HARKEN_RESOURCELOADER_H
+#define HARKEN_RESOURCELOADER_H
+
+#include "harken_global.h"
+#include "harken_jobsystem.h"
+#include "harken_sharedglcontext.h"
+
+#include <GL/glew.h>
+
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * The progress of a load started by ResourceLoader::load().
+     */
+
+    enum class LoadStatus {
+        Pending,  ///< Still being prepared or uploaded.
+        Ready,    ///< Uploaded, and usable by the rendering thread.
+        Failed    ///< Abandoned, because preparing or uploading it threw.
+    };
+
+    /**
+     * A resource being loaded by a ResourceLoader, which becomes usable once status() is
+     * LoadStatus::Ready. Its status only changes within ResourceLoader::update(), so it may be
+     * checked (and the resource used) freely on the rendering thread between updates.
+     */
+
+    template<typename Resource>
+    class AsyncResource {
+        friend class ResourceLoader;
+
+    public:
+
+        /**
+         * Gets the message of the exception that caused the load to fail, or an empty string if it
+         * has not failed.
+         */
+
+        const std::string& error() const {
+            return m_error;
+        }
+
+        /**
+         * Gets the resource, which must be ready.
+         */
+
+        Resource& get() {
+            assert(m_status == LoadStatus::Ready && "A resource must be loaded before it is used.");
+            return *m_resource;
+        }
+
+        /**
+         * Equivalent to <tt>status() == LoadStatus::Ready</tt>.
+         */
+
+        bool ready() const {
+            return m_status == LoadStatus::Ready;
+        }
+
+        /**
+         * Gets the progress of the load.
+         */
+
+        LoadStatus status() const {
+            return m_status;
+        }
+
+    private:
+
+        LoadStatus m_status = LoadStatus::Pending;
+        std::unique_ptr<Resource> m_resource;
+        std::string m_error;
+    };
+
+    /**
+     * The fences by which a ResourceLoader learns that an upload has been carried out. The loader
+     * uses GLUploadFences unless given another implementation, which tests use to exercise the
+     * loader without an OpenGL context.
+     */
+
+    class UploadFences {
+    public:
+
+        virtual ~UploadFences() = default;
+
+        /**
+         * Inserts a fence after the commands issued so far by the calling thread's context, and
+         * flushes them so that the fence becomes visible to other contexts. Returns @c nullptr if
+         * the fence could not be inserted. Called on the upload thread.
+         */
+
+        virtual GLsync insert() = 0;
+
+        /**
+         * Checks whether @p fence has been passed, without waiting, returning what
+         * <tt>glClientWaitSync()</tt> would. Called on the rendering thread.
+         */
+
+        virtual GLenum poll(GLsync fence) = 0;
+
+        /**
+         * Deletes @p fence. Called on the rendering thread.
+         */
+
+        virtual void remove(GLsync fence) = 0;
+    };
+
+    /**
+     * UploadFences implemented with OpenGL sync objects.
+     */
+
+    class GLUploadFences : public UploadFences {
+    public:
+
+        GLsync insert() override;
+        GLenum poll(GLsync fence) override;
+        void remove(GLsync fence) override;
+    };
+
+    /**
+     * Loads OpenGL resources without holding up the rendering thread. Each load is split in two:
+     * a preparation step (reading and decoding files, say) that runs as a job on a JobSystem, and
+     * an upload step that creates the resource and fills it with the prepared data, and that runs
+     * on a thread of the loader's own, with a SharedGLContext current. After uploading a
+     * resource, the upload thread inserts a fence; the rendering thread then hands the resource
+     * over in update() once the fence has been passed, which it checks without waiting, so that
+     * nothing the rendering thread does ever waits on a load.
+     *
+     * Resources are created by one context and used by another, so only objects that contexts
+     * share may be loaded: buffers, textures, renderbuffers, shaders and programs, but not vertex
+     * array objects or framebuffer objects, which the rendering thread must create itself around
+     * the resources it is given. The rendering thread should bind a loaded object afresh (rather
+     * than relying on an earlier binding) before using it, for its context to see the uploaded
+     * contents.
+     */
+
+    class ResourceLoader {
+    public:
+
+        /**
+         * Starts the upload thread, with @p context current on it. @p jobs runs the preparation
+         * steps, and must outlive the loader. @p fences tracks when uploads have been carried out.
+         * Throws whatever making @p context current throws.
+         */
+
+        ResourceLoader(JobSystem& jobs, std::unique_ptr<SharedGLContext> context,
+                       std::unique_ptr<UploadFences> fences = std::make_unique<GLUploadFences>());
+
+        /**
+         * Waits for preparation steps already under way to finish and for the upload thread to
+         * stop, abandoning loads that have not yet been uploaded. Must be called on the rendering
+         * thread, with its context current, since loads that have been uploaded but not handed
+         * over are destroyed there.
+         */
+
+        ~ResourceLoader();
+
+        ResourceLoader(const ResourceLoader&) = delete;
+        ResourceLoader& operator=(const ResourceLoader&) = delete;
+
+        /**
+         * Blocks until every load has been handed over (or failed), for loading screens and the
+         * like; the rendering thread should otherwise call update() each frame instead.
+         */
+
+        void finish();
+
+        /**
+         * Starts loading a resource, by calling @p prepare as a job, then passing the result to
+         * @p upload on the upload thread. @p upload returns the resource (usually a GLHandle) by
+         * value. If either throws, the load fails with the exception's message (or a generic one,
+         * if the exception is not a <tt>std::exception</tt>).
+         */
+
+        template<typename Prepare, typename Upload>
+        auto load(Prepare prepare, Upload upload) {
+
+            using Data = std::decay_t<decltype(prepare())>;
+            using Resource = std::decay_t<decltype(upload(std::declval<Data>()))>;
+
+            auto resource = std::make_shared<AsyncResource<Resource>>();
+            auto task = std::make_shared<UploadTask<Resource, Data, Upload>>(resource, std::move(upload));
+
+            ++m_pending;
+
+            m_jobs.run([this, task, prepare = std::move(prepare)]() {
+
+                try {
+                    task->data = std::make_unique<Data>(prepare());
+                }
+                catch (const std::exception& ex) {
+                    task->failed = true;
+                    task->error = ex.what();
+                }
+                catch (...) {
+                    task->failed = true;
+                    task->error = "Preparing a resource threw an exception of unknown type.";
+                }
+
+                if (task->failed) {
+                    finishUpload(task);
+                    return;
+                }
+
+                queueUpload(task);
+
+            }, m_jobCounter);
+
+            return resource;
+        }
+
+        /**
+         * Gets the number of loads that have been started but not yet handed over (or failed).
+         */
+
+        std::size_t pending() const;
+
+        /**
+         * Hands over every load whose upload has finished, without blocking, and returns how many
+         * loads finished (by being handed over or by failing). Must be called regularly (once per
+         * frame, say) on the rendering thread, with its context current.
+         */
+
+        std::size_t update();
+
+    private:
+
+        /**
+         * A load, as passed between the job that prepares it, the upload thread and the rendering
+         * thread.
+         */
+
+        class LoadTask {
+        public:
+
+            virtual ~LoadTask() = default;
+
+            virtual void complete() = 0;  ///< Hands the resource over, on the rendering thread.
+            virtual void fail() = 0;      ///< Reports @c error, on the rendering thread.
+            virtual void upload() = 0;    ///< Creates the resource, on the upload thread.
+
+            bool failed = false;
+            std::string error;
+            GLsync fence = nullptr;
+        };
+
+        template<typename Resource, typename Data, typename Upload>
+        class UploadTask : public LoadTask {
+        public:
+
+            UploadTask(std::shared_ptr<AsyncResource<Resource>> target, Upload upload)
+                : m_target{std::move(target)}, m_upload(std::move(upload)) {
+            }
+
+            void complete() override {
+                m_target->m_resource = std::move(m_resource);
+                m_target->m_status = LoadStatus::Ready;
+            }
+
+            void fail() override {
+                m_target->m_error = error;
+                m_target->m_status = LoadStatus::Failed;
+            }
+
+            void upload() override {
+                m_resource = std::make_unique<Resource>(m_upload(std::move(*data)));
+                data.reset();
+            }
+
+            std::unique_ptr<Data> data;
+
+        private:
+
+            std::shared_ptr<AsyncResource<Resource>> m_target;
+            std::unique_ptr<Resource> m_resource;
+            Upload m_upload;
+        };
+
+        void finishUpload(std::shared_ptr<LoadTask> task);
+        void queueUpload(std::shared_ptr<LoadTask> task);
+        void uploadLoop();
+
+        JobSystem& m_jobs;
+        JobCounter m_jobCounter;
+        std::unique_ptr<SharedGLContext> m_context;
+        std::unique_ptr<UploadFences> m_fences;
+
+        std::mutex m_mutex;
+        std::condition_variable m_uploadsQueued;
+        std::deque<std::shared_ptr<LoadTask>> m_uploads;
+        std::vector<std::shared_ptr<LoadTask>> m_uploaded;
+        bool m_stopping = false;
+
+        // Only touched by the rendering thread.
+
+        std::vector<std::shared_ptr<LoadTask>> m_fenced;
+        std::size_t m_pending = 0;
+
+        std::thread m_thread;
+    };
+}
+
+#endif
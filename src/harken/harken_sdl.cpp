@@ -5,6 +5,44 @@
 
 namespace Harken {
 
+    namespace {
+
+        /**
+         * A context sharing objects with an SDLWindow's. SDL needs a window to make a context
+         * current with, so the shared context is made current with the same window; it never
+         * draws to the window's framebuffer, so the two contexts do not otherwise interfere.
+         */
+
+        class SDLSharedContext : public SharedGLContext {
+        public:
+
+            SDLSharedContext(SDL_Window * const window, const SDL_GLContext context)
+                : m_window{window}, m_context{context} {
+            }
+
+            ~SDLSharedContext() override {
+                SDL_GL_DeleteContext(m_context);
+            }
+
+            void makeCurrent() override {
+                if (SDL_GL_MakeCurrent(m_window, m_context) != 0) {
+                    throw SDLException{"Could not make a shared SDL OpenGL context current."};
+                }
+            }
+
+            void releaseCurrent() override {
+                if (SDL_GL_MakeCurrent(m_window, nullptr) != 0) {
+                    throw SDLException{"Could not release a shared SDL OpenGL context."};
+                }
+            }
+
+        private:
+
+            SDL_Window * m_window;
+            SDL_GLContext m_context;
+        };
+    }
+
     SDLException::SDLException(const char * const message)
         : Exception{StringBuilder{} << message << " Error: " << SDL_GetError()} {
     }
@@ -24,16 +62,58 @@ namespace Harken {
         SDL_Quit();
     }
 
-    SDLWindow SDLManager::createFullscreenWindow(const char* title) {
-        return SDLWindow{title, 0, 0, SDL_WINDOW_FULLSCREEN_DESKTOP};
+    SDLWindow SDLManager::createFullscreenWindow(const char* title, const SwapInterval swapInterval) {
+        return SDLWindow{title, 0, 0, SDL_WINDOW_FULLSCREEN_DESKTOP, swapInterval};
     }
 
     SDLWindow SDLManager::createWindow(
         const char * const title,
         const int width,
-        const int height) {
+        const int height,
+        const SwapInterval swapInterval) {
+
+        return SDLWindow{title, width, height, 0, swapInterval};
+    }
+
+    const InputState& SDLManager::frameInput() const {
+        return m_frameInput;
+    }
+
+    InputSystem& SDLManager::input() {
+        return m_input;
+    }
 
-        return SDLWindow{title, width, height, 0};
+    bool SDLManager::pollEvents(const EventHandler& handler) {
+
+        if (!m_input.drain(handler)) {
+            m_quitRequested = true;
+        }
+
+        return !m_quitRequested;
+    }
+
+    void SDLManager::runFrameLoop(FixedTimestep& timestep,
+                                  const UpdateFunction& update,
+                                  const RenderFunction& render,
+                                  const EventHandler& handler) {
+
+        const auto frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+        auto previous = SDL_GetPerformanceCounter();
+
+        while (pollEvents(handler)) {
+
+            m_frameInput = m_input.beginFrame();
+
+            const auto now = SDL_GetPerformanceCounter();
+            const auto steps = timestep.advance(static_cast<double>(now - previous) / frequency);
+            previous = now;
+
+            for (auto i = 0; i < steps; ++i) {
+                update(timestep.step());
+            }
+
+            render(timestep.alpha());
+        }
     }
 
     void SDLManager::setOpenGLVersion(const int major, const int minor) {
@@ -41,11 +121,16 @@ namespace Harken {
         SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, minor);
     }
 
+    void SDLManager::stopFrameLoop() {
+        m_quitRequested = true;
+    }
+
     SDLWindow::SDLWindow(
         const char * const title,
         const int width,
         const int height,
-        const Uint32 flags) {
+        const Uint32 flags,
+        const SwapInterval swapInterval) {
 
         m_handle = SDL_CreateWindow(title, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, width, height, flags | SDL_WINDOW_OPENGL);
         if (!m_handle) {
@@ -61,7 +146,14 @@ namespace Harken {
             throw SDLException{"Could not create an SDL OpenGL context."};
         }
 
-        SDL_GL_SetSwapInterval(1);
+        // Some drivers, compositors and SDL backends refuse to change the swap interval, which is
+        // no reason to go without a window: failing the requested interval and then vsync, the
+        // driver's default is kept, swapInterval() reports whatever that is, and a FrameLimiter
+        // can pace frames instead.
+
+        if (SDL_GL_SetSwapInterval(static_cast<int>(swapInterval)) != 0 && swapInterval != SwapInterval::VSync) {
+            SDL_GL_SetSwapInterval(static_cast<int>(SwapInterval::VSync));
+        }
     }
 
     SDLWindow::SDLWindow(SDLWindow&& rhs)
@@ -98,6 +190,76 @@ namespace Harken {
         return sizeResult.height() ? static_cast<float>(sizeResult.width()) / static_cast<float>(sizeResult.height()) : 0.0f;
     }
 
+    std::unique_ptr<SharedGLContext> SDLWindow::createSharedContext() {
+
+        // Creating a context makes it current, so the window's context is made current again
+        // afterwards.
+
+        SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+        const auto context = SDL_GL_CreateContext(m_handle);
+        SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+
+        if (!context) {
+            throw SDLException{"Could not create a shared SDL OpenGL context."};
+        }
+
+        std::unique_ptr<SharedGLContext> sharedContext = std::make_unique<SDLSharedContext>(m_handle, context);
+        makeCurrent();
+
+        return sharedContext;
+    }
+
+    void SDLWindow::makeCurrent() {
+        if (SDL_GL_MakeCurrent(m_handle, m_glContext) != 0) {
+            throw SDLException{"Could not make an SDL OpenGL context current."};
+        }
+    }
+
+    void SDLWindow::releaseCurrent() {
+        if (SDL_GL_MakeCurrent(m_handle, nullptr) != 0) {
+            throw SDLException{"Could not release an SDL OpenGL context."};
+        }
+    }
+
+    int SDLWindow::refreshRate() const {
+
+        if (!m_handle) {
+            return 0;
+        }
+
+        const auto displayIndex = SDL_GetWindowDisplayIndex(m_handle);
+
+        SDL_DisplayMode mode;
+        if (displayIndex < 0 || SDL_GetCurrentDisplayMode(displayIndex, &mode) != 0) {
+            return 0;
+        }
+
+        return mode.refresh_rate;
+    }
+
+    SwapInterval SDLWindow::setSwapInterval(const SwapInterval interval) {
+
+        if (SDL_GL_SetSwapInterval(static_cast<int>(interval)) == 0) {
+            return interval;
+        }
+
+        if (interval == SwapInterval::Adaptive && SDL_GL_SetSwapInterval(static_cast<int>(SwapInterval::VSync)) == 0) {
+            return SwapInterval::VSync;
+        }
+
+        throw SDLException{"Could not set the swap interval of an SDL OpenGL context."};
+    }
+
+    SwapInterval SDLWindow::swapInterval() const {
+
+        const auto interval = SDL_GL_GetSwapInterval();
+        if (interval < 0) {
+            return SwapInterval::Adaptive;
+        }
+
+        return interval == 0 ? SwapInterval::Immediate : SwapInterval::VSync;
+    }
+
     void SDLWindow::swapBuffers() {
         if (m_handle) {
             SDL_GL_SwapWindow(m_handle);
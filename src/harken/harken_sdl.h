@@ -3,10 +3,15 @@
 
 #include "harken_global.h"
 #include "harken_exception.h"
+#include "harken_fixedtimestep.h"
+#include "harken_input.h"
+#include "harken_sharedglcontext.h"
 #include "harken_size.h"
 
 #include <SDL.h>
 
+#include <functional>
+#include <memory>
 #include <string>
 
 namespace Harken {
@@ -32,15 +37,52 @@ namespace Harken {
     class SDLWindow;
 
     /**
-     * Manages the initialisation and destruction of the SDL subsystem. Has no data of its own, but
-     * facilitates RAII and ensures that SDL is properly initialised before any windows are created.
-     * Only one instance of this class should be constructed per application, and its lifetime will
-     * determine the time over which the SDL subsystem is active.
+     * How buffer swaps are synchronised with the display's vertical refresh.
+     */
+
+    enum class SwapInterval {
+
+        /**
+         * Synchronise with the refresh when frames are on time, but swap immediately (tearing)
+         * when a frame misses its refresh, rather than waiting a whole further refresh. Not every
+         * driver supports this; where it is unsupported, VSync is used instead.
+         */
+
+        Adaptive = -1,
+
+        Immediate = 0,  ///< Swap without waiting for the refresh, for unlimited frame rates.
+        VSync = 1       ///< Wait for the refresh before every swap.
+    };
+
+    /**
+     * Manages the initialisation and destruction of the SDL subsystem. Facilitates RAII and ensures
+     * that SDL is properly initialised before any windows are created, and drives the application's
+     * event handling and frame loop. Only one instance of this class should be constructed per
+     * application, and its lifetime will determine the time over which the SDL subsystem is active.
      */
 
     class SDLManager {
     public:
 
+        /**
+         * Called with each event drained by pollEvents().
+         */
+
+        using EventHandler = InputSystem::EventHandler;
+
+        /**
+         * Advances the simulation by one fixed step of the given length, in seconds.
+         */
+
+        using UpdateFunction = std::function<void(double)>;
+
+        /**
+         * Renders a frame, interpolating the given fraction of a step beyond the state before the
+         * most recent update (see FixedTimestep::alpha()).
+         */
+
+        using RenderFunction = std::function<void(double)>;
+
         /**
          * Initialises the SDL subsystem and sets some default OpenGL attributes on it.
          * @param extraFlags Extra flags to pass to <tt>SDL_Init</tt>. Only @c SDL_INIT_VIDEO is
@@ -58,9 +100,13 @@ namespace Harken {
         /**
          * Creates a full-screen SDL window for OpenGL rendering.
          * @param title The title to create the window with.
+         * @param swapInterval The initial swap interval of the window (see
+         *                     SDLWindow::setSwapInterval()). If it cannot be set, vsync is
+         *                     tried instead, and failing that the driver's default is kept;
+         *                     SDLWindow::swapInterval() gets the interval in effect.
          */
 
-        SDLWindow createFullscreenWindow(const char * title);
+        SDLWindow createFullscreenWindow(const char * title, SwapInterval swapInterval = SwapInterval::VSync);
 
         /**
          * Creates a (non-full-screen) SDL window for OpenGL rendering, positioned at the center of
@@ -68,9 +114,13 @@ namespace Harken {
          * @param title The title to create the window with.
          * @param width The horizontal dimension of the window, in pixels.
          * @param height The vertical dimension of the window, in pixels.
+         * @param swapInterval The initial swap interval of the window (see
+         *                     SDLWindow::setSwapInterval()). If it cannot be set, vsync is
+         *                     tried instead, and failing that the driver's default is kept;
+         *                     SDLWindow::swapInterval() gets the interval in effect.
          */
 
-        SDLWindow createWindow(const char * title, int width, int height);
+        SDLWindow createWindow(const char * title, int width, int height, SwapInterval swapInterval = SwapInterval::VSync);
 
         /**
          * Sets OpenGL window attributes specifying the version of OpenGL to be used. A call to this
@@ -80,6 +130,56 @@ namespace Harken {
          */
 
         void setOpenGLVersion(int major, int minor);
+
+        /**
+         * Gets the snapshot of input taken at the start of the current frame of runFrameLoop().
+         * Every fixed update within a frame sees the same snapshot; renderers wanting fresher input
+         * should use input().latch() instead.
+         */
+
+        const InputState& frameInput() const;
+
+        /**
+         * Gets the input subsystem, through which the keyboard and mouse state can be sampled.
+         */
+
+        InputSystem& input();
+
+        /**
+         * Drains every pending event from the SDL event queue (see InputSystem::drain()), passing
+         * each to @p handler (if it is provided). Returns @c false if a quit has been requested
+         * (either by an @c SDL_QUIT event or by a call to stopFrameLoop()) and @c true otherwise.
+         * Must be called from the thread that initialised SDL.
+         */
+
+        bool pollEvents(const EventHandler& handler = nullptr);
+
+        /**
+         * Runs a single-threaded frame loop until a quit is requested. Each frame, pending events
+         * are first passed to @p handler and the frame's input snapshot is taken; then @p update is
+         * called for as many fixed steps as @p timestep allots for the real time elapsed since the
+         * previous frame; and finally @p render is called with the interpolation factor for the
+         * frame. The loop is not throttled other than by whatever @p render does (such as swapping
+         * buffers with vsync enabled).
+         */
+
+        void runFrameLoop(FixedTimestep& timestep,
+                          const UpdateFunction& update,
+                          const RenderFunction& render,
+                          const EventHandler& handler = nullptr);
+
+        /**
+         * Requests that the frame loop stop after the current frame, and makes subsequent calls to
+         * pollEvents() return @c false.
+         */
+
+        void stopFrameLoop();
+
+    private:
+
+        InputSystem m_input;
+        InputState m_frameInput;
+        bool m_quitRequested = false;
     };
 
     /**
@@ -123,6 +223,51 @@ namespace Harken {
         Size2<int> size() const;    /** Gets the pixel dimensions of the drawable area of the window. */
         void swapBuffers();         /** Swaps the buffers used to render to the window. */
 
+        /**
+         * Creates another OpenGL context sharing objects with the window's, for use on another
+         * thread (see SharedGLContext). The window's context must be current on the calling thread,
+         * and remains so. Throws an SDLException if the context cannot be created.
+         */
+
+        std::unique_ptr<SharedGLContext> createSharedContext();
+
+        /**
+         * Gets the refresh rate of the display the window is on, in hertz, or @c 0 if it cannot be
+         * determined.
+         */
+
+        int refreshRate() const;
+
+        /**
+         * Sets how buffer swaps are synchronised with the display's refresh, and returns the
+         * interval actually in effect: if adaptive vsync is requested but unsupported, ordinary
+         * vsync is used instead. The window's OpenGL context must be current on the calling thread.
+         * Throws an SDLException if even the fallback cannot be set.
+         */
+
+        SwapInterval setSwapInterval(SwapInterval interval);
+
+        /**
+         * Gets the swap interval in effect for the OpenGL context current on the calling thread.
+         */
+
+        SwapInterval swapInterval() const;
+
+        /**
+         * Makes the window's OpenGL context current on the calling thread, so that the thread may
+         * issue OpenGL calls. A context can only be current on one thread at a time; it must first
+         * be released by releaseCurrent() on whichever thread it was previously current on.
+         */
+
+        void makeCurrent();
+
+        /**
+         * Detaches the window's OpenGL context from the calling thread, so that it may be made
+         * current on another thread.
+         */
+
+        void releaseCurrent();
+
     private:
 
         /**
@@ -134,9 +279,11 @@ namespace Harken {
          * @param height The vertical dimension of the window, in pixels.
          * @param flags The flags to pass to SDL_CreateWindow(). Automatically includes the
          * SDL_WINDOW_OPENGL flag.
+         * @param swapInterval The swap interval to set on the new OpenGL context, falling back to
+         * vsync and then to the driver's default if it cannot be set.
          */
 
-        explicit SDLWindow(const char * title, int width, int height, Uint32 flags);
+        explicit SDLWindow(const char * title, int width, int height, Uint32 flags, SwapInterval swapInterval);
 
         SDL_GLContext m_glContext = nullptr;
         SDL_Window * m_handle = nullptr;
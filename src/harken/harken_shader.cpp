@@ -1,34 +1,18 @@
 #include "harken_exception.h"
 #include "harken_shader.h"
+#include "harken_shaderpreprocessor.h"
 #include "harken_stringbuilder.h"
 
+#include <algorithm>
 #include <cassert>
-#include <fstream>
 #include <memory>
-#include <streambuf>
 #include <string>
+#include <utility>
 
 namespace Harken {
 
     namespace {
 
-        /**
-         * Reads the contents of a file on disk into a string. Throws an IOException of the file at
-         * @p filePath could not be opened for whatever reason.
-         * @param filePath An absolute filesystem path to the file to read.
-         */
-
-        std::string readFile(const char* const filePath) {
-
-            std::ifstream inputFile{filePath};
-            if (!inputFile) {
-                throw IOException{StringBuilder{} << "Could not open file \"" << filePath << "\"."};
-            }
-
-            return std::string{std::istreambuf_iterator<char>{inputFile},
-                               std::istreambuf_iterator<char>{}};
-        }
-
         /**
          * Returns a string naming the type of shader referred to by the OpenGL enumerated code
          * @p type. @p type must be one of: @c GL_VERTEX_SHADER, @c GL_TESS_CONTROL_SHADER,
@@ -62,15 +46,64 @@ namespace Harken {
                                     << " shader from \"" << sourceFilePath << "\". " << infoLog} {
     }
 
+    std::string insertDefines(const std::string& text, const ShaderDefines& defines) {
+
+        if (defines.empty()) {
+            return text;
+        }
+
+        // The definitions go after the line holding the #version directive, if there is one.
+
+        auto insertAt = std::string::size_type{0};
+        auto nextLine = 1;
+
+        const auto version = text.find("#version");
+        if (version != std::string::npos) {
+
+            const auto lineEnd = text.find('\n', version);
+            insertAt = lineEnd == std::string::npos ? text.size() : lineEnd + 1;
+            nextLine = static_cast<int>(std::count(text.begin(), text.begin() + version, '\n')) + 2;
+        }
+
+        std::string directives;
+        if (insertAt > 0 && text[insertAt - 1] != '\n') {
+            directives += '\n';
+        }
+
+        for (const auto& define : defines) {
+            directives += StringBuilder{} << "#define " << define.first << ' ' << define.second << '\n';
+        }
+
+        directives += StringBuilder{} << "#line " << nextLine << '\n';
+
+        auto result = text;
+        result.insert(insertAt, directives);
+        return result;
+    }
+
+    ShaderSource loadShaderSource(const GLenum type, const char* const sourceFilePath, ShaderDefines defines) {
+        return ShaderPreprocessor{}.process(type, sourceFilePath, std::move(defines));
+    }
+
     Shader::Shader(const GLenum type, const char* const sourceFilePath)
-        : GLHandle<Shader>{type} {
+        : Shader{loadShaderSource(type, sourceFilePath)} {
+    }
+
+    Shader::Shader(const ShaderSource& source, const ShaderCheck check)
+        : GLHandle<Shader>{source.type}, m_type{source.type}, m_path{source.path} {
 
-        const auto source = readFile(sourceFilePath);
-        const char* const glSource[] = {source.c_str()};
+        const char* const glSource[] = {source.text.c_str()};
 
         glShaderSource(m_id, sizeof(glSource) / sizeof(char *), glSource, nullptr);
         glCompileShader(m_id);
 
+        if (check == ShaderCheck::Immediate) {
+            checkCompiled();
+        }
+    }
+
+    void Shader::checkCompiled() const {
+
         GLint success;
         glGetShaderiv(m_id, GL_COMPILE_STATUS, &success);
         if (!success) {
@@ -80,10 +113,21 @@ namespace Harken {
             const auto infoLog = std::unique_ptr<char[]>{new char[logLength]};
 
             glGetShaderInfoLog(m_id, logLength, nullptr, infoLog.get());
-            throw ShaderCompilationException{type, sourceFilePath, infoLog.get()};
+            throw ShaderCompilationException{m_type, m_path.c_str(), infoLog.get()};
         }
     }
 
+    bool Shader::completed() const {
+
+        if (!parallelShaderCompileSupported()) {
+            return true;
+        }
+
+        GLint completed;
+        glGetShaderiv(m_id, GL_COMPLETION_STATUS_KHR, &completed);
+        return completed == GL_TRUE;
+    }
+
     void Shader::create(const GLenum type) {
         m_id = glCreateShader(type);
     }
@@ -91,4 +135,8 @@ namespace Harken {
     void Shader::destroy() {
         glDeleteShader(m_id);
     }
+
+    bool parallelShaderCompileSupported() {
+        return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+    }
 }
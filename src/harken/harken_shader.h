@@ -7,6 +7,11 @@
 
 #include <GL/glew.h>
 
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace Harken {
 
     /**
@@ -36,6 +41,61 @@ namespace Harken {
                                             const char* infoLog);
     };
 
+    /**
+     * When the outcome of compiling a shader or linking a program is checked. Checking blocks
+     * until the driver has finished, so checking immediately serialises the work; deferring the
+     * check lets drivers compile many shaders in parallel (most effectively with
+     * @c GL_KHR_parallel_shader_compile) while the application gets on with other work.
+     */
+
+    enum class ShaderCheck {
+        Immediate,  ///< Check, and throw on failure, before returning.
+        Deferred    ///< Check later, when the result is first needed.
+    };
+
+    /**
+     * Preprocessor definitions with which to compile a shader, as pairs of macro names and
+     * replacement text (which may be empty).
+     */
+
+    using ShaderDefines = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * The complete source code of a shader module, as it is to be handed to the compiler, together
+     * with the type of shader it is, the name of the file it came from (for error messages), the
+     * definitions inserted into it and the hash that identifies it. ShaderSources are produced by
+     * a ShaderPreprocessor (or loadShaderSource()), which fills in every member.
+     */
+
+    struct ShaderSource {
+
+        GLenum type;                     ///< The type of shader, such as @c GL_VERTEX_SHADER.
+        std::string path;                ///< The path of the file the source was read from.
+        std::string text;                ///< The source code itself.
+        ShaderDefines defines;           ///< The definitions inserted into the text, sorted by name.
+        std::uint64_t hash;              ///< The text's content hash (see shaderContentHash()).
+        std::vector<std::string> files;  ///< The files the text was assembled from, path first.
+    };
+
+    /**
+     * Inserts a <tt>\#define</tt> directive for each of @p defines into the shader source code
+     * @p text, after its <tt>\#version</tt> directive if it has one, or at the start otherwise.
+     * A <tt>\#line</tt> directive follows the definitions, so that the line numbers in compiler
+     * messages still match the original text.
+     */
+
+    std::string insertDefines(const std::string& text, const ShaderDefines& defines);
+
+    /**
+     * Reads the source code of a shader of the specified @p type from the file at
+     * @p sourceFilePath, resolving its includes and inserting @p defines into it, with a
+     * ShaderPreprocessor that has no include directories of its own. The definitions are sorted
+     * by name first, so that the same set of definitions always gives the same text. Throws an
+     * IOException if a file could not be opened.
+     */
+
+    ShaderSource loadShaderSource(GLenum type, const char * sourceFilePath, ShaderDefines defines = {});
+
     /**
      * Provides a handle to an OpenGL shader object, and associated functionality. This is an RAII
      * class that makes the necessary OpenGL calls to create a shader object on construction and to
@@ -59,6 +119,30 @@ namespace Harken {
 
         Shader(GLenum type, const char * sourceFilePath);
 
+        /**
+         * Creates a new OpenGL shader object and compiles @p source into it. Unless @p check is
+         * ShaderCheck::Deferred, this throws a ShaderCompilationException if compilation fails;
+         * otherwise, compilation is left to proceed in the background, and its outcome is checked
+         * by checkCompiled() (which ShaderProgram calls when a deferred link fails).
+         */
+
+        explicit Shader(const ShaderSource& source, ShaderCheck check = ShaderCheck::Immediate);
+
+        /**
+         * Waits for compilation to finish, and throws a ShaderCompilationException if it failed.
+         */
+
+        void checkCompiled() const;
+
+        /**
+         * Determines, without blocking, whether the driver has finished compiling the shader
+         * (whether or not successfully). Without parallel compilation support, this is always
+         * @c true, since the driver then compiles before glCompileShader() returns or, at the
+         * latest, when the status is first queried.
+         */
+
+        bool completed() const;
+
     private:
 
         /**
@@ -74,7 +158,17 @@ namespace Harken {
          */
 
         void destroy();
+
+        GLenum m_type;
+        std::string m_path;
     };
+
+    /**
+     * Determines whether the context supports @c GL_KHR_parallel_shader_compile (or its ARB
+     * equivalent), under which the driver compiles and links on threads of its own.
+     */
+
+    bool parallelShaderCompileSupported();
 }
 
 #endif
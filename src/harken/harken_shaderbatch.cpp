@@ -0,0 +1,96 @@
+#include "harken_shaderbatch.h"
+
+#include <GL/glew.h>
+
+#include <utility>
+
+namespace Harken {
+
+    ShaderBatch::ShaderBatch(ProgramBinaryCache * const cache, ShaderLibrary * const library)
+        : m_cache{cache}, m_library{library} {
+
+        // 0xFFFFFFFF asks for as many compiler threads as the implementation sees fit to use.
+
+        if (GLEW_KHR_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        }
+        else if (GLEW_ARB_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+        }
+    }
+
+    void ShaderBatch::complete(const PendingProgram& pendingProgram) {
+
+        pendingProgram.program->checkLinked();
+
+        if (m_cache) {
+            m_cache->store(pendingProgram.key, *pendingProgram.program);
+        }
+    }
+
+    void ShaderBatch::finish() {
+
+        while (!m_pending.empty()) {
+
+            const auto pendingProgram = std::move(m_pending.front());
+            m_pending.erase(m_pending.begin());
+
+            complete(pendingProgram);
+        }
+    }
+
+    std::size_t ShaderBatch::pending() const {
+        return m_pending.size();
+    }
+
+    std::size_t ShaderBatch::poll() {
+
+        for (auto it = m_pending.begin(); it != m_pending.end();) {
+
+            if (!it->program->completed()) {
+                ++it;
+                continue;
+            }
+
+            // The program leaves the batch before it is checked, so that a failure is reported
+            // only once.
+
+            const auto pendingProgram = std::move(*it);
+            it = m_pending.erase(it);
+
+            complete(pendingProgram);
+        }
+
+        return m_pending.size();
+    }
+
+    std::shared_ptr<ShaderProgram> ShaderBatch::submit(const std::vector<ShaderSource>& sources) {
+
+        std::uint64_t key = 0;
+
+        if (m_cache) {
+
+            key = m_cache->key(sources);
+
+            auto cachedProgram = std::make_shared<ShaderProgram>();
+            if (m_cache->load(key, *cachedProgram)) {
+                return cachedProgram;
+            }
+        }
+
+        auto program = std::make_shared<ShaderProgram>();
+        for (const auto& source : sources) {
+            program->attach(m_library ? m_library->shader(source, ShaderCheck::Deferred)
+                                      : std::make_shared<Shader>(source, ShaderCheck::Deferred));
+        }
+
+        if (m_cache && m_cache->supported()) {
+            program->setBinaryRetrievable(true);
+        }
+
+        program->link(ShaderCheck::Deferred);
+        m_pending.push_back(PendingProgram{program, key});
+
+        return program;
+    }
+}
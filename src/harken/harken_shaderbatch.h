@@ -0,0 +1,89 @@
+#ifndef HARKEN_SHADERBATCH_H
+#define HARKEN_SHADERBATCH_H
+
+#include "harken_global.h"
+#include "harken_programbinarycache.h"
+#include "harken_shader.h"
+#include "harken_shaderlibrary.h"
+#include "harken_shaderprogram.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * Builds a batch of shader programs without waiting for any one of them to finish before
+     * starting the next. Every shader is compiled and every program linked with its check
+     * deferred, so the driver may work on all of them at once (on its own threads, where
+     * @c GL_KHR_parallel_shader_compile is supported, which ShaderBatch enables) while the
+     * application loads other assets; the outcome of each is only checked once the driver reports
+     * it finished, or when the program is first used.
+     *
+     * If given a ProgramBinaryCache, the batch loads cached programs instead of building them, and
+     * stores the binaries of the programs it does build as they finish. If given a ShaderLibrary,
+     * the batch gets its shaders from the library, so that programs sharing a shader compile it
+     * only once.
+     */
+
+    class ShaderBatch {
+    public:
+
+        /**
+         * Creates an empty batch, building programs for the OpenGL context current on the calling
+         * thread. The batch uses @p cache and @p library, where they are not @c nullptr, which
+         * must outlive it.
+         */
+
+        explicit ShaderBatch(ProgramBinaryCache * cache = nullptr, ShaderLibrary * library = nullptr);
+
+        ShaderBatch(const ShaderBatch&) = delete;
+        ShaderBatch& operator=(const ShaderBatch&) = delete;
+
+        /**
+         * Waits for every program in the batch to finish, checking each for errors as for poll().
+         */
+
+        void finish();
+
+        /**
+         * Gets the number of programs in the batch that have not yet been checked.
+         */
+
+        std::size_t pending() const;
+
+        /**
+         * Checks each program in the batch that the driver has finished with, without waiting for
+         * those it has not, and returns the number still pending. Throws the
+         * ShaderCompilationException or ShaderLinkException of the first program found to have
+         * failed, which is removed from the batch; calling poll() again checks the rest.
+         */
+
+        std::size_t poll();
+
+        /**
+         * Starts building a program from @p sources, and returns it without waiting for it to
+         * finish. The program can be used at once, but ShaderProgram::use() then waits for it, so
+         * it is best left until poll() or finish() has checked it.
+         */
+
+        std::shared_ptr<ShaderProgram> submit(const std::vector<ShaderSource>& sources);
+
+    private:
+
+        struct PendingProgram {
+            std::shared_ptr<ShaderProgram> program;
+            std::uint64_t key;
+        };
+
+        void complete(const PendingProgram& pendingProgram);
+
+        ProgramBinaryCache * m_cache;
+        ShaderLibrary * m_library;
+        std::vector<PendingProgram> m_pending;
+    };
+}
+
+#endif
@@ -0,0 +1,152 @@
+#include "harken_shaderlibrary.h"
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+#include <utility>
+
+namespace Harken {
+
+    bool ShaderLibrary::SourceKey::operator<(const SourceKey& rhs) const {
+        return std::tie(type, path, defines) < std::tie(rhs.type, rhs.path, rhs.defines);
+    }
+
+    ShaderLibrary::ShaderLibrary(std::vector<std::string> includeDirectories)
+        : m_preprocessor{std::move(includeDirectories)} {
+    }
+
+    void ShaderLibrary::invalidate(const std::string& path) {
+
+        m_preprocessor.invalidate(path);
+
+        for (auto it = m_sources.begin(); it != m_sources.end();) {
+
+            const auto& files = it->second->files;
+            if (std::find(files.begin(), files.end(), path) != files.end()) {
+                it = m_sources.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+    ShaderPreprocessor& ShaderLibrary::preprocessor() {
+        return m_preprocessor;
+    }
+
+    void ShaderLibrary::release() {
+        for (auto& entry : m_shaders) {
+            entry.second.shader.reset();
+        }
+    }
+
+    std::shared_ptr<Shader> ShaderLibrary::shader(const ShaderSource& source, const ShaderCheck check) {
+
+        ++m_stats.shaderRequests;
+
+        auto& entry = m_shaders[source.hash];
+
+        // A shader the library has released may still be alive, held by a program that has not
+        // yet linked, in which case it is adopted again rather than compiled a second time.
+
+        if (!entry.shader) {
+            entry.shader = entry.liveShader.lock();
+        }
+
+        if (entry.shader) {
+
+            if (check == ShaderCheck::Immediate) {
+                entry.shader->checkCompiled();
+            }
+
+            return entry.shader;
+        }
+
+        ++m_stats.shadersCompiled;
+
+        entry.shader = std::make_shared<Shader>(source, check);
+        entry.liveShader = entry.shader;
+
+        return entry.shader;
+    }
+
+    std::shared_ptr<Shader> ShaderLibrary::shader(const GLenum type,
+                                                  const std::string& path,
+                                                  ShaderDefines defines,
+                                                  const ShaderCheck check) {
+
+        return shader(source(type, path, std::move(defines)), check);
+    }
+
+    const ShaderSource& ShaderLibrary::source(const GLenum type, const std::string& path, ShaderDefines defines) {
+
+        std::sort(defines.begin(), defines.end());
+
+        SourceKey key{type, path, defines};
+
+        auto it = m_sources.find(key);
+        if (it == m_sources.end()) {
+
+            auto source = std::make_unique<ShaderSource>(m_preprocessor.process(type, path, std::move(defines)));
+            it = m_sources.emplace(std::move(key), std::move(source)).first;
+
+            ++m_stats.sourcesLoaded;
+        }
+
+        return *it->second;
+    }
+
+    std::vector<ShaderSource> ShaderLibrary::sources(const std::vector<ShaderFile>& files) {
+
+        std::vector<ShaderSource> sources;
+        sources.reserve(files.size());
+
+        for (const auto& file : files) {
+            sources.push_back(source(file.type, file.path, file.defines));
+        }
+
+        return sources;
+    }
+
+    std::size_t ShaderLibrary::size() const {
+        return static_cast<std::size_t>(std::count_if(m_shaders.begin(), m_shaders.end(), [](const auto& entry) {
+            return static_cast<bool>(entry.second.shader);
+        }));
+    }
+
+    const ShaderLibraryStats& ShaderLibrary::stats() const {
+        return m_stats;
+    }
+
+    ShaderPermutations::ShaderPermutations(ShaderLibrary& library,
+                                           const GLenum type,
+                                           std::string path,
+                                           std::vector<std::string> features,
+                                           ShaderDefines defines)
+
+        : m_library(library), m_type{type}, m_path{std::move(path)},
+          m_features{std::move(features)}, m_defines{std::move(defines)} {
+
+        assert(m_features.size() <= 32 && "A shader may have at most 32 permutation features.");
+    }
+
+    std::uint32_t ShaderPermutations::feature(const std::string& name) const {
+
+        const auto it = std::find(m_features.begin(), m_features.end(), name);
+        return it == m_features.end() ? 0 : std::uint32_t{1} << (it - m_features.begin());
+    }
+
+    std::shared_ptr<Shader> ShaderPermutations::shader(const std::uint32_t mask, const ShaderCheck check) {
+        return m_library.shader(source(mask), check);
+    }
+
+    const ShaderSource& ShaderPermutations::source(const std::uint32_t mask) {
+
+        auto defines = m_defines;
+        const auto featureDefines = permutationDefines(m_features, mask);
+        defines.insert(defines.end(), featureDefines.begin(), featureDefines.end());
+
+        return m_library.source(m_type, m_path, std::move(defines));
+    }
+}
@@ -0,0 +1,208 @@
+#ifndef HARKEN_SHADERLIBRARY_H
+#define HARKEN_SHADERLIBRARY_H
+
+#include "harken_global.h"
+#include "harken_shader.h"
+#include "harken_shaderpreprocessor.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * Counts of what a ShaderLibrary has done since it was created.
+     */
+
+    struct ShaderLibraryStats {
+
+        std::size_t sourcesLoaded = 0;    ///< Sources assembled (each once per set of definitions).
+        std::size_t shaderRequests = 0;   ///< Calls to ShaderLibrary::shader().
+        std::size_t shadersCompiled = 0;  ///< Shaders compiled because no live shader matched.
+    };
+
+    /**
+     * Identifies the source of a shader: the type of shader, the file its source is read from and
+     * the definitions inserted into it.
+     */
+
+    struct ShaderFile {
+
+        GLenum type;            ///< The type of shader, such as @c GL_VERTEX_SHADER.
+        std::string path;       ///< The path of the shader's source file.
+        ShaderDefines defines;  ///< The definitions to insert into the source.
+    };
+
+    /**
+     * Interns shaders, so that a shader used by many programs is assembled and compiled once and
+     * the resulting Shader shared between them. Sources are assembled by the library's
+     * ShaderPreprocessor, once per type, file and set of definitions; compiled shaders are
+     * interned by content hash, so that any two sources with the same text share a Shader however
+     * they were arrived at.
+     *
+     * The library holds a reference to each shader it compiles until release() is called, so that
+     * programs built one after another share shaders even though ShaderProgram::link() lets go of
+     * its shaders as soon as it has linked. Once every program that might need them has been
+     * built, release() lets the shaders be deleted as their programs finish linking, just as
+     * they would have been without the library; a shader requested again after that is compiled
+     * afresh, unless a program still waiting to link holds it.
+     */
+
+    class ShaderLibrary {
+    public:
+
+        /**
+         * @param includeDirectories The include directories of the library's preprocessor.
+         */
+
+        explicit ShaderLibrary(std::vector<std::string> includeDirectories = {});
+
+        ShaderLibrary(const ShaderLibrary&) = delete;
+        ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
+        /**
+         * Discards every source assembled from the file at @p path, or including it, and the
+         * preprocessor's cached copy of the file, so that they are assembled afresh when next
+         * requested. Shaders already compiled are unaffected.
+         */
+
+        void invalidate(const std::string& path);
+
+        /**
+         * Gets the preprocessor that assembles the library's sources.
+         */
+
+        ShaderPreprocessor& preprocessor();
+
+        /**
+         * Releases the library's references to its shaders. Sources are kept, so that requesting
+         * a shader again does not assemble its source again.
+         */
+
+        void release();
+
+        /**
+         * Gets the shader compiled from @p source, compiling it (with @p check) if the library
+         * has no live shader with the same content hash. If @p check is ShaderCheck::Immediate, a
+         * shared shader whose check was deferred is checked before it is returned.
+         */
+
+        std::shared_ptr<Shader> shader(const ShaderSource& source, ShaderCheck check = ShaderCheck::Immediate);
+
+        /**
+         * Equivalent to <tt>shader(source(type, path, defines), check)</tt>.
+         */
+
+        std::shared_ptr<Shader> shader(GLenum type,
+                                       const std::string& path,
+                                       ShaderDefines defines = {},
+                                       ShaderCheck check = ShaderCheck::Immediate);
+
+        /**
+         * Gets the source of the shader of the given @p type from the file at @p path with
+         * @p defines inserted, assembling it only if this combination has not been requested
+         * before (or has since been invalidated). The source remains valid until it is
+         * invalidated or the library is destroyed.
+         */
+
+        const ShaderSource& source(GLenum type, const std::string& path, ShaderDefines defines = {});
+
+        /**
+         * Gets the source of each of @p files in turn, as for source(). The sources are copies, so
+         * remain valid after they are invalidated.
+         */
+
+        std::vector<ShaderSource> sources(const std::vector<ShaderFile>& files);
+
+        /**
+         * Gets the number of shaders the library holds a reference to.
+         */
+
+        std::size_t size() const;
+
+        const ShaderLibraryStats& stats() const;  ///< Gets the library's statistics.
+
+    private:
+
+        struct SourceKey {
+            GLenum type;
+            std::string path;
+            ShaderDefines defines;
+
+            bool operator<(const SourceKey& rhs) const;
+        };
+
+        struct ShaderEntry {
+            std::shared_ptr<Shader> shader;
+            std::weak_ptr<Shader> liveShader;
+        };
+
+        ShaderPreprocessor m_preprocessor;
+        std::map<SourceKey, std::unique_ptr<ShaderSource>> m_sources;
+        std::unordered_map<std::uint64_t, ShaderEntry> m_shaders;
+        ShaderLibraryStats m_stats;
+    };
+
+    /**
+     * The permutations of a shader selected by a set of features, each of which a permutation
+     * either has (and defines, as for permutationDefines()) or lacks. Permutations are assembled
+     * and compiled on demand, through a ShaderLibrary, so only those actually used are built, and
+     * none more than once.
+     */
+
+    class ShaderPermutations {
+    public:
+
+        /**
+         * @param library  The library through which to assemble and compile permutations, which
+         *                 must outlive the ShaderPermutations.
+         * @param type     The type of the shader.
+         * @param path     The path of the shader's source file.
+         * @param features The names of the macros that select features, at most 32.
+         * @param defines  Definitions common to every permutation.
+         */
+
+        ShaderPermutations(ShaderLibrary& library,
+                           GLenum type,
+                           std::string path,
+                           std::vector<std::string> features,
+                           ShaderDefines defines = {});
+
+        /**
+         * Gets the bit that selects the feature named @p name, or @c 0 if there is no such
+         * feature.
+         */
+
+        std::uint32_t feature(const std::string& name) const;
+
+        /**
+         * Gets the permutation with the features whose bits are set in @p mask, compiling it with
+         * @p check if need be.
+         */
+
+        std::shared_ptr<Shader> shader(std::uint32_t mask, ShaderCheck check = ShaderCheck::Immediate);
+
+        /**
+         * Gets the source of the permutation with the features whose bits are set in @p mask.
+         */
+
+        const ShaderSource& source(std::uint32_t mask);
+
+    private:
+
+        ShaderLibrary& m_library;
+        GLenum m_type;
+        std::string m_path;
+        std::vector<std::string> m_features;
+        ShaderDefines m_defines;
+    };
+}
+
+#endif
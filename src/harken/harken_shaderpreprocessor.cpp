@@ -0,0 +1,215 @@
+#include "harken_shaderpreprocessor.h"
+#include "harken_hash.h"
+#include "harken_path.h"
+#include "harken_stringbuilder.h"
+
+#include <algorithm>
+#include <fstream>
+#include <utility>
+
+namespace Harken {
+
+    namespace {
+
+        /**
+         * The deepest that includes may nest. Recursion through a single spelling of a path is
+         * caught directly; this catches it through different spellings (such as "a.glsl" and
+         * "./a.glsl").
+         */
+
+        constexpr std::size_t maxIncludeDepth = 32;
+
+        /**
+         * Reads the contents of a file on disk into a string. Throws an IOException if the file at
+         * @p filePath could not be opened for whatever reason.
+         */
+
+        std::string readFile(const std::string& filePath) {
+
+            std::ifstream inputFile{filePath, std::ios::binary | std::ios::ate};
+            if (!inputFile) {
+                throw IOException{StringBuilder{} << "Could not open file \"" << filePath << "\"."};
+            }
+
+            // The file is read in one go, into a string sized for it up front.
+
+            const auto size = inputFile.tellg();
+            std::string contents(size > 0 ? static_cast<std::size_t>(size) : 0, '\0');
+            inputFile.seekg(0);
+
+            if (size < 0 || !inputFile.read(&contents[0], static_cast<std::streamsize>(contents.size()))) {
+                throw IOException{StringBuilder{} << "Could not read file \"" << filePath << "\"."};
+            }
+
+            return contents;
+        }
+
+        /**
+         * Determines whether a file can be opened for reading at @p filePath.
+         */
+
+        bool fileExists(const std::string& filePath) {
+            return static_cast<bool>(std::ifstream{filePath});
+        }
+
+        /**
+         * Determines whether @p line is an <tt>\#include</tt> directive, and if so, stores the name
+         * of the file it includes in @p name. @p path names the file containing the line, for
+         * error messages.
+         */
+
+        bool parseInclude(const std::string& line, const std::string& path, std::string& name) {
+
+            const auto isSpace = [](const char c) { return c == ' ' || c == '\t'; };
+
+            auto it = std::find_if_not(line.begin(), line.end(), isSpace);
+            if (it == line.end() || *it != '#') {
+                return false;
+            }
+
+            it = std::find_if_not(it + 1, line.end(), isSpace);
+
+            const std::string directive = "include";
+            if (static_cast<std::size_t>(line.end() - it) < directive.size()
+                    || !std::equal(directive.begin(), directive.end(), it)) {
+                return false;
+            }
+
+            it = std::find_if_not(it + directive.size(), line.end(), isSpace);
+
+            const auto close = it == line.end() ? '\0' : *it == '"' ? '"' : *it == '<' ? '>' : '\0';
+            const auto end = close ? std::find(it + 1, line.end(), close) : line.end();
+
+            if (!close || end == line.end()) {
+                throw ShaderPreprocessorException{StringBuilder{} << "Malformed #include directive in \""
+                                                                  << path << "\": " << line};
+            }
+
+            name.assign(it + 1, end);
+            return true;
+        }
+    }
+
+    ShaderPreprocessorException::ShaderPreprocessorException(const std::string& message)
+        : Exception{message} {
+    }
+
+    std::uint64_t shaderContentHash(const GLenum type, const std::string& text) {
+        return Hasher{}.add(type).add(text).value();
+    }
+
+    ShaderPreprocessor::ShaderPreprocessor(std::vector<std::string> includeDirectories)
+        : m_includeDirectories(std::move(includeDirectories)) {
+    }
+
+    void ShaderPreprocessor::clear() {
+        m_files.clear();
+    }
+
+    void ShaderPreprocessor::expand(const std::string& path, Expansion& expansion) {
+
+        if (std::find(expansion.includeStack.begin(), expansion.includeStack.end(), path) != expansion.includeStack.end()
+                || expansion.includeStack.size() >= maxIncludeDepth) {
+
+            throw ShaderPreprocessorException{StringBuilder{} << "Recursive #include of \"" << path << "\" from \""
+                                                              << expansion.includeStack.back() << "\"."};
+        }
+
+        // A file included more than once keeps the source string number it was first given.
+
+        const auto fileIt = std::find(expansion.files.begin(), expansion.files.end(), path);
+        const auto fileIndex = fileIt - expansion.files.begin();
+
+        if (fileIt == expansion.files.end()) {
+            expansion.files.push_back(path);
+        }
+
+        expansion.includeStack.push_back(path);
+
+        // The file is copied, since expanding its includes may read other files into the cache.
+
+        const auto text = file(path);
+        auto lineNumber = 1;
+
+        for (std::string::size_type lineStart = 0; lineStart < text.size(); ++lineNumber) {
+
+            const auto lineEnd = std::min(text.find('\n', lineStart), text.size());
+            const auto line = text.substr(lineStart, lineEnd - lineStart);
+            lineStart = lineEnd + 1;
+
+            std::string name;
+            if (!parseInclude(line, path, name)) {
+                expansion.text += line;
+                expansion.text += '\n';
+                continue;
+            }
+
+            const auto includedPath = resolve(name, path);
+            const auto includedIt = std::find(expansion.files.begin(), expansion.files.end(), includedPath);
+
+            expansion.text += StringBuilder{} << "#line 1 " << (includedIt - expansion.files.begin()) << '\n';
+            expand(includedPath, expansion);
+            expansion.text += StringBuilder{} << "#line " << (lineNumber + 1) << ' ' << fileIndex << '\n';
+        }
+
+        expansion.includeStack.pop_back();
+    }
+
+    const std::string& ShaderPreprocessor::file(const std::string& path) {
+
+        auto it = m_files.find(path);
+        if (it == m_files.end()) {
+            it = m_files.emplace(path, readFile(path)).first;
+        }
+
+        return it->second;
+    }
+
+    void ShaderPreprocessor::invalidate(const std::string& path) {
+        m_files.erase(path);
+    }
+
+    ShaderSource ShaderPreprocessor::process(const GLenum type, const std::string& path, ShaderDefines defines) {
+
+        std::sort(defines.begin(), defines.end());
+
+        Expansion expansion;
+        expand(path, expansion);
+
+        auto text = insertDefines(expansion.text, defines);
+        const auto hash = shaderContentHash(type, text);
+
+        return ShaderSource{type, path, std::move(text), std::move(defines), hash, std::move(expansion.files)};
+    }
+
+    std::string ShaderPreprocessor::resolve(const std::string& name, const std::string& includingPath) {
+
+        const auto relativePath = directoryOf(includingPath) + name;
+        if (m_files.count(relativePath) || fileExists(relativePath)) {
+            return relativePath;
+        }
+
+        for (const auto& directory : m_includeDirectories) {
+
+            const auto path = directory.empty() || directory.back() == '/' ? directory + name : directory + '/' + name;
+            if (m_files.count(path) || fileExists(path)) {
+                return path;
+            }
+        }
+
+        throw IOException{StringBuilder{} << "Could not find \"" << name << "\", included from \""
+                                          << includingPath << "\"."};
+    }
+
+    ShaderDefines permutationDefines(const std::vector<std::string>& features, const std::uint32_t mask) {
+
+        ShaderDefines defines;
+        for (std::size_t i = 0; i < features.size() && i < 32; ++i) {
+            if (mask & (std::uint32_t{1} << i)) {
+                defines.emplace_back(features[i], "1");
+            }
+        }
+
+        return defines;
+    }
+}
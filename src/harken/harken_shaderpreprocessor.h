@@ -0,0 +1,109 @@
+#ifndef HARKEN_SHADERPREPROCESSOR_H
+#define HARKEN_SHADERPREPROCESSOR_H
+
+#include "harken_global.h"
+#include "harken_exception.h"
+#include "harken_shader.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * Exception type thrown when a shader's <tt>\#include</tt> directives cannot be resolved: when
+     * a directive is malformed, or files include each other recursively. Files that cannot be read
+     * raise an IOException instead.
+     */
+
+    class ShaderPreprocessorException : public Exception {
+    public:
+        explicit ShaderPreprocessorException(const std::string& message);
+    };
+
+    /**
+     * Computes the content hash of a shader of the specified @p type with the source code @p text,
+     * which identifies the shader for the purposes of caching and deduplication: shaders with the
+     * same hash compile to the same thing.
+     */
+
+    std::uint64_t shaderContentHash(GLenum type, const std::string& text);
+
+    /**
+     * Assembles the source code of shaders from files, resolving <tt>\#include "file"</tt>
+     * directives (which GLSL itself lacks) and inserting preprocessor definitions, and hashes the
+     * result (see shaderContentHash()).
+     *
+     * An included file is looked for relative to the directory of the file that includes it,
+     * then in each of the include directories in turn. Each file gets its own GLSL source string
+     * number (its index in ShaderSource::files), set with <tt>\#line</tt> directives, so that the
+     * file and line numbers in compiler messages identify the original line. Guarding against
+     * multiple inclusion is left to the usual <tt>\#ifndef</tt> guards.
+     *
+     * File contents are cached, so that files shared between many shaders and variants are read
+     * only once; invalidate() discards them when they change on disk.
+     */
+
+    class ShaderPreprocessor {
+    public:
+
+        /**
+         * @param includeDirectories The directories in which to look for included files that are
+         *                           not found relative to the file including them.
+         */
+
+        explicit ShaderPreprocessor(std::vector<std::string> includeDirectories = {});
+
+        /**
+         * Discards the cached contents of every file.
+         */
+
+        void clear();
+
+        /**
+         * Discards the cached contents of the file at @p path, so that it is read again when
+         * next needed.
+         */
+
+        void invalidate(const std::string& path);
+
+        /**
+         * Assembles the source code of a shader of the specified @p type from the file at
+         * @p path, with @p defines (sorted by name) inserted as for insertDefines(). Throws an
+         * IOException if a file cannot be read or a ShaderPreprocessorException if the
+         * <tt>\#include</tt> directives cannot be resolved.
+         */
+
+        ShaderSource process(GLenum type, const std::string& path, ShaderDefines defines = {});
+
+    private:
+
+        struct Expansion {
+            std::string text;
+            std::vector<std::string> files;
+            std::vector<std::string> includeStack;
+        };
+
+        void expand(const std::string& path, Expansion& expansion);
+        const std::string& file(const std::string& path);
+        std::string resolve(const std::string& name, const std::string& includingPath);
+
+        std::vector<std::string> m_includeDirectories;
+        std::map<std::string, std::string> m_files;
+    };
+
+    /**
+     * Gets the definitions that select a permutation of a shader: each of @p features whose bit
+     * (counting from the least significant bit, in order) is set in @p mask is defined as @c 1,
+     * and the rest are left undefined, so that shaders test them with <tt>\#ifdef</tt>.
+     */
+
+    ShaderDefines permutationDefines(const std::vector<std::string>& features, std::uint32_t mask);
+}
+
+#endif
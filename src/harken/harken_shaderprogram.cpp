@@ -28,6 +28,19 @@ namespace Harken {
         m_attachedShaders.push_back(std::move(shader));
     }
 
+    std::vector<char> ShaderProgram::binary(GLenum& format) const {
+
+        GLint length = 0;
+        glGetProgramiv(m_id, GL_PROGRAM_BINARY_LENGTH, &length);
+
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        if (length > 0) {
+            glGetProgramBinary(m_id, length, nullptr, &format, binary.data());
+        }
+
+        return binary;
+    }
+
     void ShaderProgram::create() {
         m_id = glCreateProgram();
     }
@@ -36,14 +49,35 @@ namespace Harken {
         glDeleteProgram(m_id);
     }
 
-    void ShaderProgram::link() {
+    bool ShaderProgram::loadBinary(const GLenum format, const void * const binary, const GLsizei length) {
 
-        glLinkProgram(m_id);
+        glProgramBinary(m_id, format, binary, length);
+        m_uniformLocations.clear();
+
+        GLint success;
+        glGetProgramiv(m_id, GL_LINK_STATUS, &success);
+        return success == GL_TRUE;
+    }
+
+    void ShaderProgram::checkLinked() {
+
+        if (!m_linkPending) {
+            return;
+        }
+
+        m_linkPending = false;
 
         GLint success;
         glGetProgramiv(m_id, GL_LINK_STATUS, &success);
         if (!success) {
 
+            // A shader whose compilation was not checked has the more useful error message, since
+            // linking merely reports that it was given a shader that did not compile.
+
+            for (const auto& shader : m_attachedShaders) {
+                shader->checkCompiled();
+            }
+
             GLint logLength;
             glGetProgramiv(m_id, GL_INFO_LOG_LENGTH, &logLength);
             const auto infoLog = std::unique_ptr<char[]>{new char[logLength]};
@@ -63,11 +97,44 @@ namespace Harken {
         m_attachedShaders.clear();
     }
 
+    bool ShaderProgram::completed() const {
+
+        if (!m_linkPending || !parallelShaderCompileSupported()) {
+            return true;
+        }
+
+        GLint completed;
+        glGetProgramiv(m_id, GL_COMPLETION_STATUS_KHR, &completed);
+        return completed == GL_TRUE;
+    }
+
+    void ShaderProgram::link(const ShaderCheck check) {
+
+        glLinkProgram(m_id);
+        m_linkPending = true;
+        m_uniformLocations.clear();
+
+        if (check == ShaderCheck::Immediate) {
+            checkLinked();
+        }
+    }
+
     GLint ShaderProgram::uniformLocation(const char * const name) const {
-        glGetUniformLocation(m_id, name);
+
+        auto it = m_uniformLocations.find(name);
+        if (it == m_uniformLocations.end()) {
+            it = m_uniformLocations.emplace(name, glGetUniformLocation(m_id, name)).first;
+        }
+
+        return it->second;
+    }
+
+    void ShaderProgram::setBinaryRetrievable(const bool retrievable) {
+        glProgramParameteri(m_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, retrievable ? GL_TRUE : GL_FALSE);
     }
 
     void ShaderProgram::use() {
+        checkLinked();
         glUseProgram(m_id);
     }
 }
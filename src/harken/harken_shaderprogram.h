@@ -9,6 +9,8 @@
 
 #include <initializer_list>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Harken {
@@ -67,26 +69,76 @@ namespace Harken {
 
         void attach(std::shared_ptr<Shader> shader);
 
+        /**
+         * Gets the program's binary representation, as produced by <tt>glGetProgramBinary()</tt>,
+         * storing its format in @p format. The program must have been linked, and should have had
+         * setBinaryRetrievable() called on it beforehand; the binary is empty if the driver keeps
+         * none.
+         */
+
+        std::vector<char> binary(GLenum& format) const;
+
+        /**
+         * Loads a binary previously obtained from binary() into the program in place of linking
+         * it, returning whether the driver accepted it. Drivers reject binaries produced by other
+         * drivers or other versions of the same driver, in which case the program is left
+         * unlinked and must be linked from source as usual.
+         */
+
+        bool loadBinary(GLenum format, const void * binary, GLsizei length);
+
+        /**
+         * Hints to the driver that the binary of the program will be retrieved after it is next
+         * linked, so that the driver keeps one that can be reused by a later run.
+         */
+
+        void setBinaryRetrievable(bool retrievable);
+
         /**
          * Gets the OpenGL index of a named uniform variable in this shader program, or <tt>-1</tt>
-         * if no such variable exists. See <tt>glGetUniformLocation()</tt>.
+         * if no such variable exists. See <tt>glGetUniformLocation()</tt>. Locations are cached,
+         * so only the first query of each name goes to OpenGL; the cache is cleared whenever the
+         * program is linked (or loaded from a binary), since locations may then change.
          * @param name A null-terminated string identifying the uniform variable to get the location
          *             of.
          */
 
         GLint uniformLocation(const char * name) const;
 
+        /**
+         * Waits for a link started by link() with ShaderCheck::Deferred to finish, then does
+         * everything that link() does after linking when checking immediately. If linking failed
+         * because one of the program's shaders failed to compile, the ShaderCompilationException
+         * for that shader is thrown rather than a ShaderLinkException. Does nothing if no deferred
+         * link is outstanding.
+         */
+
+        void checkLinked();
+
+        /**
+         * Determines, without blocking, whether a deferred link (and compilation of the shaders
+         * it depends on) has finished, so that checkLinked() would not block. Always @c true if no
+         * deferred link is outstanding or the context lacks parallel compilation support.
+         */
+
+        bool completed() const;
+
         /**
          * Links shader objects previously passed into attach() into a complete shader program, and
          * performs error checking to ensure that the program was successfully linked (throwing a
          * ShaderLinkException if not). If the link was successful, this function then detaches and
          * deletes the program's shader objects (which are no longer needed).
+         *
+         * If @p check is ShaderCheck::Deferred, the link is only started, and the error checking
+         * and detaching are left to checkLinked(), which use() calls if need be. Other queries of
+         * the program (such as uniformLocation()) must not be made before then.
          */
 
-        void link();
+        void link(ShaderCheck check = ShaderCheck::Immediate);
 
         /**
-         * Engages the shader program so that it becomes active in the OpenGL rendering pipeline.
+         * Engages the shader program so that it becomes active in the OpenGL rendering pipeline,
+         * first completing a deferred link.
          */
 
         void use();
@@ -108,6 +160,9 @@ namespace Harken {
         void destroy();
 
         std::vector<std::shared_ptr<Shader>> m_attachedShaders;
+        bool m_linkPending = false;
+
+        mutable std::unordered_map<std::string, GLint> m_uniformLocations;
     };
 }
 
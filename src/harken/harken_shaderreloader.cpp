@@ -0,0 +1,176 @@
+#include "harken_shaderreloader.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Harken {
+
+    ReloadableProgram::ReloadableProgram(std::shared_ptr<ShaderProgram> program, std::vector<ShaderFile> files)
+        : m_program{std::move(program)}, m_files{std::move(files)} {
+    }
+
+    std::uint64_t ReloadableProgram::generation() const {
+        return m_generation;
+    }
+
+    ShaderProgram& ReloadableProgram::program() {
+        return *m_program;
+    }
+
+    GLint ReloadableProgram::uniformLocation(const char * const name) const {
+        return m_program->uniformLocation(name);
+    }
+
+    void ReloadableProgram::use() {
+        m_program->use();
+    }
+
+    ShaderReloader::ShaderReloader(ShaderLibrary& library, ProgramBinaryCache * const cache)
+        : m_library(library), m_cache{cache} {
+    }
+
+    bool ShaderReloader::supported() const {
+        return m_watcher.supported();
+    }
+
+    ShaderReloadReport ShaderReloader::update() {
+
+        ShaderReloadReport report;
+
+        m_programs.erase(std::remove_if(m_programs.begin(), m_programs.end(), [](const auto& program) {
+            return program.expired();
+        }), m_programs.end());
+
+        const auto changed = m_watcher.poll();
+        for (const auto& path : changed) {
+            m_library.invalidate(path);
+        }
+
+        auto pending = false;
+        for (const auto& weakProgram : m_programs) {
+
+            const auto program = weakProgram.lock();
+
+            const auto affected = std::any_of(program->m_dependencies.begin(), program->m_dependencies.end(), [&](const auto& path) {
+                return std::find(changed.begin(), changed.end(), path) != changed.end();
+            });
+
+            // A rebuild already under way when the files change again is superseded, rather than
+            // left to finish and immediately be replaced.
+
+            if (affected) {
+                rebuild(*program, report);
+            }
+
+            if (!program->m_pendingProgram) {
+                continue;
+            }
+
+            if (!program->m_pendingProgram->completed()) {
+                pending = true;
+                continue;
+            }
+
+            auto newProgram = std::move(program->m_pendingProgram);
+
+            try {
+                newProgram->checkLinked();
+            }
+            catch (const Exception& ex) {
+                report.errors.push_back(ex.what());
+                continue;
+            }
+
+            if (m_cache) {
+                m_cache->store(program->m_pendingKey, *newProgram);
+            }
+
+            program->m_program = std::move(newProgram);
+            ++program->m_generation;
+            ++report.reloaded;
+        }
+
+        // Shaders are held by the library only while rebuilds are under way, so that programs
+        // rebuilt together (because they share a changed file) share the shaders they have in
+        // common, without keeping every shader ever compiled alive afterwards.
+
+        if (!pending && (report.started > 0 || report.reloaded > 0 || !report.errors.empty())) {
+            m_library.release();
+        }
+
+        return report;
+    }
+
+    std::shared_ptr<ReloadableProgram> ShaderReloader::watch(std::shared_ptr<ShaderProgram> program, std::vector<ShaderFile> files) {
+
+        auto reloadable = std::make_shared<ReloadableProgram>(std::move(program), std::move(files));
+        watchDependencies(*reloadable, m_library.sources(reloadable->m_files));
+
+        m_programs.push_back(reloadable);
+        return reloadable;
+    }
+
+    void ShaderReloader::rebuild(ReloadableProgram& program, ShaderReloadReport& report) {
+
+        program.m_pendingProgram.reset();
+        ++report.started;
+
+        try {
+
+            // Sources are assembled here, on the rendering thread, which only reads files (and
+            // only those that changed, the rest being cached by the library's preprocessor).
+
+            const auto sources = m_library.sources(program.m_files);
+            watchDependencies(program, sources);
+
+            auto newProgram = std::make_shared<ShaderProgram>();
+
+            if (m_cache) {
+
+                program.m_pendingKey = m_cache->key(sources);
+
+                // Reverting an edit gives back a program that was built before, which may still
+                // be in the cache.
+
+                if (m_cache->load(program.m_pendingKey, *newProgram)) {
+                    program.m_program = std::move(newProgram);
+                    ++program.m_generation;
+                    ++report.reloaded;
+                    return;
+                }
+            }
+
+            for (const auto& source : sources) {
+                newProgram->attach(m_library.shader(source, ShaderCheck::Deferred));
+            }
+
+            if (m_cache && m_cache->supported()) {
+                newProgram->setBinaryRetrievable(true);
+            }
+
+            newProgram->link(ShaderCheck::Deferred);
+            program.m_pendingProgram = std::move(newProgram);
+        }
+        catch (const Exception& ex) {
+            report.errors.push_back(ex.what());
+        }
+    }
+
+    void ShaderReloader::watchDependencies(ReloadableProgram& program, const std::vector<ShaderSource>& sources) {
+
+        // Includes may have been added or removed by the change, so the dependencies are worked
+        // out afresh each time. Watching a file twice is harmless.
+
+        program.m_dependencies.clear();
+
+        for (const auto& source : sources) {
+            for (const auto& path : source.files) {
+
+                if (std::find(program.m_dependencies.begin(), program.m_dependencies.end(), path) == program.m_dependencies.end()) {
+                    program.m_dependencies.push_back(path);
+                    m_watcher.watch(path);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#ifndef HARKEN_SHADERRELOADER_H
+#define HARKEN_SHADERRELOADER_H
+
+#include "harken_global.h"
+#include "harken_filewatcher.h"
+#include "harken_programbinarycache.h"
+#include "harken_shaderlibrary.h"
+#include "harken_shaderprogram.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * A shader program that a ShaderReloader replaces whenever the files it was built from change.
+     * Code that uses the program should go through the ReloadableProgram each frame, rather than
+     * keeping the ShaderProgram (or its uniform locations) from one frame to the next, since the
+     * program may have been replaced in between. Uniform locations are cached per program (see
+     * ShaderProgram::uniformLocation()), so looking them up by name each frame is cheap, and
+     * always consistent with the current program.
+     */
+
+    class ReloadableProgram {
+        friend class ShaderReloader;
+
+    public:
+
+        /**
+         * @param program The program as initially built.
+         * @param files   The shader files the program is built from.
+         */
+
+        ReloadableProgram(std::shared_ptr<ShaderProgram> program, std::vector<ShaderFile> files);
+
+        /**
+         * Gets the number of times the program has been replaced, so that anything derived from
+         * it can be brought up to date when this changes.
+         */
+
+        std::uint64_t generation() const;
+
+        /**
+         * Gets the current program, which remains valid until the next ShaderReloader::update().
+         */
+
+        ShaderProgram& program();
+
+        GLint uniformLocation(const char * name) const;  ///< @see ShaderProgram::uniformLocation()
+        void use();                                      ///< @see ShaderProgram::use()
+
+    private:
+
+        std::shared_ptr<ShaderProgram> m_program;
+        std::vector<ShaderFile> m_files;
+        std::vector<std::string> m_dependencies;
+        std::uint64_t m_generation = 0;
+
+        std::shared_ptr<ShaderProgram> m_pendingProgram;
+        std::uint64_t m_pendingKey = 0;
+    };
+
+    /**
+     * What a call to ShaderReloader::update() did.
+     */
+
+    struct ShaderReloadReport {
+
+        std::size_t started = 0;          ///< Rebuilds started, because a program's files changed.
+        std::size_t reloaded = 0;         ///< Programs replaced, their rebuilds having succeeded.
+        std::vector<std::string> errors;  ///< The messages of rebuilds that failed.
+    };
+
+    /**
+     * Rebuilds shader programs while the application runs, whenever any of the files they are
+     * built from (including files they include) changes on disk, so that edits to shaders can be
+     * seen without restarting.
+     *
+     * Rebuilds never hold up rendering: update(), called once per frame, only starts compiling
+     * and linking a program, with its checks deferred, and swaps the new program in at a later
+     * update once the driver reports it finished. Where the driver compiles in parallel (see
+     * ShaderBatch), the work happens on the driver's threads; elsewhere, it happens within
+     * glCompileShader() and glLinkProgram(), which is unavoidable. A rebuild that fails (because
+     * the edit contains an error, or a file was caught half-written) is reported and discarded,
+     * leaving the last good program in use, and is retried when the files next change.
+     *
+     * Since programs belong to a context and are replaced between frames, update() must be called
+     * on the rendering thread, at a point where no draws referring to the old program are queued.
+     */
+
+    class ShaderReloader {
+    public:
+
+        /**
+         * Creates a reloader that assembles sources and compiles shaders through @p library,
+         * and (if it is not @c nullptr) stores the binaries of rebuilt programs in @p cache. Both
+         * must outlive the reloader.
+         */
+
+        explicit ShaderReloader(ShaderLibrary& library, ProgramBinaryCache * cache = nullptr);
+
+        ShaderReloader(const ShaderReloader&) = delete;
+        ShaderReloader& operator=(const ShaderReloader&) = delete;
+
+        /**
+         * Determines whether changes to files can be watched for on this platform.
+         */
+
+        bool supported() const;
+
+        /**
+         * Checks for changed files and for finished rebuilds, starting and completing rebuilds
+         * respectively, and returns what was done. After rebuilds complete, the library's
+         * shaders are released (see ShaderLibrary::release()).
+         */
+
+        ShaderReloadReport update();
+
+        /**
+         * Starts watching the files that @p program was built from, which are @p files and every
+         * file they include, and returns the ReloadableProgram through which it should be used
+         * from now on. The reloader stops rebuilding the program once the ReloadableProgram is
+         * destroyed.
+         */
+
+        std::shared_ptr<ReloadableProgram> watch(std::shared_ptr<ShaderProgram> program, std::vector<ShaderFile> files);
+
+    private:
+
+        void rebuild(ReloadableProgram& program, ShaderReloadReport& report);
+        void watchDependencies(ReloadableProgram& program, const std::vector<ShaderSource>& sources);
+
+        ShaderLibrary& m_library;
+        ProgramBinaryCache * m_cache;
+        FileWatcher m_watcher;
+        std::vector<std::weak_ptr<ReloadableProgram>> m_programs;
+    };
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef HARKEN_SHAREDGLCONTEXT_H
+#define HARKEN_SHAREDGLCONTEXT_H
+
+#include "harken_global.h"
+
+namespace Harken {
+
+    /**
+     * An additional OpenGL context that shares objects with a window's context, so that another
+     * thread can create and fill buffers, textures, shaders and programs for the window's context
+     * to use. Container objects (vertex array objects and framebuffer objects) are not shared
+     * between contexts, so must still be created by the window's context.
+     *
+     * Shared contexts are created by SDLWindow::createSharedContext() and
+     * HeadlessWindow::createSharedContext(), and must not outlive the window they were created
+     * from. Like the window's own context, a shared context can be current on only one thread at a
+     * time.
+     */
+
+    class SharedGLContext {
+    public:
+
+        virtual ~SharedGLContext() = default;
+
+        virtual void makeCurrent() = 0;     ///< @see SDLWindow::makeCurrent()
+        virtual void releaseCurrent() = 0;  ///< @see SDLWindow::releaseCurrent()
+    };
+}
+
+#endif
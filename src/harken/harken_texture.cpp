@@ -0,0 +1,327 @@
+#include "harken_texture.h"
+#include "harken_stringbuilder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <ios>
+
+namespace Harken {
+
+    namespace {
+
+        /**
+         * Determines whether the context can allocate immutable texture storage.
+         */
+
+        bool immutableStorageSupported() {
+            return GLEW_VERSION_4_2 || GLEW_ARB_texture_storage;
+        }
+
+        /**
+         * Sets the filters a texture with @p levels mipmap levels is created with, on the texture
+         * bound to @p target.
+         */
+
+        void setDefaultFilter(const GLenum target, const GLsizei levels) {
+            glTexParameteri(target, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+            glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        }
+    }
+
+    TextureException::TextureException(const std::string& message)
+        : Exception{message} {
+    }
+
+    GLsizei mipLevelCount(const Size2<int> size) {
+
+        GLsizei levels = 1;
+        for (auto extent = std::max(size.width(), size.height()); extent > 1; extent /= 2) {
+            ++levels;
+        }
+
+        return levels;
+    }
+
+    Size2<int> mipLevelSize(const Size2<int> size, const GLint level) {
+        return {std::max(size.width() >> level, 1), std::max(size.height() >> level, 1)};
+    }
+
+    std::size_t pixelSize(const GLenum format, const GLenum type) {
+
+        // Packed types hold every component of a pixel in a single value.
+
+        switch (type) {
+
+            case GL_UNSIGNED_BYTE_3_3_2:
+            case GL_UNSIGNED_BYTE_2_3_3_REV:
+                return 1;
+
+            case GL_UNSIGNED_SHORT_5_6_5:
+            case GL_UNSIGNED_SHORT_5_6_5_REV:
+            case GL_UNSIGNED_SHORT_4_4_4_4:
+            case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+            case GL_UNSIGNED_SHORT_5_5_5_1:
+            case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+                return 2;
+
+            case GL_UNSIGNED_INT_8_8_8_8:
+            case GL_UNSIGNED_INT_8_8_8_8_REV:
+            case GL_UNSIGNED_INT_10_10_10_2:
+            case GL_UNSIGNED_INT_2_10_10_10_REV:
+            case GL_UNSIGNED_INT_10F_11F_11F_REV:
+            case GL_UNSIGNED_INT_5_9_9_9_REV:
+            case GL_UNSIGNED_INT_24_8:
+                return 4;
+
+            case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+                return 8;
+
+            default:
+                break;
+        }
+
+        std::size_t componentSize = 0;
+
+        switch (type) {
+
+            case GL_UNSIGNED_BYTE:
+            case GL_BYTE:
+                componentSize = 1;
+                break;
+
+            case GL_UNSIGNED_SHORT:
+            case GL_SHORT:
+            case GL_HALF_FLOAT:
+                componentSize = 2;
+                break;
+
+            case GL_UNSIGNED_INT:
+            case GL_INT:
+            case GL_FLOAT:
+                componentSize = 4;
+                break;
+
+            default:
+                throw TextureException{StringBuilder{} << "Unsupported pixel type 0x" << std::hex << type << "."};
+        }
+
+        switch (format) {
+
+            case GL_RED:
+            case GL_RED_INTEGER:
+            case GL_DEPTH_COMPONENT:
+            case GL_STENCIL_INDEX:
+                return componentSize;
+
+            case GL_RG:
+            case GL_RG_INTEGER:
+                return componentSize * 2;
+
+            case GL_RGB:
+            case GL_BGR:
+            case GL_RGB_INTEGER:
+            case GL_BGR_INTEGER:
+                return componentSize * 3;
+
+            case GL_RGBA:
+            case GL_BGRA:
+            case GL_RGBA_INTEGER:
+            case GL_BGRA_INTEGER:
+                return componentSize * 4;
+
+            default:
+                throw TextureException{StringBuilder{} << "Unsupported pixel format 0x" << std::hex << format << "."};
+        }
+    }
+
+    void transferFormat(const GLenum internalFormat, GLenum& format, GLenum& type) {
+
+        switch (internalFormat) {
+
+            case GL_DEPTH_COMPONENT16:
+            case GL_DEPTH_COMPONENT24:
+            case GL_DEPTH_COMPONENT32:
+            case GL_DEPTH_COMPONENT32F:
+                format = GL_DEPTH_COMPONENT;
+                type = GL_FLOAT;
+                break;
+
+            case GL_DEPTH24_STENCIL8:
+                format = GL_DEPTH_STENCIL;
+                type = GL_UNSIGNED_INT_24_8;
+                break;
+
+            case GL_DEPTH32F_STENCIL8:
+                format = GL_DEPTH_STENCIL;
+                type = GL_FLOAT_32_UNSIGNED_INT_24_8_REV;
+                break;
+
+            default:
+                format = GL_RGBA;
+                type = GL_UNSIGNED_BYTE;
+                break;
+        }
+    }
+
+    Texture2D::Texture2D(const GLenum internalFormat, const Size2<int> size, const GLsizei levels)
+        : m_internalFormat{internalFormat}, m_size{size}, m_levels{levels} {
+
+        assert(levels >= 1 && levels <= mipLevelCount(size) && "A texture's levels must form part of a mipmap chain.");
+
+        glBindTexture(GL_TEXTURE_2D, m_id);
+
+        if (immutableStorageSupported()) {
+            glTexStorage2D(GL_TEXTURE_2D, levels, internalFormat, size.width(), size.height());
+        }
+        else {
+
+            GLenum format;
+            GLenum type;
+            transferFormat(internalFormat, format, type);
+
+            for (GLint level = 0; level < levels; ++level) {
+                const auto levelSize = mipLevelSize(size, level);
+                glTexImage2D(GL_TEXTURE_2D, level, internalFormat, levelSize.width(), levelSize.height(), 0, format, type, nullptr);
+            }
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+        }
+
+        setDefaultFilter(GL_TEXTURE_2D, levels);
+    }
+
+    void Texture2D::bind(const GLuint unit) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, m_id);
+    }
+
+    void Texture2D::create() {
+        glGenTextures(1, &m_id);
+    }
+
+    void Texture2D::destroy() {
+        glDeleteTextures(1, &m_id);
+    }
+
+    void Texture2D::generateMipmaps() {
+        glBindTexture(GL_TEXTURE_2D, m_id);
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+
+    GLenum Texture2D::internalFormat() const {
+        return m_internalFormat;
+    }
+
+    GLsizei Texture2D::levels() const {
+        return m_levels;
+    }
+
+    void Texture2D::setData(const GLint level, const GLenum format, const GLenum type, const GLvoid * const pixels) {
+
+        const auto levelSize = mipLevelSize(m_size, level);
+
+        glBindTexture(GL_TEXTURE_2D, m_id);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, levelSize.width(), levelSize.height(), format, type, pixels);
+    }
+
+    void Texture2D::setFilter(const GLenum minFilter, const GLenum magFilter) {
+        glBindTexture(GL_TEXTURE_2D, m_id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(minFilter));
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(magFilter));
+    }
+
+    void Texture2D::setWrap(const GLenum wrap) {
+        glBindTexture(GL_TEXTURE_2D, m_id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, static_cast<GLint>(wrap));
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, static_cast<GLint>(wrap));
+    }
+
+    Size2<int> Texture2D::size() const {
+        return m_size;
+    }
+
+    TextureArray::TextureArray(const GLenum internalFormat, const Size2<int> size, const GLsizei layers, const GLsizei levels)
+        : m_internalFormat{internalFormat}, m_size{size}, m_layers{layers}, m_levels{levels} {
+
+        assert(levels >= 1 && levels <= mipLevelCount(size) && "A texture's levels must form part of a mipmap chain.");
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+
+        if (immutableStorageSupported()) {
+            glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels, internalFormat, size.width(), size.height(), layers);
+        }
+        else {
+
+            GLenum format;
+            GLenum type;
+            transferFormat(internalFormat, format, type);
+
+            for (GLint level = 0; level < levels; ++level) {
+                const auto levelSize = mipLevelSize(size, level);
+                glTexImage3D(GL_TEXTURE_2D_ARRAY, level, internalFormat, levelSize.width(), levelSize.height(), layers, 0,
+                             format, type, nullptr);
+            }
+
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+        }
+
+        setDefaultFilter(GL_TEXTURE_2D_ARRAY, levels);
+    }
+
+    void TextureArray::bind(const GLuint unit) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+    }
+
+    void TextureArray::create() {
+        glGenTextures(1, &m_id);
+    }
+
+    void TextureArray::destroy() {
+        glDeleteTextures(1, &m_id);
+    }
+
+    void TextureArray::generateMipmaps() {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+    }
+
+    GLenum TextureArray::internalFormat() const {
+        return m_internalFormat;
+    }
+
+    GLsizei TextureArray::layers() const {
+        return m_layers;
+    }
+
+    GLsizei TextureArray::levels() const {
+        return m_levels;
+    }
+
+    void TextureArray::setData(const GLint layer, const GLint level, const GLenum format, const GLenum type,
+                               const GLvoid * const pixels) {
+
+        const auto levelSize = mipLevelSize(m_size, level);
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, levelSize.width(), levelSize.height(), 1, format, type, pixels);
+    }
+
+    void TextureArray::setFilter(const GLenum minFilter, const GLenum magFilter) {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(minFilter));
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(magFilter));
+    }
+
+    void TextureArray::setWrap(const GLenum wrap) {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, m_id);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, static_cast<GLint>(wrap));
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, static_cast<GLint>(wrap));
+    }
+
+    Size2<int> TextureArray::size() const {
+        return m_size;
+    }
+}
@@ -0,0 +1,199 @@
+#ifndef HARKEN_TEXTURE_H
+#define HARKEN_TEXTURE_H
+
+#include "harken_global.h"
+#include "harken_exception.h"
+#include "harken_glhandle.h"
+#include "harken_size.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <string>
+
+namespace Harken {
+
+    /**
+     * Exception type thrown when pixels cannot be uploaded to a texture in the format given.
+     */
+
+    class TextureException : public Exception {
+    public:
+        explicit TextureException(const std::string& message);
+    };
+
+    /**
+     * Gets the number of levels in a complete mipmap chain for a texture of the given @p size,
+     * down to a single pixel.
+     */
+
+    GLsizei mipLevelCount(Size2<int> size);
+
+    /**
+     * Gets the dimensions of mipmap level @p level of a texture whose base level is @p size. Each
+     * level halves the one above, rounding down, but is never smaller than a pixel.
+     */
+
+    Size2<int> mipLevelSize(Size2<int> size, GLint level);
+
+    /**
+     * Gets the size in bytes of a single pixel in the pixel transfer @p format (such as
+     * @c GL_RGBA) with components of the given @p type (such as @c GL_UNSIGNED_BYTE), throwing a
+     * TextureException for combinations that are not supported.
+     */
+
+    std::size_t pixelSize(GLenum format, GLenum type);
+
+    /**
+     * Gets a pixel transfer format and type compatible with @p internalFormat, as
+     * <tt>glTexImage2D()</tt> requires even when no pixels are being transferred.
+     */
+
+    void transferFormat(GLenum internalFormat, GLenum& format, GLenum& type);
+
+    /**
+     * RAII class that provides a handle to a 2D texture with immutable storage: its format, size
+     * and number of mipmap levels are fixed when it is created, which lets the driver validate it
+     * once rather than at every draw. Where the context lacks immutable storage, every level is
+     * allocated up front instead, to the same effect.
+     *
+     * Pixels may be uploaded directly with setData(), which copies them before returning, or
+     * asynchronously with a TextureUploader, which suits large textures streamed in while
+     * rendering.
+     */
+
+    class Texture2D : public GLHandle<Texture2D> {
+        friend class GLHandle<Texture2D>;
+
+    public:
+
+        /**
+         * Creates a texture and allocates its storage. The texture is left bound to
+         * @c GL_TEXTURE_2D on the active texture unit.
+         * @param internalFormat The sized internal format of the texture, such as @c GL_RGBA8.
+         * @param size           The dimensions of the base level, in pixels.
+         * @param levels         The number of mipmap levels, from 1 to mipLevelCount(size).
+         */
+
+        Texture2D(GLenum internalFormat, Size2<int> size, GLsizei levels = 1);
+
+        /**
+         * Binds the texture to @c GL_TEXTURE_2D on texture unit @p unit, which becomes the active
+         * texture unit.
+         */
+
+        void bind(GLuint unit = 0);
+
+        /**
+         * Fills every level below the base level from the base level. See
+         * <tt>glGenerateMipmap()</tt>.
+         */
+
+        void generateMipmaps();
+
+        /**
+         * Binds the texture and replaces the whole of mipmap level @p level with @p pixels, which
+         * are tightly packed rows (bottom row first) in the given @p format and @p type.
+         */
+
+        void setData(GLint level, GLenum format, GLenum type, const GLvoid * pixels);
+
+        /**
+         * Binds the texture and sets its minification and magnification filters. Textures are
+         * created with trilinear filtering if they have mipmap levels, and bilinear filtering
+         * otherwise.
+         */
+
+        void setFilter(GLenum minFilter, GLenum magFilter);
+
+        /**
+         * Binds the texture and sets how coordinates outside it are wrapped, in both directions.
+         */
+
+        void setWrap(GLenum wrap);
+
+        GLenum internalFormat() const;  ///< Gets the internal format of the texture.
+        GLsizei levels() const;         ///< Gets the number of mipmap levels of the texture.
+        Size2<int> size() const;        ///< Gets the dimensions of the base level.
+
+    private:
+
+        /**
+         * Instructs OpenGL to create a texture and initialises this Texture2D as a handle to it.
+         * Called by the GLHandle base class.
+         */
+
+        void create();
+
+        /**
+         * Instructs OpenGL to delete the texture managed by this Texture2D. Called by the
+         * GLHandle base class.
+         */
+
+        void destroy();
+
+        GLenum m_internalFormat;
+        Size2<int> m_size;
+        GLsizei m_levels;
+    };
+
+    /**
+     * RAII class that provides a handle to a 2D array texture with immutable storage: a stack of
+     * layers of the same format and size, any of which a shader selects by index. Arrays let
+     * many textures be drawn with a single binding, and so with a single draw call.
+     *
+     * @see Texture2D
+     */
+
+    class TextureArray : public GLHandle<TextureArray> {
+        friend class GLHandle<TextureArray>;
+
+    public:
+
+        /**
+         * Creates an array texture and allocates its storage. The texture is left bound to
+         * @c GL_TEXTURE_2D_ARRAY on the active texture unit.
+         * @param internalFormat The sized internal format of the texture, such as @c GL_RGBA8.
+         * @param size           The dimensions of the base level of each layer, in pixels.
+         * @param layers         The number of layers.
+         * @param levels         The number of mipmap levels, from 1 to mipLevelCount(size).
+         */
+
+        TextureArray(GLenum internalFormat, Size2<int> size, GLsizei layers, GLsizei levels = 1);
+
+        /**
+         * Binds the texture to @c GL_TEXTURE_2D_ARRAY on texture unit @p unit, which becomes the
+         * active texture unit.
+         */
+
+        void bind(GLuint unit = 0);
+
+        void generateMipmaps();                              ///< @see Texture2D::generateMipmaps()
+        void setFilter(GLenum minFilter, GLenum magFilter);  ///< @see Texture2D::setFilter()
+        void setWrap(GLenum wrap);                           ///< @see Texture2D::setWrap()
+
+        /**
+         * Binds the texture and replaces the whole of mipmap level @p level of layer @p layer with
+         * @p pixels. @see Texture2D::setData()
+         */
+
+        void setData(GLint layer, GLint level, GLenum format, GLenum type, const GLvoid * pixels);
+
+        GLenum internalFormat() const;  ///< Gets the internal format of the texture.
+        GLsizei layers() const;         ///< Gets the number of layers of the texture.
+        GLsizei levels() const;         ///< Gets the number of mipmap levels of the texture.
+        Size2<int> size() const;        ///< Gets the dimensions of the base level of each layer.
+
+    private:
+
+        void create();   ///< @see Texture2D::create()
+        void destroy();  ///< @see Texture2D::destroy()
+
+        GLenum m_internalFormat;
+        Size2<int> m_size;
+        GLsizei m_layers;
+        GLsizei m_levels;
+    };
+}
+
+#endif
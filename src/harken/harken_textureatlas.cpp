@@ -0,0 +1,95 @@
+#include "harken_textureatlas.h"
+#include "harken_stringbuilder.h"
+
+#include <utility>
+#include <vector>
+
+namespace Harken {
+
+    namespace {
+
+        AtlasIndex readIndex(const AssetPack& pack, const std::string& name) {
+            const auto data = pack.read(name + ".index");
+            return readAtlasIndex(data.data(), data.size());
+        }
+
+        std::string pageName(const std::string& name, const int page) {
+            return StringBuilder{} << name << ".page" << page;
+        }
+    }
+
+    TextureAtlas::TextureAtlas(TextureUploader& uploader, const Size2<int> pageSize, const GLsizei pages, const int padding)
+        : m_uploader(uploader), m_texture{GL_RGBA8, pageSize, pages}, m_packedPages{0}, m_packer{pageSize, padding, pages} {
+
+        // Mipmaps would blend neighbouring images together at their lower levels, so the pages
+        // have none.
+
+        m_texture.setWrap(GL_CLAMP_TO_EDGE);
+    }
+
+    TextureAtlas::TextureAtlas(TextureUploader& uploader, const AssetPack& pack, const std::string& name,
+                               const GLsizei extraPages)
+
+        : TextureAtlas{uploader, readIndex(pack, name), pack, name, extraPages} {
+    }
+
+    TextureAtlas::TextureAtlas(TextureUploader& uploader, const AtlasIndex& index, const AssetPack& pack,
+                               const std::string& name, const GLsizei extraPages)
+
+        : m_uploader(uploader), m_texture{GL_RGBA8, index.pageSize, index.pageCount + extraPages},
+          m_packedPages{index.pageCount}, m_packer{index.pageSize, index.padding, extraPages},
+          m_regions{index.regions} {
+
+        m_texture.setWrap(GL_CLAMP_TO_EDGE);
+
+        for (auto page = 0; page < index.pageCount; ++page) {
+            m_uploader.upload(m_texture, page, 0, GL_RGBA, GL_UNSIGNED_BYTE, pack.read(pageName(name, page)));
+        }
+    }
+
+    TextureAtlas::~TextureAtlas() {
+        m_uploader.cancel(m_texture.id());
+    }
+
+    const AtlasRegion& TextureAtlas::add(const std::string& name, const Size2<int> size, const char * const pixels) {
+
+        if (m_regions.count(name) > 0) {
+            throw AtlasException{"The atlas already has an image named \"" + name + "\"."};
+        }
+
+        // The packer takes a page limit of zero to mean none, so an atlas with no pages to spare
+        // must be caught here.
+
+        if (m_packedPages == m_texture.layers()) {
+            throw AtlasException{"The atlas has no pages for images added at runtime."};
+        }
+
+        auto region = m_packer.insert(size);
+        region.page += m_packedPages;
+
+        const auto padding = m_packer.padding();
+        const Size2<int> paddedSize{size.width() + 2 * padding, size.height() + 2 * padding};
+
+        m_uploader.upload(m_texture, region.page, 0, region.x - padding, region.y - padding, paddedSize,
+                          GL_RGBA, GL_UNSIGNED_BYTE, padImage(pixels, size, 4, padding));
+
+        return m_regions.emplace(name, region).first->second;
+    }
+
+    const AtlasRegion * TextureAtlas::find(const std::string& name) const {
+        const auto it = m_regions.find(name);
+        return it == m_regions.end() ? nullptr : &it->second;
+    }
+
+    bool TextureAtlas::ready() const {
+        return !m_uploader.pending(m_texture.id());
+    }
+
+    std::size_t TextureAtlas::size() const {
+        return m_regions.size();
+    }
+
+    TextureArray& TextureAtlas::texture() {
+        return m_texture;
+    }
+}
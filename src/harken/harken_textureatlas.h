@@ -0,0 +1,108 @@
+#ifndef HARKEN_TEXTUREATLAS_H
+#define HARKEN_TEXTUREATLAS_H
+
+#include "harken_global.h"
+#include "harken_assetpack.h"
+#include "harken_atlaspacker.h"
+#include "harken_size.h"
+#include "harken_texture.h"
+#include "harken_textureuploader.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace Harken {
+
+    /**
+     * An array texture whose layers are atlas pages, into which images are packed as they are
+     * added, so that everything drawn with images from the atlas can share a single texture
+     * binding (and so be batched together), with each mesh's texture coordinates remapped to its
+     * image's region (see AtlasRegion::remap()) and its layer given by the region's page.
+     *
+     * An atlas may begin with pages packed offline by the pack-atlas tool, and have further images
+     * added at runtime; those are placed on pages after the packed ones, which are left as they
+     * were packed. Images are uploaded through a TextureUploader, so are drawable once ready()
+     * (or, for the images added since some point, once the uploader has finished with the atlas).
+     * Pixels are RGBA with a byte per component, bottom row first.
+     */
+
+    class TextureAtlas {
+    public:
+
+        /**
+         * Creates an empty atlas of @p pages pages of the given @p pageSize, whose images have
+         * gutters of @p padding pixels. @p uploader uploads the atlas's images, and must outlive
+         * it.
+         */
+
+        TextureAtlas(TextureUploader& uploader, Size2<int> pageSize, GLsizei pages, int padding = 1);
+
+        /**
+         * Creates an atlas from the one packed into @p pack as @p name by the pack-atlas tool,
+         * with room for @p extraPages pages more of images added at runtime. Throws an
+         * AssetPackException if the atlas is missing from the pack, or an AtlasException if its
+         * index is invalid.
+         */
+
+        TextureAtlas(TextureUploader& uploader, const AssetPack& pack, const std::string& name, GLsizei extraPages = 0);
+
+        /**
+         * Abandons any uploads to the atlas still queued.
+         */
+
+        ~TextureAtlas();
+
+        TextureAtlas(const TextureAtlas&) = delete;
+        TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+        /**
+         * Packs an image named @p name, of the given @p size, into the atlas, queues the upload
+         * of its @p pixels, and returns its region. Throws an AtlasException if the atlas already
+         * has an image named @p name, or has no room for it.
+         */
+
+        const AtlasRegion& add(const std::string& name, Size2<int> size, const char * pixels);
+
+        /**
+         * Gets the region of the image named @p name, or @c nullptr if the atlas has no such
+         * image.
+         */
+
+        const AtlasRegion * find(const std::string& name) const;
+
+        /**
+         * Determines whether every image added to the atlas has been uploaded.
+         */
+
+        bool ready() const;
+
+        /**
+         * Gets the number of images in the atlas.
+         */
+
+        std::size_t size() const;
+
+        /**
+         * Gets the array texture holding the atlas's pages.
+         */
+
+        TextureArray& texture();
+
+    private:
+
+        TextureAtlas(TextureUploader& uploader, const AtlasIndex& index, const AssetPack& pack, const std::string& name,
+                     GLsizei extraPages);
+
+        TextureUploader& m_uploader;
+        TextureArray m_texture;
+
+        int m_packedPages;
+        AtlasPacker m_packer;
+        std::map<std::string, AtlasRegion> m_regions;
+    };
+}
+
+#endif
@@ -0,0 +1,257 @@
+#include "harken_textureuploader.h"
+#include "harken_stringbuilder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace Harken {
+
+    std::size_t uploadRowSize(const Size2<int> size, const GLenum format, const GLenum type, const std::size_t pixelBytes,
+                              const std::size_t bufferSize) {
+
+        if (size.width() < 0 || size.height() < 0) {
+            throw TextureException{StringBuilder{} << "Cannot upload to a " << size.width() << "x" << size.height()
+                                                   << " region."};
+        }
+
+        const auto rowSize = static_cast<std::size_t>(size.width()) * pixelSize(format, type);
+        const auto regionSize = rowSize * static_cast<std::size_t>(size.height());
+
+        if (pixelBytes != regionSize) {
+            throw TextureException{StringBuilder{} << "Expected " << regionSize << " bytes of pixels for a "
+                                                   << size.width() << "x" << size.height()
+                                                   << " region, but got " << pixelBytes << "."};
+        }
+
+        if (rowSize > bufferSize) {
+            throw TextureException{StringBuilder{} << "A row of " << rowSize
+                                                   << " bytes does not fit in a texture upload staging buffer of "
+                                                   << bufferSize << " bytes."};
+        }
+
+        return regionSize == 0 ? 0 : rowSize;
+    }
+
+    TextureUploader::TextureUploader(const std::size_t bufferSize, const std::size_t bufferCount, const std::size_t budget)
+        : m_bufferSize{bufferSize}, m_buffers(bufferCount), m_budget{budget} {
+
+        assert(bufferSize > 0 && bufferCount > 0 && "A texture uploader needs somewhere to stage pixels.");
+
+        for (auto& buffer : m_buffers) {
+            buffer.buffer.setData(nullptr, static_cast<GLsizeiptr>(bufferSize), GL_STREAM_DRAW);
+        }
+
+        VertexBufferObject::unbind(GL_PIXEL_UNPACK_BUFFER);
+    }
+
+    TextureUploader::~TextureUploader() {
+        for (auto& buffer : m_buffers) {
+            if (buffer.fence) {
+                glDeleteSync(buffer.fence);
+            }
+        }
+    }
+
+    std::size_t TextureUploader::budget() const {
+        return m_budget;
+    }
+
+    void TextureUploader::cancel(const GLuint texture) {
+
+        // Pieces already handed over are left to the driver, which holds on to the texture until
+        // it has finished with them, however soon the texture is deleted.
+
+        m_uploads.erase(std::remove_if(m_uploads.begin(), m_uploads.end(), [&](const Upload& upload) {
+
+            if (upload.texture != texture) {
+                return false;
+            }
+
+            m_pendingBytes -= upload.pixels.size() - static_cast<std::size_t>(upload.nextRow) * upload.rowSize;
+            return true;
+
+        }), m_uploads.end());
+    }
+
+    std::size_t TextureUploader::pending() const {
+        return m_uploads.size();
+    }
+
+    bool TextureUploader::pending(const GLuint texture) const {
+        return std::any_of(m_uploads.begin(), m_uploads.end(), [&](const Upload& upload) {
+            return upload.texture == texture;
+        });
+    }
+
+    std::size_t TextureUploader::pendingBytes() const {
+        return m_pendingBytes;
+    }
+
+    void TextureUploader::setBudget(const std::size_t budget) {
+        m_budget = budget;
+    }
+
+    const TextureUploadStats& TextureUploader::stats() const {
+        return m_stats;
+    }
+
+    std::size_t TextureUploader::update() {
+
+        const auto now = std::chrono::steady_clock::now();
+        std::size_t handedOver = 0;
+
+        while (!m_uploads.empty()) {
+
+            auto& upload = m_uploads.front();
+
+            auto& buffer = m_buffers[m_nextBuffer];
+            if (buffer.fence) {
+
+                // Buffers are used in turn, so if this one is still being read, the rest are too.
+
+                const auto result = glClientWaitSync(buffer.fence, 0, 0);
+                if (result == GL_TIMEOUT_EXPIRED) {
+                    ++m_stats.stalledFrames;
+                    break;
+                }
+
+                glDeleteSync(buffer.fence);
+                buffer.fence = nullptr;
+            }
+
+            // Every update hands over at least a row, so that uploads progress whatever the budget.
+
+            auto rows = std::min(static_cast<std::size_t>(upload.size.height() - upload.nextRow), m_bufferSize / upload.rowSize);
+
+            if (m_budget > 0) {
+
+                const auto budgetRows = (m_budget - std::min(handedOver, m_budget)) / upload.rowSize;
+                if (budgetRows == 0 && handedOver > 0) {
+                    ++m_stats.budgetLimitedFrames;
+                    break;
+                }
+
+                rows = std::min(rows, std::max<std::size_t>(budgetRows, 1));
+            }
+
+            const auto size = rows * upload.rowSize;
+            const auto offset = static_cast<std::size_t>(upload.nextRow) * upload.rowSize;
+
+            // The buffer is known to be idle, so mapping it unsynchronised is safe, and spares the
+            // driver from checking; invalidating it spares the driver from preserving its contents.
+
+            buffer.buffer.bind();
+
+            const auto mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(size),
+                                                 GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+
+            if (!mapped) {
+                VertexBufferObject::unbind(GL_PIXEL_UNPACK_BUFFER);
+                throw TextureException{"Failed to map a texture upload staging buffer."};
+            }
+
+            std::memcpy(mapped, upload.pixels.data() + offset, size);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+            // With a buffer bound to GL_PIXEL_UNPACK_BUFFER, the pixel pointer is an offset into it.
+
+            glBindTexture(upload.target, upload.texture);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+            if (upload.target == GL_TEXTURE_2D_ARRAY) {
+                glTexSubImage3D(upload.target, upload.level, upload.x, upload.y + upload.nextRow, upload.layer,
+                                upload.size.width(), static_cast<GLsizei>(rows), 1, upload.format, upload.type, nullptr);
+            }
+            else {
+                glTexSubImage2D(upload.target, upload.level, upload.x, upload.y + upload.nextRow,
+                                upload.size.width(), static_cast<GLsizei>(rows), upload.format, upload.type, nullptr);
+            }
+
+            buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            m_nextBuffer = (m_nextBuffer + 1) % m_buffers.size();
+
+            handedOver += size;
+            m_pendingBytes -= size;
+            upload.nextRow += static_cast<int>(rows);
+
+            if (upload.nextRow == upload.size.height()) {
+                m_uploads.pop_front();
+                ++m_stats.levelsUploaded;
+            }
+        }
+
+        // Pixel transfers elsewhere (such as Texture2D::setData()) expect client memory.
+
+        VertexBufferObject::unbind(GL_PIXEL_UNPACK_BUFFER);
+
+        m_stats.bytesUploaded += handedOver;
+        m_stats.frameBytes = handedOver;
+
+        // The rate is measured only across updates with work to do, so that it reflects how fast
+        // uploads go rather than how often there are any, and smoothed over roughly the last
+        // sixteen such updates.
+
+        if (handedOver > 0 && m_measuring) {
+
+            const auto seconds = std::chrono::duration<double>(now - m_lastUpdate).count();
+            if (seconds > 0.0) {
+                const auto rate = static_cast<double>(handedOver) / seconds;
+                m_stats.bytesPerSecond += (rate - m_stats.bytesPerSecond) / 16.0;
+            }
+        }
+
+        m_measuring = !m_uploads.empty();
+        m_lastUpdate = now;
+
+        return handedOver;
+    }
+
+    void TextureUploader::upload(Texture2D& texture, const GLint level, const GLenum format, const GLenum type,
+                                 std::vector<char> pixels) {
+
+        upload(texture, level, 0, 0, mipLevelSize(texture.size(), level), format, type, std::move(pixels));
+    }
+
+    void TextureUploader::upload(TextureArray& texture, const GLint layer, const GLint level, const GLenum format,
+                                 const GLenum type, std::vector<char> pixels) {
+
+        upload(texture, layer, level, 0, 0, mipLevelSize(texture.size(), level), format, type, std::move(pixels));
+    }
+
+    void TextureUploader::upload(Texture2D& texture, const GLint level, const int x, const int y, const Size2<int> size,
+                                 const GLenum format, const GLenum type, std::vector<char> pixels) {
+
+        assert(level >= 0 && level < texture.levels() && "An upload must be to one of a texture's levels.");
+        assert(x >= 0 && y >= 0 && x + size.width() <= mipLevelSize(texture.size(), level).width()
+               && y + size.height() <= mipLevelSize(texture.size(), level).height() && "An upload must lie within its level.");
+
+        queue({GL_TEXTURE_2D, texture.id(), 0, level, x, y, size, format, type, std::move(pixels), 0, 0});
+    }
+
+    void TextureUploader::upload(TextureArray& texture, const GLint layer, const GLint level, const int x, const int y,
+                                 const Size2<int> size, const GLenum format, const GLenum type, std::vector<char> pixels) {
+
+        assert(layer >= 0 && layer < texture.layers() && "An upload must be to one of a texture's layers.");
+        assert(level >= 0 && level < texture.levels() && "An upload must be to one of a texture's levels.");
+        assert(x >= 0 && y >= 0 && x + size.width() <= mipLevelSize(texture.size(), level).width()
+               && y + size.height() <= mipLevelSize(texture.size(), level).height() && "An upload must lie within its level.");
+
+        queue({GL_TEXTURE_2D_ARRAY, texture.id(), layer, level, x, y, size, format, type, std::move(pixels), 0, 0});
+    }
+
+    void TextureUploader::queue(Upload upload) {
+
+        // An empty region would never be handed over, since no band of its rows has any bytes,
+        // so would hold up every upload queued after it.
+
+        upload.rowSize = uploadRowSize(upload.size, upload.format, upload.type, upload.pixels.size(), m_bufferSize);
+        if (upload.rowSize == 0) {
+            return;
+        }
+
+        m_pendingBytes += upload.pixels.size();
+        m_uploads.push_back(std::move(upload));
+    }
+}
@@ -0,0 +1,217 @@
+#ifndef HARKEN_TEXTUREUPLOADER_H
+#define HARKEN_TEXTUREUPLOADER_H
+
+#include "harken_global.h"
+#include "harken_size.h"
+#include "harken_texture.h"
+#include "harken_vertexbufferobject.h"
+
+#include <GL/glew.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * Counts and rates describing what a TextureUploader has done.
+     */
+
+    struct TextureUploadStats {
+
+        std::uint64_t bytesUploaded = 0;        ///< Bytes handed to OpenGL since the uploader was created.
+        std::uint64_t levelsUploaded = 0;       ///< Mipmap levels (of single layers) fully handed over.
+        std::size_t frameBytes = 0;             ///< Bytes handed over by the most recent update().
+        std::uint64_t budgetLimitedFrames = 0;  ///< Updates that left work queued because the budget was spent.
+        std::uint64_t stalledFrames = 0;        ///< Updates that left work queued because every buffer was in use.
+
+        /**
+         * The rate at which bytes have recently been handed over, averaged over updates that had
+         * work to do. This is the bandwidth of the whole path from the CPU to the driver, and is
+         * limited by the budget when the budget is what holds uploads back.
+         */
+
+        double bytesPerSecond = 0.0;
+    };
+
+    /**
+     * Checks that @p pixelBytes bytes of tightly packed pixels in the given @p format and @p type
+     * exactly cover a region of @p size, and that a row of the region fits in a staging buffer of
+     * @p bufferSize bytes. Returns the size of a row in bytes, or @c 0 if the region is empty and
+     * there is nothing to upload. Throws a TextureException if any check fails.
+     */
+
+    std::size_t uploadRowSize(Size2<int> size, GLenum format, GLenum type, std::size_t pixelBytes, std::size_t bufferSize);
+
+    /**
+     * Uploads pixels to textures asynchronously, by staging them through a ring of pixel buffer
+     * objects. Each piece of an upload is copied into a staging buffer, and
+     * <tt>glTexSubImage2D()</tt> (or <tt>glTexSubImage3D()</tt>) then sources it from that buffer
+     * rather than from client memory; that call returns immediately, leaving the driver to
+     * transfer the pixels while rendering continues, where uploading from client memory would
+     * copy (or even wait) before returning.
+     *
+     * Each staging buffer is fenced once used, and reused only once the fence has passed, so that
+     * the CPU never writes to pixels the GPU has yet to read, and never waits for it to read them:
+     * if no buffer is free, the remaining uploads simply wait for the next update(). A mipmap level
+     * larger than a staging buffer is uploaded a band of rows at a time, across several buffers.
+     *
+     * The uploader hands over at most a budget of bytes per update(), so that streaming textures
+     * in costs each frame a bounded amount of time. A context must be current whenever the
+     * uploader is used or destroyed.
+     */
+
+    class TextureUploader {
+    public:
+
+        /**
+         * @param bufferSize  The size of each staging buffer, in bytes, which must be at least the
+         *                    size of a row of any level uploaded.
+         * @param bufferCount The number of staging buffers, which should allow for every buffer
+         *                    used in a frame to still be in use by the GPU for a few frames more
+         *                    (see FrameSync).
+         * @param budget      The most bytes handed over per update(), or @c 0 for no limit.
+         */
+
+        explicit TextureUploader(std::size_t bufferSize = 4 << 20, std::size_t bufferCount = 4, std::size_t budget = 8 << 20);
+
+        /**
+         * Deletes the staging buffers and their fences, abandoning any uploads still queued.
+         */
+
+        ~TextureUploader();
+
+        TextureUploader(const TextureUploader&) = delete;
+        TextureUploader& operator=(const TextureUploader&) = delete;
+
+        /**
+         * Gets the most bytes handed over per update(), or @c 0 if there is no limit.
+         */
+
+        std::size_t budget() const;
+
+        /**
+         * Abandons the queued uploads to the texture named @p texture, which must be done before a
+         * texture with uploads queued is destroyed.
+         */
+
+        void cancel(GLuint texture);
+
+        /**
+         * Gets the number of mipmap levels with uploads queued.
+         */
+
+        std::size_t pending() const;
+
+        /**
+         * Determines whether any uploads to the texture named @p texture are queued. Once none
+         * are, the texture may be drawn with: OpenGL orders the draw after the uploads, however far
+         * the transfers have actually got.
+         */
+
+        bool pending(GLuint texture) const;
+
+        /**
+         * Gets the number of bytes of queued uploads yet to be handed over.
+         */
+
+        std::size_t pendingBytes() const;
+
+        /**
+         * Sets the most bytes handed over per update(), or @c 0 for no limit. Whatever the budget,
+         * each update with uploads queued hands over at least a row, so that uploads always make
+         * progress.
+         */
+
+        void setBudget(std::size_t budget);
+
+        /**
+         * Gets the uploader's statistics.
+         */
+
+        const TextureUploadStats& stats() const;
+
+        /**
+         * Hands over queued uploads, in the order they were queued, until the budget is spent or no
+         * staging buffer is free, and returns the number of bytes handed over. Call once per
+         * frame.
+         */
+
+        std::size_t update();
+
+        /**
+         * Queues the upload of @p pixels to the whole of mipmap level @p level of @p texture. The
+         * pixels are tightly packed rows, bottom row first, in the given @p format and @p type.
+         * Throws a TextureException if there are not exactly enough pixels for the level, or a
+         * row of the level does not fit in a staging buffer (see uploadRowSize()).
+         */
+
+        void upload(Texture2D& texture, GLint level, GLenum format, GLenum type, std::vector<char> pixels);
+
+        /**
+         * Queues the upload of @p pixels to the whole of mipmap level @p level of layer @p layer of
+         * @p texture. @see upload(Texture2D&, GLint, GLenum, GLenum, std::vector<char>)
+         */
+
+        void upload(TextureArray& texture, GLint layer, GLint level, GLenum format, GLenum type, std::vector<char> pixels);
+
+        /**
+         * Queues the upload of @p pixels to the rectangle of mipmap level @p level of @p texture
+         * whose bottom-left corner is at (@p x, @p y) and whose size is @p size, which must lie
+         * within the level. An empty region is ignored.
+         * @see upload(Texture2D&, GLint, GLenum, GLenum, std::vector<char>)
+         */
+
+        void upload(Texture2D& texture, GLint level, int x, int y, Size2<int> size, GLenum format, GLenum type,
+                    std::vector<char> pixels);
+
+        /**
+         * Queues the upload of @p pixels to a rectangle of mipmap level @p level of layer @p layer
+         * of @p texture. @see upload(Texture2D&, GLint, int, int, Size2<int>, GLenum, GLenum, std::vector<char>)
+         */
+
+        void upload(TextureArray& texture, GLint layer, GLint level, int x, int y, Size2<int> size, GLenum format,
+                    GLenum type, std::vector<char> pixels);
+
+    private:
+
+        struct Upload {
+            GLenum target;
+            GLuint texture;
+            GLint layer;
+            GLint level;
+            int x;
+            int y;
+            Size2<int> size;
+            GLenum format;
+            GLenum type;
+            std::vector<char> pixels;
+            std::size_t rowSize;
+            int nextRow;
+        };
+
+        struct StagingBuffer {
+            VertexBufferObject buffer{GL_PIXEL_UNPACK_BUFFER};
+            GLsync fence = nullptr;
+        };
+
+        void queue(Upload upload);
+
+        std::size_t m_bufferSize;
+        std::vector<StagingBuffer> m_buffers;
+        std::size_t m_nextBuffer = 0;
+        std::size_t m_budget;
+
+        std::deque<Upload> m_uploads;
+        std::size_t m_pendingBytes = 0;
+
+        TextureUploadStats m_stats;
+        std::chrono::steady_clock::time_point m_lastUpdate;
+        bool m_measuring = false;
+    };
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef HARKEN_TRIPLEBUFFER_H
+#define HARKEN_TRIPLEBUFFER_H
+
+#include "harken_global.h"
+
+#include <array>
+#include <atomic>
+
+namespace Harken {
+
+    /**
+     * A lock-free, wait-free channel through which a single producer thread publishes successive
+     * values of @c T to a single consumer thread, which always observes the newest complete value.
+     * Three copies of @c T are held: the producer writes into the back buffer while the consumer
+     * reads from the front buffer, and the two exchange buffers only through the middle one by
+     * means of a single atomic swap. Neither thread ever waits for the other, and the consumer can
+     * never observe a partially written value.
+     *
+     * The producer may publish faster than the consumer consumes, in which case intermediate
+     * values are simply skipped; and the consumer may consume faster than the producer
+     * publishes, in which case it keeps observing the same value.
+     */
+
+    template<typename T>
+    class TripleBuffer {
+    public:
+
+        TripleBuffer() = default;
+
+        /**
+         * Initialises all three buffers to @p initial, so that the consumer observes @p initial
+         * until the producer's first publish().
+         */
+
+        explicit TripleBuffer(const T& initial)
+            : m_buffers{{initial, initial, initial}} {
+        }
+
+        TripleBuffer(const TripleBuffer<T>&) = delete;
+        TripleBuffer<T>& operator=(const TripleBuffer<T>&) = delete;
+
+        /**
+         * Gets the buffer into which the producer should write the next value to publish. May only
+         * be called from the producer thread.
+         */
+
+        T& back() {
+            return m_buffers[m_back];
+        }
+
+        /**
+         * Makes the contents of back() available to the consumer, and gives the producer a new
+         * back buffer (whose contents are stale). May only be called from the producer thread.
+         */
+
+        void publish() {
+            const auto previous = m_middle.exchange(m_back | DirtyFlag, std::memory_order_acq_rel);
+            m_back = previous & IndexMask;
+        }
+
+        /**
+         * Gets the most recent value acquired by update(). May only be called from the consumer
+         * thread.
+         */
+
+        const T& front() const {
+            return m_buffers[m_front];
+        }
+
+        /**
+         * Makes the most recently published value available through front(), if anything has
+         * been published since the last update. Returns @c true if front() has changed. May only
+         * be called from the consumer thread.
+         */
+
+        bool update() {
+
+            if (!(m_middle.load(std::memory_order_relaxed) & DirtyFlag)) {
+                return false;
+            }
+
+            const auto previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+            m_front = previous & IndexMask;
+            return true;
+        }
+
+    private:
+
+        // The middle index is packed together with a flag recording whether it holds a value that
+        // the consumer has not yet seen, so that both can be exchanged in one atomic operation.
+
+        static constexpr int IndexMask = 0x3;
+        static constexpr int DirtyFlag = 0x4;
+
+        std::array<T, 3> m_buffers{};
+
+        int m_back = 0;
+        std::atomic<int> m_middle{1};
+        int m_front = 2;
+    };
+}
+
+#endif
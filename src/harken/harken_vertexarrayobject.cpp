@@ -1,5 +1,9 @@
 #include "harken_vertexarrayobject.h"
 
+#include <cstdint>
+#include <functional>
+#include <utility>
+
 namespace Harken {
 
     void VertexArrayObject::bind() {
@@ -14,7 +18,60 @@ namespace Harken {
         glDeleteVertexArrays(1, &m_id);
     }
 
+    void VertexArrayObject::setFormat(VertexBufferObject& buffer,
+                                      const VertexFormat& format,
+                                      const GLuint firstLocation,
+                                      const GLuint divisor) {
+        bind();
+        buffer.bind();
+
+        auto location = firstLocation;
+        for (const auto& attribute : format.attributes()) {
+
+            const auto offset = reinterpret_cast<const GLvoid *>(static_cast<std::uintptr_t>(attribute.offset));
+            glVertexAttribPointer(location, attribute.componentCount, attribute.type,
+                                  attribute.normalised, format.stride(), offset);
+            glVertexAttribDivisor(location, divisor);
+            glEnableVertexAttribArray(location);
+
+            ++location;
+        }
+    }
+
     void VertexArrayObject::unbind() {
         glBindVertexArray(0);
     }
+
+    VertexArrayObject& VertexArrayCache::get(VertexBufferObject& buffer, const VertexFormat& format) {
+
+        Key key{buffer.id(), format};
+
+        const auto existing = m_vertexArrays.find(key);
+        if (existing != m_vertexArrays.end()) {
+            return *existing->second;
+        }
+
+        auto vertexArray = std::make_unique<VertexArrayObject>();
+        vertexArray->setFormat(buffer, format);
+
+        auto& result = *vertexArray;
+        m_vertexArrays.emplace(std::move(key), std::move(vertexArray));
+        return result;
+    }
+
+    void VertexArrayCache::clear() {
+        m_vertexArrays.clear();
+    }
+
+    std::size_t VertexArrayCache::size() const {
+        return m_vertexArrays.size();
+    }
+
+    bool VertexArrayCache::KeyEqual::operator()(const Key& lhs, const Key& rhs) const {
+        return lhs.bufferId == rhs.bufferId && lhs.format == rhs.format;
+    }
+
+    std::size_t VertexArrayCache::KeyHash::operator()(const Key& key) const {
+        return key.format.hash() ^ (std::hash<GLuint>{}(key.bufferId) << 1);
+    }
 }
@@ -3,9 +3,15 @@
 
 #include "harken_global.h"
 #include "harken_glhandle.h"
+#include "harken_vertexbufferobject.h"
+#include "harken_vertexlayout.h"
 
 #include <GL/glew.h>
 
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
 namespace Harken {
 
     /**
@@ -26,6 +32,21 @@ namespace Harken {
 
         void bind();
 
+        /**
+         * Binds this vertex array object and @p buffer, then describes to OpenGL how the vertex
+         * data in @p buffer are laid out according to @p format. The attributes of @p format are
+         * assigned consecutive attribute locations starting from @p firstLocation, and each of
+         * these locations is enabled. The vertex array object is left bound.
+         * @param divisor The number of instances drawn before each attribute advances to the next
+         *                element of @p buffer (see <tt>glVertexAttribDivisor()</tt>). The default
+         *                of @c 0 advances once per vertex; @c 1 advances once per instance.
+         */
+
+        void setFormat(VertexBufferObject& buffer,
+                       const VertexFormat& format,
+                       GLuint firstLocation = 0,
+                       GLuint divisor = 0);
+
         /**
          * Instructs OpenGL to stop using any user-created vertex array objects and to return to the
          * default state for vertex arrays.
@@ -49,6 +70,60 @@ namespace Harken {
 
         void destroy();
     };
+
+    /**
+     * Owns a collection of vertex array objects, each configured for a particular combination of
+     * vertex buffer and VertexFormat, so that meshes sharing both a buffer and a layout also share
+     * a single vertex array object. This means that drawing such meshes one after another requires
+     * no vertex array state to be changed at all, and that the (relatively expensive) attribute
+     * setup is only ever performed once per combination.
+     *
+     * The cache does not track the lifetimes of the buffers it refers to; entries for a buffer
+     * must be discarded by calling clear() before that buffer is destroyed.
+     */
+
+    class VertexArrayCache {
+    public:
+
+        /**
+         * Gets the vertex array object describing @p buffer as containing vertices laid out
+         * according to @p format, creating and configuring it via VertexArrayObject::setFormat()
+         * if no such vertex array object has yet been requested. The returned reference remains
+         * valid until clear() is called or the cache is destroyed. The returned vertex array
+         * object is not necessarily bound.
+         */
+
+        VertexArrayObject& get(VertexBufferObject& buffer, const VertexFormat& format);
+
+        /**
+         * Destroys every vertex array object owned by the cache.
+         */
+
+        void clear();
+
+        /**
+         * Gets the number of distinct vertex array objects currently owned by the cache.
+         */
+
+        std::size_t size() const;
+
+    private:
+
+        struct Key {
+            GLuint bufferId;
+            VertexFormat format;
+        };
+
+        struct KeyEqual {
+            bool operator()(const Key& lhs, const Key& rhs) const;
+        };
+
+        struct KeyHash {
+            std::size_t operator()(const Key& key) const;
+        };
+
+        std::unordered_map<Key, std::unique_ptr<VertexArrayObject>, KeyHash, KeyEqual> m_vertexArrays;
+    };
 }
 
 #endif
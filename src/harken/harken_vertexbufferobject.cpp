@@ -1,5 +1,9 @@
 #include "harken_vertexbufferobject.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
 namespace Harken {
 
     VertexBufferObject::VertexBufferObject(const GLenum type)
@@ -18,7 +22,65 @@ namespace Harken {
         glDeleteBuffers(1, &m_id);
     }
 
+    void VertexBufferObject::setData(const GLvoid * const data,
+                                     const GLsizeiptr size,
+                                     const GLenum usage) {
+        bind();
+        glBufferData(m_type, size, data, usage);
+    }
+
+    GLenum VertexBufferObject::type() const {
+        return m_type;
+    }
+
     void VertexBufferObject::unbind(const GLenum type) {
         glBindBuffer(type, 0);
     }
+
+    ElementBufferObject::ElementBufferObject()
+        : VertexBufferObject{GL_ELEMENT_ARRAY_BUFFER} {
+    }
+
+    void ElementBufferObject::draw(const GLenum mode, const GLsizei first, const GLsizei count) const {
+
+        const auto offset = static_cast<std::uintptr_t>(first) * indexSize();
+        glDrawElements(mode, count, m_indexType, reinterpret_cast<const GLvoid *>(offset));
+    }
+
+    void ElementBufferObject::draw(const GLenum mode) const {
+        draw(mode, 0, m_indexCount);
+    }
+
+    void ElementBufferObject::drawInstanced(const GLsizei instanceCount, const GLenum mode) const {
+        glDrawElementsInstanced(mode, m_indexCount, m_indexType, nullptr, instanceCount);
+    }
+
+    GLsizei ElementBufferObject::indexCount() const {
+        return m_indexCount;
+    }
+
+    GLsizei ElementBufferObject::indexSize() const {
+        return m_indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+    }
+
+    GLenum ElementBufferObject::indexType() const {
+        return m_indexType;
+    }
+
+    void ElementBufferObject::setIndices(const std::vector<GLuint>& indices, const GLenum usage) {
+
+        m_indexCount = static_cast<GLsizei>(indices.size());
+
+        const auto maxIndex = std::max_element(indices.begin(), indices.end());
+        if (maxIndex == indices.end() || *maxIndex <= std::numeric_limits<GLushort>::max()) {
+
+            m_indexType = GL_UNSIGNED_SHORT;
+            setData(std::vector<GLushort>(indices.begin(), indices.end()), usage);
+        }
+        else {
+
+            m_indexType = GL_UNSIGNED_INT;
+            setData(indices, usage);
+        }
+    }
 }
@@ -5,6 +5,7 @@
 #include "harken_glhandle.h"
 #include "harken_vector.h"
 
+#include <cstddef>
 #include <initializer_list>
 #include <vector>
 
@@ -28,6 +29,32 @@ namespace Harken {
 
         void bind();
 
+        /**
+         * Binds the buffer and replaces its entire contents with @p size bytes copied from
+         * @p data (which may be null to allocate uninitialised storage). See
+         * <tt>glBufferData()</tt>.
+         * @param usage A hint to OpenGL of how the data will be accessed, such as
+         *              @c GL_STATIC_DRAW or @c GL_DYNAMIC_DRAW.
+         */
+
+        void setData(const GLvoid * data, GLsizeiptr size, GLenum usage = GL_STATIC_DRAW);
+
+        /**
+         * @see setData(const GLvoid *, GLsizeiptr, GLenum)
+         */
+
+        template<typename T>
+        void setData(const std::vector<T>& data, const GLenum usage = GL_STATIC_DRAW) {
+            setData(data.data(), static_cast<GLsizeiptr>(data.size() * sizeof(T)), usage);
+        }
+
+        /**
+         * Gets the OpenGL enumerated code for the binding point that this buffer was created for,
+         * such as @c GL_ARRAY_BUFFER.
+         */
+
+        GLenum type() const;
+
         /**
          * Instructs OpenGL to stop using vertex buffer objects of the specified type.
          */
@@ -52,6 +79,77 @@ namespace Harken {
 
         const GLenum m_type;
     };
+
+    /**
+     * A VertexBufferObject bound to @c GL_ELEMENT_ARRAY_BUFFER that holds the indices of an
+     * indexed mesh and draws that mesh with <tt>glDrawElements()</tt>. When indices are uploaded,
+     * the narrowest index type able to represent every index (@c GL_UNSIGNED_SHORT or
+     * @c GL_UNSIGNED_INT) is selected automatically, halving the memory and bandwidth used by the
+     * indices of meshes with fewer than 65536 vertices.
+     *
+     * Since the element array buffer binding is part of vertex array object state, the relevant
+     * VertexArrayObject should be bound before setIndices() or bind() is called.
+     */
+
+    class ElementBufferObject : public VertexBufferObject {
+    public:
+
+        ElementBufferObject();
+
+        /**
+         * Draws @p count indices starting from index @p first, using the currently bound vertex
+         * array object and shader program. See <tt>glDrawElements()</tt>.
+         * @param mode The kind of primitives to assemble from the indices, such as
+         *             @c GL_TRIANGLES.
+         */
+
+        void draw(GLenum mode, GLsizei first, GLsizei count) const;
+
+        /**
+         * Draws every index held by the buffer. Equivalent to
+         * <tt>draw(mode, 0, indexCount())</tt>.
+         */
+
+        void draw(GLenum mode = GL_TRIANGLES) const;
+
+        /**
+         * Draws every index held by the buffer @p instanceCount times in a single call. See
+         * <tt>glDrawElementsInstanced()</tt>.
+         */
+
+        void drawInstanced(GLsizei instanceCount, GLenum mode = GL_TRIANGLES) const;
+
+        /**
+         * Gets the number of indices last uploaded by setIndices().
+         */
+
+        GLsizei indexCount() const;
+
+        /**
+         * Gets the size, in bytes, of each index held by the buffer.
+         */
+
+        GLsizei indexSize() const;
+
+        /**
+         * Gets the OpenGL enumerated code for the type of each index held by the buffer: either
+         * @c GL_UNSIGNED_SHORT or @c GL_UNSIGNED_INT.
+         */
+
+        GLenum indexType() const;
+
+        /**
+         * Binds the buffer and replaces its contents with @p indices, converting them to 16-bit
+         * indices first if none of them exceeds 65535.
+         */
+
+        void setIndices(const std::vector<GLuint>& indices, GLenum usage = GL_STATIC_DRAW);
+
+    private:
+
+        GLsizei m_indexCount = 0;
+        GLenum m_indexType = GL_UNSIGNED_INT;
+    };
 }
 
 #endif
@@ -0,0 +1,66 @@
+#include "harken_vertexlayout.h"
+
+#include <functional>
+#include <utility>
+
+namespace Harken {
+
+    namespace {
+
+        /**
+         * Mixes the hash of @p value into @p seed, in the manner of <tt>boost::hash_combine()</tt>.
+         */
+
+        template<typename T>
+        void hashCombine(std::size_t& seed, const T& value) {
+            seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+    }
+
+    bool operator==(const VertexAttributeFormat& lhs, const VertexAttributeFormat& rhs) {
+
+        return lhs.componentCount == rhs.componentCount
+            && lhs.type == rhs.type
+            && lhs.normalised == rhs.normalised
+            && lhs.offset == rhs.offset;
+    }
+
+    bool operator!=(const VertexAttributeFormat& lhs, const VertexAttributeFormat& rhs) {
+        return !(lhs == rhs);
+    }
+
+    VertexFormat::VertexFormat(std::vector<VertexAttributeFormat> attributes, const GLsizei stride)
+        : m_attributes{std::move(attributes)}, m_stride{stride} {
+    }
+
+    const std::vector<VertexAttributeFormat>& VertexFormat::attributes() const {
+        return m_attributes;
+    }
+
+    std::size_t VertexFormat::hash() const {
+
+        auto seed = std::size_t{0};
+        hashCombine(seed, m_stride);
+
+        for (const auto& attribute : m_attributes) {
+            hashCombine(seed, attribute.componentCount);
+            hashCombine(seed, attribute.type);
+            hashCombine(seed, attribute.normalised);
+            hashCombine(seed, attribute.offset);
+        }
+
+        return seed;
+    }
+
+    GLsizei VertexFormat::stride() const {
+        return m_stride;
+    }
+
+    bool operator==(const VertexFormat& lhs, const VertexFormat& rhs) {
+        return lhs.stride() == rhs.stride() && lhs.attributes() == rhs.attributes();
+    }
+
+    bool operator!=(const VertexFormat& lhs, const VertexFormat& rhs) {
+        return !(lhs == rhs);
+    }
+}
@@ -0,0 +1,186 @@
+#ifndef HARKEN_VERTEXLAYOUT_H
+#define HARKEN_VERTEXLAYOUT_H
+
+#include "harken_global.h"
+#include "harken_vector.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * Maps an arithmetic C++ type onto the OpenGL enumerated code describing vertex attribute data
+     * of that type (so that, for example, <tt>GLType<GLfloat>::value</tt> is @c GL_FLOAT). Only
+     * the types that OpenGL accepts as vertex attribute components are supported.
+     */
+
+    template<typename T>
+    struct GLType;
+
+    template<> struct GLType<GLbyte>   : std::integral_constant<GLenum, GL_BYTE> {};
+    template<> struct GLType<GLubyte>  : std::integral_constant<GLenum, GL_UNSIGNED_BYTE> {};
+    template<> struct GLType<GLshort>  : std::integral_constant<GLenum, GL_SHORT> {};
+    template<> struct GLType<GLushort> : std::integral_constant<GLenum, GL_UNSIGNED_SHORT> {};
+    template<> struct GLType<GLint>    : std::integral_constant<GLenum, GL_INT> {};
+    template<> struct GLType<GLuint>   : std::integral_constant<GLenum, GL_UNSIGNED_INT> {};
+    template<> struct GLType<GLfloat>  : std::integral_constant<GLenum, GL_FLOAT> {};
+    template<> struct GLType<GLdouble> : std::integral_constant<GLenum, GL_DOUBLE> {};
+
+    /**
+     * The boundary (in bytes) to which the offset of every attribute within an interleaved vertex,
+     * and the stride between consecutive vertices, is rounded up. Most drivers fetch vertex data
+     * fastest (and some only correctly) when attributes begin on 4-byte boundaries.
+     */
+
+    constexpr GLsizei VertexAttributeAlignment = 4;
+
+    /**
+     * Rounds @p offset up to the next multiple of VertexAttributeAlignment.
+     */
+
+    constexpr GLsizei alignVertexOffset(const GLsizei offset) {
+        return (offset + VertexAttributeAlignment - 1) / VertexAttributeAlignment * VertexAttributeAlignment;
+    }
+
+    /**
+     * Describes a single attribute of an interleaved vertex format at runtime: the information
+     * that must be passed to <tt>glVertexAttribPointer()</tt> for that attribute, excluding its
+     * location and the stride of the vertex as a whole.
+     */
+
+    struct VertexAttributeFormat {
+        GLint componentCount;
+        GLenum type;
+        GLboolean normalised;
+        GLsizei offset;
+    };
+
+    bool operator==(const VertexAttributeFormat& lhs, const VertexAttributeFormat& rhs);
+    bool operator!=(const VertexAttributeFormat& lhs, const VertexAttributeFormat& rhs);
+
+    /**
+     * Runtime description of an interleaved vertex format, consisting of an ordered list of
+     * attributes and the stride between consecutive vertices. VertexFormat objects are normally
+     * obtained from VertexLayout::format() rather than being constructed by hand, and are used to
+     * configure a VertexArrayObject. Two formats compare equal (and hash equally) when they would
+     * result in identical vertex array state.
+     */
+
+    class VertexFormat {
+    public:
+
+        VertexFormat(std::vector<VertexAttributeFormat> attributes, GLsizei stride);
+
+        const std::vector<VertexAttributeFormat>& attributes() const;
+        std::size_t hash() const;
+        GLsizei stride() const;
+
+    private:
+
+        std::vector<VertexAttributeFormat> m_attributes;
+        GLsizei m_stride;
+    };
+
+    bool operator==(const VertexFormat& lhs, const VertexFormat& rhs);
+    bool operator!=(const VertexFormat& lhs, const VertexFormat& rhs);
+
+    /**
+     * Compile-time description of a single vertex attribute whose data for each vertex are laid
+     * out like a Harken @c Vector (so that, for example, <tt>VertexAttribute<Vector3f></tt>
+     * describes three consecutive @c GLfloat values). If @p Normalise is @c true, integral
+     * components are mapped by OpenGL onto the range [0, 1] (or [-1, 1] for signed types) rather
+     * than being converted directly to floating-point values.
+     */
+
+    template<typename VectorType, bool Normalise = false>
+    struct VertexAttribute;
+
+    template<typename T, int Size, template<typename, int> class OwnershipPolicy, bool Normalise>
+    struct VertexAttribute<Vector<T, Size, OwnershipPolicy>, Normalise> {
+
+        static_assert(Size >= 1 && Size <= 4, "A vertex attribute must have between 1 and 4 components.");
+
+        using ComponentType = T;
+
+        static constexpr GLint ComponentCount = Size;
+        static constexpr GLenum Type = GLType<T>::value;
+        static constexpr GLboolean Normalised = Normalise ? GL_TRUE : GL_FALSE;
+        static constexpr GLsizei ByteSize = Size * sizeof(T);
+    };
+
+    /**
+     * Compile-time description of an interleaved vertex format made up of a sequence of
+     * VertexAttribute types. The byte offset of each attribute within a vertex and the stride
+     * between consecutive vertices are computed at compile time, with each attribute aligned to
+     * VertexAttributeAlignment; attributes are laid out in the order that they are listed, and
+     * are assigned consecutive attribute locations in that same order.
+     *
+     * VertexLayout has no data of its own. Its format() is used to configure a VertexArrayObject,
+     * and its stride() and offset() may be used to validate the memory layout of whatever C++
+     * structure is used to hold vertex data on the CPU.
+     */
+
+    template<typename... Attributes>
+    class VertexLayout {
+    public:
+
+        static_assert(sizeof...(Attributes) > 0, "A VertexLayout must contain at least one attribute.");
+
+        static constexpr int attributeCount() {
+            return sizeof...(Attributes);
+        }
+
+        /**
+         * Gets the offset, in bytes, of the attribute at @p index from the start of each vertex.
+         * Passing <tt>attributeCount()</tt> as @p index yields the stride of the layout.
+         */
+
+        static constexpr GLsizei offset(const int index) {
+
+            const GLsizei sizes[] = {Attributes::ByteSize...};
+
+            auto result = GLsizei{0};
+            for (auto i = 0; i < index; ++i) {
+                result = alignVertexOffset(result + sizes[i]);
+            }
+
+            return result;
+        }
+
+        /**
+         * Gets the distance, in bytes, between the start of consecutive vertices.
+         */
+
+        static constexpr GLsizei stride() {
+            return offset(attributeCount());
+        }
+
+        /**
+         * Gets a runtime description of the layout suitable for passing to
+         * VertexArrayObject::setFormat().
+         */
+
+        static VertexFormat format() {
+            return format(std::make_index_sequence<sizeof...(Attributes)>{});
+        }
+
+    private:
+
+        template<std::size_t... Indices>
+        static VertexFormat format(std::index_sequence<Indices...>) {
+
+            return VertexFormat{
+                {VertexAttributeFormat{Attributes::ComponentCount, Attributes::Type,
+                                       Attributes::Normalised, offset(Indices)}...},
+                stride()
+            };
+        }
+    };
+}
+
+#endif
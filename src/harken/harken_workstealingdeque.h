@@ -0,0 +1,191 @@
+#ifndef HARKEN_WORKSTEALINGDEQUE_H
+#define HARKEN_WORKSTEALINGDEQUE_H
+
+#include "harken_global.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Harken {
+
+    /**
+     * A Chase-Lev work-stealing deque: a lock-free double-ended queue with a single owner thread,
+     * which pushes and pops items at the bottom (in LIFO order), and any number of thief threads,
+     * which steal items from the top (in FIFO order). The owner only contends with thieves when
+     * the deque holds a single item, so pushing and popping are nearly as cheap as for a
+     * single-threaded stack.
+     *
+     * The implementation follows Lê, Pop, Cohen and Zappa Nardelli, "Correct and Efficient
+     * Work-Stealing for Weak Memory Models" (PPoPP 2013). The underlying circular array grows as
+     * needed; arrays that have been outgrown are retained until the deque is destroyed, since a
+     * thief may still be reading from one.
+     *
+     * @tparam T The type of item held. Must be trivially copyable, and is normally a pointer.
+     */
+
+    template<typename T>
+    class WorkStealingDeque {
+    public:
+
+        static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque items must be trivially copyable.");
+
+        /**
+         * @param capacity The number of items the deque can initially hold. Must be a power of
+         *                 two.
+         */
+
+        explicit WorkStealingDeque(const std::size_t capacity = 1024) {
+
+            assert(capacity > 0 && (capacity & (capacity - 1)) == 0 && "Deque capacity must be a power of two.");
+
+            m_arrays.push_back(std::make_unique<Array>(capacity));
+            m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+        }
+
+        WorkStealingDeque(const WorkStealingDeque<T>&) = delete;
+        WorkStealingDeque<T>& operator=(const WorkStealingDeque<T>&) = delete;
+
+        /**
+         * Determines whether the deque appears to be empty. The result may be out of date as soon
+         * as it is returned, so it is only useful as a hint.
+         */
+
+        bool empty() const {
+
+            const auto bottom = m_bottom.load(std::memory_order_relaxed);
+            const auto top = m_top.load(std::memory_order_relaxed);
+            return bottom <= top;
+        }
+
+        /**
+         * Removes the most recently pushed item and stores it in @p item. Returns @c false,
+         * leaving @p item unchanged, if the deque is empty. May only be called by the owner.
+         */
+
+        bool pop(T& item) {
+
+            const auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            const auto array = m_array.load(std::memory_order_relaxed);
+            m_bottom.store(bottom, std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto top = m_top.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return false;
+            }
+
+            const auto candidate = array->get(bottom);
+            if (top == bottom) {
+
+                // This is the last item, so a thief may be trying to take it at the same time;
+                // whoever advances the top first wins it.
+
+                const auto won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                                             std::memory_order_relaxed);
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+
+                if (!won) {
+                    return false;
+                }
+            }
+
+            item = candidate;
+            return true;
+        }
+
+        /**
+         * Adds @p item to the bottom of the deque. May only be called by the owner.
+         */
+
+        void push(const T item) {
+
+            const auto bottom = m_bottom.load(std::memory_order_relaxed);
+            const auto top = m_top.load(std::memory_order_acquire);
+            auto array = m_array.load(std::memory_order_relaxed);
+
+            if (bottom - top > static_cast<std::int64_t>(array->capacity) - 1) {
+                array = grow(array, bottom, top);
+            }
+
+            array->put(bottom, item);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        /**
+         * Removes the least recently pushed item and stores it in @p item. Returns @c false,
+         * leaving @p item unchanged, if the deque is empty or if another thread took the item
+         * first. May be called by any thread.
+         */
+
+        bool steal(T& item) {
+
+            auto top = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto bottom = m_bottom.load(std::memory_order_acquire);
+
+            if (top >= bottom) {
+                return false;
+            }
+
+            const auto array = m_array.load(std::memory_order_acquire);
+            const auto candidate = array->get(top);
+
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                             std::memory_order_relaxed)) {
+                return false;
+            }
+
+            item = candidate;
+            return true;
+        }
+
+    private:
+
+        struct Array {
+
+            explicit Array(const std::size_t capacity)
+                : capacity{capacity}, items{new std::atomic<T>[capacity]} {
+            }
+
+            T get(const std::int64_t index) const {
+                return items[index & (capacity - 1)].load(std::memory_order_relaxed);
+            }
+
+            void put(const std::int64_t index, const T item) {
+                items[index & (capacity - 1)].store(item, std::memory_order_relaxed);
+            }
+
+            const std::size_t capacity;
+            std::unique_ptr<std::atomic<T>[]> items;
+        };
+
+        Array * grow(Array * const array, const std::int64_t bottom, const std::int64_t top) {
+
+            m_arrays.push_back(std::make_unique<Array>(array->capacity * 2));
+            const auto grown = m_arrays.back().get();
+
+            for (auto i = top; i < bottom; ++i) {
+                grown->put(i, array->get(i));
+            }
+
+            m_array.store(grown, std::memory_order_release);
+            return grown;
+        }
+
+        std::atomic<std::int64_t> m_top{0};
+        std::atomic<std::int64_t> m_bottom{0};
+        std::atomic<Array *> m_array{nullptr};
+
+        std::vector<std::unique_ptr<Array>> m_arrays;
+    };
+}
+
+#endif
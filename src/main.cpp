@@ -1,21 +1,37 @@
+#include "harken_dynamicresolution.h"
+#include "harken_engineloop.h"
+#include "harken_framelimiter.h"
+#include "harken_framesync.h"
+#include "harken_glmath.h"
+#include "harken_jobsystem.h"
+#include "harken_programbinarycache.h"
+#include "harken_renderqueue.h"
+#include "harken_rendertargetpool.h"
+#include "harken_resourceloader.h"
 #include "harken_sdl.h"
+#include "harken_shaderbatch.h"
+#include "harken_shaderlibrary.h"
 #include "harken_shader.h"
 #include "harken_shaderprogram.h"
+#include "harken_shaderreloader.h"
 #include "harken_stringbuilder.h"
 #include "harken_vector.h"
 #include "harken_vertexarrayobject.h"
 #include "harken_vertexbufferobject.h"
+#include "harken_vertexlayout.h"
 
 #include <GL/glew.h>
 #include <SDL.h>
 
 #include <array>
-#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <iostream>
 #include <stdexcept>
+#include <vector>
 
 using namespace Harken;
 
@@ -23,32 +39,50 @@ enum AttribName {
     PositionAttrib = 0
 };
 
-std::atomic<float> scale{0.0f};
+using TriangleVertexLayout = VertexLayout<VertexAttribute<Vector2f>>;
 
-void render(SDLWindow& window, VertexArrayObject& triangleVAO) {
+struct SimulationState {
+    float scale = 0.0f;
+};
+
+void render(SDLWindow& window, RenderQueue& renderQueue, RenderTargetPool& renderTargetPool,
+            DynamicResolution& dynamicResolution, FrameLimiter& frameLimiter, FrameSync& frameSync) {
+
+    dynamicResolution.begin(window.size());
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
-    glClear(GL_COLOR_BUFFER_BIT);
+    renderQueue.flush();
 
-    triangleVAO.bind();
-    glDrawArrays(GL_TRIANGLES, 0, 3);
+    dynamicResolution.end();
+    renderTargetPool.endFrame();
 
     glFlush();
+    frameLimiter.endFrame();
+
     window.swapBuffers();
+    frameLimiter.presented();
+    frameSync.endFrame();
 }
 
-Uint32 update(const Uint32 interval, void *) {
-
-    scale = scale + 0.01f;
-    return interval;
+void update(SimulationState& state, double) {
+    state.scale += 0.01f;
 }
 
-int main() {
+int main(int argc, char * argv[]) {
 
     try {
 
-        SDLManager sdl{SDL_INIT_TIMER};
+        // Benchmarking wants frames as fast as possible; otherwise, frames are paced to the
+        // display with as little latency as possible.
+
+        const auto benchmark = argc > 1 && std::strcmp(argv[1], "--benchmark") == 0;
+
+        SDLManager sdl;
         sdl.setOpenGLVersion(3, 3);
-        auto window = sdl.createWindow("Harken", 1024, 768);
+        auto window = sdl.createWindow("Harken", 1024, 768, benchmark ? SwapInterval::Immediate : SwapInterval::Adaptive);
+
+        const auto refreshRate = window.refreshRate() > 0 ? window.refreshRate() : 60;
+        FrameLimiter frameLimiter{benchmark ? FramePacing::Unlimited : FramePacing::LowLatency, 1.0 / refreshRate};
 
         glewExperimental = true;
         const auto glewResult = glewInit();
@@ -58,49 +92,115 @@ int main() {
 
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 
-        VertexArrayObject triangleVAO;
-        triangleVAO.bind();
+        // Latency matters more than throughput outside of benchmarking, so the CPU is then kept
+        // from queueing more than one frame ahead of the GPU.
 
-        VertexBufferObject arrayBuffer{GL_ARRAY_BUFFER};
-        arrayBuffer.bind();
+        FrameSync frameSync{benchmark ? FrameSync::MaxFramesInFlight : 1};
 
-        GLfloat vertices[3][2] = {
-            { 0.0f,  0.433f},
-            { 0.5f, -0.433f},
-            {-0.5f, -0.433f}
+        // The scene is rendered at whatever resolution keeps the GPU's frame time somewhat under
+        // the refresh interval, and upscaled to the window; benchmarking measures a fixed workload,
+        // so always renders at full resolution.
+
+        RenderTargetPool renderTargetPool;
+        DynamicResolution dynamicResolution{
+            renderTargetPool,
+            benchmark ? ResolutionController{1.0 / refreshRate, 1.0, 1.0} : ResolutionController{0.9 / refreshRate}
+        };
+
+        // Shaders are submitted before anything else is loaded, so that the driver can compile
+        // them while the rest of the setup proceeds.
+
+        ProgramBinaryCache programCache{"shader-cache"};
+        ShaderLibrary shaderLibrary;
+        ShaderBatch shaderBatch{&programCache, &shaderLibrary};
+
+        const std::vector<ShaderFile> triangleShaders = {
+            {GL_VERTEX_SHADER, "uniform-scale.vert", {}},
+            {GL_FRAGMENT_SHADER, "red.frag", {}}
         };
 
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+        // Shaders are rebuilt whenever their files are saved, so they can be edited while the
+        // program runs.
+
+        ShaderReloader shaderReloader{shaderLibrary, &programCache};
+        const auto shaderProgram = shaderReloader.watch(shaderBatch.submit(shaderLibrary.sources(triangleShaders)), triangleShaders);
+
+        // Meshes are prepared by the job system and uploaded on a context of their own, and only
+        // drawn once they have arrived, so loading them never holds up a frame.
+
+        JobSystem jobSystem;
+        ResourceLoader resourceLoader{jobSystem, window.createSharedContext()};
 
-        const auto vertexShader   = std::make_shared<Shader>(GL_VERTEX_SHADER, "uniform-scale.vert");
-        const auto fragmentShader = std::make_shared<Shader>(GL_FRAGMENT_SHADER, "red.frag");
+        const auto triangleBuffer = resourceLoader.load([]() {
+            return std::vector<Vector2f>{{0.0f, 0.433f}, {0.5f, -0.433f}, {-0.5f, -0.433f}};
+        },
+        [](const std::vector<Vector2f>& vertices) {
+            VertexBufferObject buffer{GL_ARRAY_BUFFER};
+            buffer.setData(vertices);
+            return buffer;
+        });
 
-        ShaderProgram shaderProgram{vertexShader, fragmentShader};
-        shaderProgram.use();
+        static_assert(sizeof(Vector2f) == TriangleVertexLayout::stride(),
+                      "Triangle vertex data do not match their declared layout.");
 
-        glVertexAttribPointer(PositionAttrib, 2, GL_FLOAT, GL_FALSE, 0, 0);
-        glEnableVertexAttribArray(PositionAttrib);
+        // Vertex array objects are not shared between contexts, so the triangle's is created here
+        // and pointed at its buffer once that has been loaded.
 
-        const auto scaleLocation = shaderProgram.uniformLocation("scale");
+        VertexArrayObject triangleVAO;
+        auto triangleLoaded = false;
+
+        shaderBatch.finish();
+        shaderLibrary.release();
+        shaderProgram->use();
+
+        std::cout << "Shader programs: " << programCache.stats().hits << " loaded from cache, "
+                  << programCache.stats().misses << " compiled." << std::endl;
+
+        RenderQueue renderQueue;
+
+        EngineLoop<SimulationState> engineLoop{window, std::chrono::microseconds{1000000 / 60}};
+        engineLoop.setFrameLimiter(&frameLimiter);
 
-        SDL_AddTimer(1000 / 60, update, nullptr);
+        const auto draw = [&](const SimulationState& state) {
 
-        auto running = true;
-        while (running) {
+            frameSync.beginFrame();
+            dynamicResolution.update(frameSync);
 
-            // TODO: move this into SDLManager
+            // Input is taken as late as possible, just before the draws that would depend on it,
+            // so that the latency measured on presentation is as short as it can be. Taking it
+            // with beginFrame() also starts the next frame afresh, so that mouse motion does not
+            // accumulate across frames and only newly arrived input counts towards the latency.
 
-            SDL_Event event;
-            while (SDL_PollEvent(&event)) {
+            const auto input = sdl.input().beginFrame();
 
-                if (event.type == SDL_QUIT) {
-                    running = false;
-                }
+            for (const auto& error : shaderReloader.update().errors) {
+                std::cout << error << std::endl;
             }
 
-            glUniform1f(scaleLocation, std::sin(scale.load()));
-            render(window, triangleVAO);
-        }
+            resourceLoader.update();
+
+            if (!triangleLoaded && triangleBuffer->ready()) {
+                triangleVAO.setFormat(triangleBuffer->get(), TriangleVertexLayout::format(), PositionAttrib);
+                triangleLoaded = true;
+            }
+
+            shaderProgram->use();
+            glUniform1f(shaderProgram->uniformLocation("scale"), std::sin(state.scale));
+
+            if (triangleLoaded) {
+                renderQueue.submit(DrawItem{&shaderProgram->program(), &triangleVAO, 0, GL_TRIANGLES, 0, 3}, 0.0f);
+            }
+
+            render(window, renderQueue, renderTargetPool, dynamicResolution, frameLimiter, frameSync);
+
+            sdl.input().presented(input);
+        };
+
+        const auto pumpEvents = [&sdl]() {
+            return sdl.pollEvents();
+        };
+
+        engineLoop.run(update, draw, pumpEvents);
     }
     catch (const std::exception& ex) {
         std::cout << ex.what() << std::endl;
@@ -0,0 +1,8 @@
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in mat4 instanceTransform;
+
+void main() {
+    gl_Position = instanceTransform * position;
+}
@@ -0,0 +1,109 @@
+#include "harken_assetpack.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_temporarydirectory.h"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using Harken::AssetCompression;
+using Harken::AssetPack;
+using Harken::AssetPackException;
+using Harken::AssetPackWriter;
+using Harken::IOException;
+using HarkenTest::TemporaryDirectory;
+
+namespace {
+
+    std::vector<char> bytes(const std::string& string) {
+        return std::vector<char>(string.begin(), string.end());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(asset_pack)
+
+BOOST_AUTO_TEST_CASE(round_trips) {
+
+    const TemporaryDirectory directory;
+    const auto path = directory.file("assets.pack");
+
+    std::string shader;
+    for (auto i = 0; i < 100; ++i) {
+        shader += "gl_Position = vec4(position, 0.0, 1.0);\n";
+    }
+
+    AssetPackWriter writer;
+    writer.add("shaders/a.vert", bytes(shader), AssetCompression::LZ4);
+    writer.add("mesh", bytes("vertices"));
+    writer.add("empty", {});
+    writer.add("random", bytes("\x01\x7f\x80\xff"), AssetCompression::LZ4);
+    writer.write(path);
+
+    const AssetPack pack{path};
+
+    BOOST_TEST(pack.count() == 4u);
+    BOOST_TEST((pack.names() == std::vector<std::string>{"empty", "mesh", "random", "shaders/a.vert"}));
+
+    BOOST_TEST(pack.contains("mesh"));
+    BOOST_TEST(!pack.contains("mes"));
+    BOOST_TEST(!pack.contains("meshes"));
+
+    BOOST_TEST((pack.compression("shaders/a.vert") == AssetCompression::LZ4));
+    BOOST_TEST(pack.size("shaders/a.vert") == shader.size());
+    BOOST_TEST((pack.read("shaders/a.vert") == bytes(shader)));
+
+    // Compression that would not save anything is skipped.
+
+    BOOST_TEST((pack.compression("random") == AssetCompression::None));
+    BOOST_TEST((pack.read("random") == bytes("\x01\x7f\x80\xff")));
+
+    BOOST_TEST(pack.read("empty").empty());
+
+    const auto view = pack.view("mesh");
+    BOOST_TEST(std::string(view.data, view.size) == "vertices");
+    BOOST_TEST(reinterpret_cast<std::uintptr_t>(view.data) % AssetPack::alignment == 0u);
+
+    BOOST_CHECK_THROW(pack.view("shaders/a.vert"), AssetPackException);
+    BOOST_CHECK_THROW(pack.read("missing"), AssetPackException);
+}
+
+BOOST_AUTO_TEST_CASE(rejects_duplicate_names) {
+
+    AssetPackWriter writer;
+    writer.add("a", bytes("1"));
+    BOOST_CHECK_THROW(writer.add("a", bytes("2")), AssetPackException);
+}
+
+BOOST_AUTO_TEST_CASE(rejects_invalid_packs) {
+
+    const TemporaryDirectory directory;
+    BOOST_CHECK_THROW(AssetPack{directory.file("missing.pack")}, IOException);
+
+    const auto path = directory.write("invalid.pack", "not an asset pack");
+
+    BOOST_CHECK_THROW(AssetPack{path}, AssetPackException);
+
+    // A valid pack cut short, so that its asset lies partly beyond the end of the file.
+
+    AssetPackWriter writer;
+    writer.add("a", std::vector<char>(1000, 'a'));
+    writer.write(path);
+
+    std::vector<char> contents(500);
+    {
+        std::ifstream file{path, std::ios::binary};
+        file.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+
+    {
+        std::ofstream file{path, std::ios::binary | std::ios::trunc};
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+
+    BOOST_CHECK_THROW(AssetPack{path}, AssetPackException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
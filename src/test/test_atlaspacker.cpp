@@ -0,0 +1,248 @@
+#include "harken_atlaspacker.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using Harken::AtlasException;
+using Harken::AtlasIndex;
+using Harken::AtlasPacker;
+using Harken::AtlasRegion;
+using Harken::Size2;
+using Harken::SkylinePacker;
+using Harken::Vector2f;
+
+namespace {
+
+    bool overlap(const AtlasRegion& lhs, const AtlasRegion& rhs, const int padding) {
+        return lhs.page == rhs.page
+            && lhs.x - padding < rhs.x + rhs.width + padding && rhs.x - padding < lhs.x + lhs.width + padding
+            && lhs.y - padding < rhs.y + rhs.height + padding && rhs.y - padding < lhs.y + lhs.height + padding;
+    }
+
+    std::vector<Size2<int>> randomSizes(const std::size_t count, const unsigned seed) {
+
+        std::mt19937 generator{seed};
+        std::uniform_int_distribution<int> distribution{1, 40};
+
+        std::vector<Size2<int>> sizes;
+        for (std::size_t i = 0; i < count; ++i) {
+            sizes.emplace_back(distribution(generator), distribution(generator));
+        }
+
+        return sizes;
+    }
+
+    /**
+     * Checks that every region lies within its page, clear of every other region's gutter.
+     */
+
+    void checkRegions(const std::vector<AtlasRegion>& regions, const AtlasPacker& packer) {
+
+        const auto padding = packer.padding();
+        const auto pageSize = packer.pageSize();
+
+        for (std::size_t i = 0; i < regions.size(); ++i) {
+
+            const auto& region = regions[i];
+
+            BOOST_CHECK(region.page >= 0 && region.page < packer.pageCount());
+            BOOST_CHECK(region.x >= padding && region.x + region.width + padding <= pageSize.width());
+            BOOST_CHECK(region.y >= padding && region.y + region.height + padding <= pageSize.height());
+
+            for (std::size_t j = 0; j < i; ++j) {
+                BOOST_CHECK(!overlap(region, regions[j], padding));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(atlas_packer)
+
+BOOST_AUTO_TEST_CASE(skyline_fills_page_exactly) {
+
+    SkylinePacker packer{{64, 64}};
+
+    int x;
+    int y;
+
+    for (auto i = 0; i < 16; ++i) {
+        BOOST_REQUIRE(packer.insert({16, 16}, x, y));
+        BOOST_CHECK_EQUAL(x % 16, 0);
+        BOOST_CHECK_EQUAL(y % 16, 0);
+    }
+
+    BOOST_CHECK(!packer.insert({1, 1}, x, y));
+    BOOST_CHECK_CLOSE(packer.occupancy(), 1.0, 1e-9);
+
+    packer.clear();
+    BOOST_CHECK(packer.insert({64, 64}, x, y));
+}
+
+BOOST_AUTO_TEST_CASE(skyline_places_lowest) {
+
+    SkylinePacker packer{{100, 100}};
+
+    int x;
+    int y;
+
+    BOOST_REQUIRE(packer.insert({60, 50}, x, y));
+    BOOST_REQUIRE(packer.insert({40, 10}, x, y));
+    BOOST_CHECK_EQUAL(x, 60);
+    BOOST_CHECK_EQUAL(y, 0);
+
+    // Wider than the gap beside the first rectangle, so must rest on top of it.
+
+    BOOST_REQUIRE(packer.insert({50, 10}, x, y));
+    BOOST_CHECK_EQUAL(x, 0);
+    BOOST_CHECK_EQUAL(y, 50);
+}
+
+BOOST_AUTO_TEST_CASE(batch_insertion_does_not_overlap) {
+
+    AtlasPacker packer{{256, 256}, 2};
+
+    const auto sizes = randomSizes(200, 7);
+    const auto regions = packer.insert(sizes);
+
+    BOOST_REQUIRE_EQUAL(regions.size(), sizes.size());
+
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        BOOST_CHECK_EQUAL(regions[i].width, sizes[i].width());
+        BOOST_CHECK_EQUAL(regions[i].height, sizes[i].height());
+    }
+
+    checkRegions(regions, packer);
+    BOOST_CHECK_GT(packer.pageCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(incremental_insertion_reuses_pages) {
+
+    AtlasPacker packer{{128, 128}, 1};
+    std::vector<AtlasRegion> regions;
+
+    for (const auto& size : randomSizes(60, 11)) {
+        regions.push_back(packer.insert(size));
+    }
+
+    checkRegions(regions, packer);
+
+    // A small image still fits on the first page, however many have been opened since.
+
+    BOOST_CHECK_EQUAL(packer.insert({1, 1}).page, 0);
+}
+
+BOOST_AUTO_TEST_CASE(insertion_fails_when_full) {
+
+    AtlasPacker packer{{32, 32}, 1, 1};
+
+    BOOST_CHECK_THROW(packer.insert({31, 31}), AtlasException);
+    BOOST_CHECK_NO_THROW(packer.insert({30, 30}));
+    BOOST_CHECK_THROW(packer.insert({30, 30}), AtlasException);
+    BOOST_CHECK_EQUAL(packer.pageCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(empty_images_are_rejected) {
+
+    AtlasPacker packer{{32, 32}, 1};
+
+    BOOST_CHECK_THROW(packer.insert({0, 0}), AtlasException);
+    BOOST_CHECK_THROW(packer.insert({4, 0}), AtlasException);
+    BOOST_CHECK_THROW(packer.insert({-1, 4}), AtlasException);
+    BOOST_CHECK_EQUAL(packer.pageCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(regions_remap_texture_coordinates) {
+
+    AtlasPacker packer{{64, 32}, 0};
+
+    packer.insert({32, 32});
+    const auto region = packer.insert({16, 8});
+
+    BOOST_CHECK_EQUAL(region.x, 32);
+    BOOST_CHECK_EQUAL(region.y, 0);
+    BOOST_CHECK_CLOSE(region.uvMin.x(), 0.5f, 1e-4);
+    BOOST_CHECK_CLOSE(region.uvMax.x(), 0.75f, 1e-4);
+    BOOST_CHECK_CLOSE(region.uvMax.y(), 0.25f, 1e-4);
+
+    const auto middle = region.remap(Vector2f{0.5f, 0.5f});
+    BOOST_CHECK_CLOSE(middle.x(), 0.625f, 1e-4);
+    BOOST_CHECK_CLOSE(middle.y(), 0.125f, 1e-4);
+}
+
+BOOST_AUTO_TEST_CASE(padding_repeats_edges) {
+
+    const std::vector<char> pixels{1, 2, 3, 4};
+    const auto padded = Harken::padImage(pixels.data(), {2, 2}, 1, 1);
+
+    const std::vector<char> expected{
+        1, 1, 2, 2,
+        1, 1, 2, 2,
+        3, 3, 4, 4,
+        3, 3, 4, 4
+    };
+
+    BOOST_CHECK(padded == expected);
+}
+
+BOOST_AUTO_TEST_CASE(index_round_trips) {
+
+    AtlasPacker packer{{64, 64}, 1};
+
+    AtlasIndex index;
+    index.pageSize = packer.pageSize();
+    index.padding = packer.padding();
+    index.regions["grass"] = packer.insert({20, 20});
+    index.regions["stone"] = packer.insert({40, 12});
+    index.pageCount = packer.pageCount();
+
+    const auto data = Harken::writeAtlasIndex(index);
+    const auto read = Harken::readAtlasIndex(data.data(), data.size());
+
+    BOOST_CHECK_EQUAL(read.pageSize.width(), 64);
+    BOOST_CHECK_EQUAL(read.pageCount, 1);
+    BOOST_CHECK_EQUAL(read.padding, 1);
+    BOOST_REQUIRE_EQUAL(read.regions.size(), 2u);
+
+    const auto& stone = read.regions.at("stone");
+    BOOST_CHECK_EQUAL(stone.x, index.regions["stone"].x);
+    BOOST_CHECK_EQUAL(stone.height, 12);
+    BOOST_CHECK_CLOSE(stone.uvMax.y(), index.regions["stone"].uvMax.y(), 1e-4);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_index_is_rejected) {
+
+    AtlasIndex index;
+    index.pageSize = {16, 16};
+    index.pageCount = 1;
+    index.regions["image"] = AtlasRegion{};
+    index.regions["image"].width = 4;
+    index.regions["image"].height = 4;
+
+    auto data = Harken::writeAtlasIndex(index);
+    BOOST_CHECK_THROW(Harken::readAtlasIndex(data.data(), data.size() - 1), AtlasException);
+
+    index.regions["image"].x = 14;
+    data = Harken::writeAtlasIndex(index);
+    BOOST_CHECK_THROW(Harken::readAtlasIndex(data.data(), data.size()), AtlasException);
+
+    data[0] = 'X';
+    BOOST_CHECK_THROW(Harken::readAtlasIndex(data.data(), data.size()), AtlasException);
+
+    // A name length far beyond the end of the data, which immediately precedes the name.
+
+    index.regions["image"].x = 0;
+    data = Harken::writeAtlasIndex(index);
+
+    const auto name = std::search(data.begin(), data.end(), std::begin("image"), std::end("image") - 1);
+    BOOST_REQUIRE(name != data.end());
+    std::fill(name - 4, name, '\xff');
+
+    BOOST_CHECK_THROW(Harken::readAtlasIndex(data.data(), data.size()), AtlasException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
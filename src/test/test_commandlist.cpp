@@ -0,0 +1,147 @@
+#include "harken_commandlist.h"
+#include "harken_linearallocator.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace Commands = Harken::Commands;
+
+namespace {
+
+    /**
+     * Visitor that flattens a command list into a sequence of values that can easily be compared
+     * against an expected sequence.
+     */
+
+    struct Flattener {
+
+        void operator()(const Commands::UseProgram&) {
+            values.push_back(-1.0f);
+        }
+
+        void operator()(const Commands::BindVertexArray&) {
+            values.push_back(-2.0f);
+        }
+
+        void operator()(const Commands::SetUniform1f& command) {
+            values.push_back(static_cast<float>(command.location));
+            values.push_back(command.value);
+        }
+
+        void operator()(const Commands::SetUniform4f& command) {
+            values.push_back(static_cast<float>(command.location));
+            values.insert(values.end(), command.value, command.value + 4);
+        }
+
+        void operator()(const Commands::SetUniformMatrix4f& command) {
+            values.push_back(static_cast<float>(command.location));
+            values.insert(values.end(), command.value, command.value + 16);
+        }
+
+        void operator()(const Commands::DrawArrays& command) {
+            values.push_back(static_cast<float>(command.count));
+        }
+
+        void operator()(const Commands::DrawElements& command) {
+            values.push_back(static_cast<float>(command.count));
+        }
+
+        std::vector<float> values;
+    };
+}
+
+BOOST_AUTO_TEST_SUITE(command_list)
+
+BOOST_AUTO_TEST_CASE(linear_allocator) {
+
+    Harken::LinearAllocator allocator{64};
+
+    const auto first = static_cast<unsigned char *>(allocator.allocate(3, 1));
+    const auto second = static_cast<unsigned char *>(allocator.allocate(8, 8));
+
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(second) % 8, 0u);
+    BOOST_CHECK_EQUAL(allocator.bytesAllocated(), 16u);
+
+    allocator.allocate(60, 4);
+    BOOST_CHECK_EQUAL(allocator.capacity(), 128u);
+
+    allocator.allocate(100, 4);
+    BOOST_CHECK_EQUAL(allocator.capacity(), 228u);
+
+    allocator.reset();
+    BOOST_CHECK_EQUAL(allocator.bytesAllocated(), 0u);
+    BOOST_CHECK_EQUAL(allocator.allocate(3, 1), first);
+    BOOST_CHECK_EQUAL(allocator.capacity(), 228u);
+}
+
+BOOST_AUTO_TEST_CASE(recording) {
+
+    Harken::CommandList commands{128};
+
+    commands.setUniform(3, 0.5f);
+    commands.setUniform(4, Harken::Vector4f{1.0f, 2.0f, 3.0f, 4.0f});
+    commands.setUniform(5, Harken::Matrix4f{});
+    commands.drawArrays(GL_TRIANGLES, 0, 36);
+    commands.drawElements(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT);
+
+    BOOST_CHECK_EQUAL(commands.size(), 5u);
+
+    Flattener flattener;
+    commands.visit(flattener);
+
+    std::vector<float> expected{3.0f, 0.5f, 4.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    const Harken::Matrix4f identity;
+    expected.insert(expected.end(), identity.data(), identity.data() + 16);
+    expected.push_back(36.0f);
+    expected.push_back(6.0f);
+
+    BOOST_CHECK(flattener.values == expected);
+
+    const auto bytesUsed = commands.bytesUsed();
+    commands.clear();
+
+    BOOST_CHECK_EQUAL(commands.size(), 0u);
+    BOOST_CHECK_EQUAL(commands.bytesUsed(), 0u);
+
+    commands.drawArrays(GL_POINTS, 0, 1);
+    BOOST_CHECK_LT(commands.bytesUsed(), bytesUsed);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_recording) {
+
+    constexpr auto ThreadCount = 4;
+    constexpr auto DrawsPerThread = 10000;
+
+    std::vector<Harken::CommandList> lists(ThreadCount);
+    std::vector<std::thread> workers;
+
+    for (auto t = 0; t < ThreadCount; ++t) {
+        workers.emplace_back([&lists, t]() {
+            for (auto i = 0; i < DrawsPerThread; ++i) {
+                lists[t].setUniform(t, static_cast<float>(i));
+                lists[t].drawArrays(GL_TRIANGLES, 0, 3);
+            }
+        });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (auto t = 0; t < ThreadCount; ++t) {
+
+        BOOST_CHECK_EQUAL(lists[t].size(), 2u * DrawsPerThread);
+
+        Flattener flattener;
+        lists[t].visit(flattener);
+
+        BOOST_REQUIRE_EQUAL(flattener.values.size(), 3u * DrawsPerThread);
+        BOOST_CHECK_EQUAL(flattener.values[0], static_cast<float>(t));
+        BOOST_CHECK_EQUAL(flattener.values[3 * (DrawsPerThread - 1) + 1], static_cast<float>(DrawsPerThread - 1));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
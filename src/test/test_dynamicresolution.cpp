@@ -0,0 +1,81 @@
+#include "harken_dynamicresolution.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+
+using Harken::ResolutionController;
+using Harken::Size2;
+
+namespace {
+
+    /**
+     * A simple model of a GPU: a fixed cost per frame, plus a cost proportional to the number of
+     * pixels rendered.
+     */
+
+    double modelFrameTime(const double scale, const double fixedCost, const double fullResolutionCost) {
+        return fixedCost + fullResolutionCost * scale * scale;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(dynamic_resolution)
+
+BOOST_AUTO_TEST_CASE(converges_to_target) {
+
+    // Rendering at full resolution takes 26ms; the target is 14ms, which this model reaches at a
+    // scale of sqrt(12 / 24), or about 0.707.
+
+    ResolutionController controller{0.014};
+
+    auto frameTime = 0.0;
+    for (auto frame = 0; frame < 200; ++frame) {
+        frameTime = modelFrameTime(controller.scale(), 0.002, 0.024);
+        controller.update(frameTime);
+    }
+
+    BOOST_CHECK_LT(std::abs(frameTime - 0.014), 0.0005);
+    BOOST_CHECK_LT(std::abs(controller.scale() - std::sqrt(0.5)), 0.02);
+}
+
+BOOST_AUTO_TEST_CASE(respects_limits) {
+
+    ResolutionController controller{0.010, 0.6, 0.9};
+    BOOST_CHECK_CLOSE(controller.scale(), 0.9, 1e-9);
+
+    // A load that could never meet the target pins the scale to its minimum...
+
+    for (auto frame = 0; frame < 200; ++frame) {
+        controller.update(0.050);
+    }
+
+    BOOST_CHECK_CLOSE(controller.scale(), 0.6, 1e-9);
+
+    // ...and one far below it pins the scale to its maximum, promptly, since nothing has been
+    // accumulated while pinned.
+
+    for (auto frame = 0; frame < 50; ++frame) {
+        controller.update(0.001);
+    }
+
+    BOOST_CHECK_CLOSE(controller.scale(), 0.9, 1e-9);
+
+    controller.update(0.050);
+    controller.reset();
+    BOOST_CHECK_CLOSE(controller.scale(), 0.9, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(scaled_size) {
+
+    ResolutionController controller{0.010, 0.5, 0.5};
+
+    const auto size = controller.scaledSize(Size2<int>{1920, 1081});
+    BOOST_CHECK_EQUAL(size.width(), 960);
+    BOOST_CHECK_EQUAL(size.height(), 541);
+
+    const auto tiny = controller.scaledSize(Size2<int>{1, 1});
+    BOOST_CHECK_EQUAL(tiny.width(), 1);
+    BOOST_CHECK_EQUAL(tiny.height(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
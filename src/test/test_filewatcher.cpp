@@ -0,0 +1,62 @@
+#include "harken_filewatcher.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_temporarydirectory.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using Harken::FileWatcher;
+using HarkenTest::TemporaryDirectory;
+
+BOOST_AUTO_TEST_SUITE(file_watcher)
+
+BOOST_AUTO_TEST_CASE(reports_written_files) {
+
+    const TemporaryDirectory directory;
+    const auto a = directory.write("a.glsl", "1");
+    const auto b = directory.file("b.glsl");
+
+    FileWatcher watcher;
+    if (!watcher.supported()) {
+        return;
+    }
+
+    BOOST_TEST(watcher.watch(a));
+    BOOST_TEST(watcher.watch(b));
+    BOOST_TEST(watcher.poll().empty());
+
+    directory.write("a.glsl", "2");
+    directory.write("a.glsl", "3");
+    directory.write("other.glsl", "1");
+
+    BOOST_TEST(watcher.poll() == std::vector<std::string>{a});
+    BOOST_TEST(watcher.poll().empty());
+
+    // Files that did not exist when they were first watched are reported once they are written.
+
+    directory.write("b.glsl", "1");
+    BOOST_TEST(watcher.poll() == std::vector<std::string>{b});
+}
+
+BOOST_AUTO_TEST_CASE(reports_files_replaced_by_rename) {
+
+    const TemporaryDirectory directory;
+    const auto a = directory.write("a.glsl", "1");
+
+    FileWatcher watcher;
+    if (!watcher.supported()) {
+        return;
+    }
+
+    BOOST_TEST(watcher.watch(a));
+
+    const auto replacement = directory.write("a.glsl.tmp", "2");
+    std::rename(replacement.c_str(), a.c_str());
+
+    BOOST_TEST(watcher.poll() == std::vector<std::string>{a});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
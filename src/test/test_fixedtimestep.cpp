@@ -0,0 +1,42 @@
+#include "harken_fixedtimestep.h"
+#include "harken_math.h"
+
+#include <boost/test/unit_test.hpp>
+
+using Harken::FixedTimestep;
+
+BOOST_AUTO_TEST_SUITE(fixed_timestep)
+
+BOOST_AUTO_TEST_CASE(accumulation) {
+
+    FixedTimestep timestep{0.25};
+
+    BOOST_CHECK_EQUAL(timestep.advance(0.1), 0);
+    BOOST_CHECK(Harken::almostEqual(timestep.alpha(), 0.4, 1e-9));
+
+    BOOST_CHECK_EQUAL(timestep.advance(0.2), 1);
+    BOOST_CHECK(Harken::almostEqual(timestep.alpha(), 0.2, 1e-9));
+
+    BOOST_CHECK_EQUAL(timestep.advance(0.5), 2);
+    BOOST_CHECK(Harken::almostEqual(timestep.alpha(), 0.2, 1e-9));
+
+    BOOST_CHECK_EQUAL(timestep.advance(-1.0), 0);
+    BOOST_CHECK(Harken::almostEqual(timestep.alpha(), 0.2, 1e-9));
+
+    timestep.reset();
+    BOOST_CHECK_EQUAL(timestep.alpha(), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(spiral_of_death_clamp) {
+
+    FixedTimestep timestep{0.25, 4};
+
+    BOOST_CHECK_EQUAL(timestep.advance(2.6), 4);
+    BOOST_CHECK(Harken::almostEqual(timestep.droppedTime(), 1.5, 1e-9));
+    BOOST_CHECK(Harken::almostEqual(timestep.alpha(), 0.4, 1e-9));
+
+    BOOST_CHECK_EQUAL(timestep.advance(0.2), 1);
+    BOOST_CHECK(Harken::almostEqual(timestep.droppedTime(), 1.5, 1e-9));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
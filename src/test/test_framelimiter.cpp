@@ -0,0 +1,90 @@
+#include "harken_framelimiter.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <thread>
+
+using Harken::FrameLimiter;
+using Harken::FramePacing;
+
+namespace {
+
+    double secondsSince(const FrameLimiter::Clock::time_point start) {
+        return std::chrono::duration<double>{FrameLimiter::Clock::now() - start}.count();
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(frame_limiter)
+
+BOOST_AUTO_TEST_CASE(limited_pacing) {
+
+    // Timing on a loaded machine can only be relied upon to be late, never early, so only lower
+    // bounds are checked.
+
+    FrameLimiter limiter{FramePacing::Limited, 0.005};
+    const auto start = FrameLimiter::Clock::now();
+
+    for (auto i = 0; i < 11; ++i) {
+        limiter.beginFrame();
+        limiter.endFrame();
+    }
+
+    BOOST_CHECK_GE(secondsSince(start), 0.05);
+}
+
+BOOST_AUTO_TEST_CASE(unlimited_pacing) {
+
+    FrameLimiter limiter;
+    BOOST_CHECK(limiter.pacing() == FramePacing::Unlimited);
+
+    for (auto i = 0; i < 100; ++i) {
+        BOOST_CHECK_LT(limiter.beginFrame(), 0.001);
+        limiter.endFrame();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(work_prediction) {
+
+    FrameLimiter limiter{FramePacing::LowLatency, 0.02};
+    BOOST_CHECK_EQUAL(limiter.predictedWorkTime(), 0.0);
+
+    limiter.beginFrame();
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    limiter.endFrame();
+
+    const auto slowEstimate = limiter.predictedWorkTime();
+    BOOST_CHECK_GE(slowEstimate, 0.005);
+
+    // A quick frame only lowers the estimate a little.
+
+    limiter.beginFrame();
+    limiter.endFrame();
+
+    BOOST_CHECK_LT(limiter.predictedWorkTime(), slowEstimate);
+    BOOST_CHECK_GT(limiter.predictedWorkTime(), slowEstimate * 0.9);
+}
+
+BOOST_AUTO_TEST_CASE(low_latency_pacing) {
+
+    // After a present, the next frame should start just early enough for its predicted work and
+    // the safety margin to end at the next refresh, a refresh interval after the present. Quick
+    // frames keep the work estimate small, so that the limiter has a real wait to make.
+
+    FrameLimiter limiter{FramePacing::LowLatency, 0.05};
+    limiter.setSafetyMargin(0.002);
+
+    limiter.beginFrame();
+    limiter.endFrame();
+
+    const auto workTime = limiter.predictedWorkTime();
+    BOOST_REQUIRE_LT(workTime, 0.01);
+
+    const auto presentTime = FrameLimiter::Clock::now();
+    limiter.presented();
+    limiter.beginFrame();
+
+    BOOST_CHECK_GE(secondsSince(presentTime), 0.05 - workTime - 0.002);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
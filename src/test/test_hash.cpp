@@ -0,0 +1,38 @@
+#include "harken_hash.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <string>
+
+using Harken::Hasher;
+
+BOOST_AUTO_TEST_SUITE(hash)
+
+BOOST_AUTO_TEST_CASE(fnv1a_reference_values) {
+
+    // Reference values of the 64-bit FNV-1a hash, from its specification.
+
+    BOOST_CHECK_EQUAL(Hasher{}.value(), 0xcbf29ce484222325ull);
+    BOOST_CHECK_EQUAL(Hasher{}.add("a", 1).value(), 0xaf63dc4c8601ec8cull);
+    BOOST_CHECK_EQUAL(Hasher{}.add("foobar", 6).value(), 0x85944171f73967e8ull);
+}
+
+BOOST_AUTO_TEST_CASE(strings_are_delimited) {
+
+    const auto ab_c = Hasher{}.add(std::string{"ab"}).add(std::string{"c"}).value();
+    const auto a_bc = Hasher{}.add(std::string{"a"}).add(std::string{"bc"}).value();
+
+    BOOST_CHECK_NE(ab_c, a_bc);
+    BOOST_CHECK_EQUAL(ab_c, Hasher{}.add(std::string{"ab"}).add(std::string{"c"}).value());
+}
+
+BOOST_AUTO_TEST_CASE(values) {
+
+    const std::uint32_t value = 0x8b31;
+
+    BOOST_CHECK_EQUAL(Hasher{}.add(value).value(), Hasher{}.add(&value, sizeof(value)).value());
+    BOOST_CHECK_NE(Hasher{}.add(value).value(), Hasher{}.add(static_cast<std::uint64_t>(value)).value());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+#include "harken_input.h"
+
+#include <boost/test/unit_test.hpp>
+
+using Harken::InputState;
+
+namespace {
+
+    SDL_Event keyEvent(const Uint32 type, const SDL_Scancode scancode, const bool repeat = false) {
+
+        SDL_Event event{};
+        event.type = type;
+        event.key.keysym.scancode = scancode;
+        event.key.repeat = repeat ? 1 : 0;
+        return event;
+    }
+
+    SDL_Event buttonEvent(const Uint32 type, const int button) {
+
+        SDL_Event event{};
+        event.type = type;
+        event.button.button = static_cast<Uint8>(button);
+        return event;
+    }
+
+    SDL_Event motionEvent(const int x, const int y, const int xrel, const int yrel) {
+
+        SDL_Event event{};
+        event.type = SDL_MOUSEMOTION;
+        event.motion.x = x;
+        event.motion.y = y;
+        event.motion.xrel = xrel;
+        event.motion.yrel = yrel;
+        return event;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(input)
+
+BOOST_AUTO_TEST_CASE(key_transitions) {
+
+    InputState state;
+
+    state.apply(keyEvent(SDL_KEYDOWN, SDL_SCANCODE_A), 10);
+    BOOST_CHECK(state.keyDown(SDL_SCANCODE_A));
+    BOOST_CHECK(state.keyPressed(SDL_SCANCODE_A));
+    BOOST_CHECK(!state.keyReleased(SDL_SCANCODE_A));
+    BOOST_CHECK(!state.keyDown(SDL_SCANCODE_SPACE));
+
+    // A new frame keeps the key held but forgets that it was pressed, and key repeats do not
+    // count as presses.
+
+    state.beginFrame();
+    state.apply(keyEvent(SDL_KEYDOWN, SDL_SCANCODE_A, true), 20);
+    BOOST_CHECK(state.keyDown(SDL_SCANCODE_A));
+    BOOST_CHECK(!state.keyPressed(SDL_SCANCODE_A));
+
+    state.apply(keyEvent(SDL_KEYUP, SDL_SCANCODE_A), 30);
+    BOOST_CHECK(!state.keyDown(SDL_SCANCODE_A));
+    BOOST_CHECK(state.keyReleased(SDL_SCANCODE_A));
+
+    // Out-of-range scancodes are ignored rather than trusted.
+
+    state.apply(keyEvent(SDL_KEYDOWN, static_cast<SDL_Scancode>(SDL_NUM_SCANCODES)), 40);
+    BOOST_CHECK(!state.keyDown(static_cast<SDL_Scancode>(SDL_NUM_SCANCODES)));
+}
+
+BOOST_AUTO_TEST_CASE(mouse_accumulation) {
+
+    InputState state;
+
+    state.apply(motionEvent(10, 20, 3, 4), 1);
+    state.apply(motionEvent(12, 25, 2, 5), 2);
+    state.apply(buttonEvent(SDL_MOUSEBUTTONDOWN, SDL_BUTTON_LEFT), 3);
+    state.apply(buttonEvent(SDL_MOUSEBUTTONDOWN, 0), 4);
+
+    BOOST_CHECK_EQUAL(state.mousePosition()[0], 12);
+    BOOST_CHECK_EQUAL(state.mousePosition()[1], 25);
+    BOOST_CHECK_EQUAL(state.mouseMotion()[0], 5);
+    BOOST_CHECK_EQUAL(state.mouseMotion()[1], 9);
+    BOOST_CHECK(state.mouseButtonDown(SDL_BUTTON_LEFT));
+    BOOST_CHECK(state.mouseButtonPressed(SDL_BUTTON_LEFT));
+    BOOST_CHECK(!state.mouseButtonDown(SDL_BUTTON_RIGHT));
+    BOOST_CHECK(!state.mouseButtonDown(0));
+
+    state.beginFrame();
+
+    BOOST_CHECK_EQUAL(state.mousePosition()[0], 12);
+    BOOST_CHECK_EQUAL(state.mouseMotion()[0], 0);
+    BOOST_CHECK(state.mouseButtonDown(SDL_BUTTON_LEFT));
+    BOOST_CHECK(!state.mouseButtonPressed(SDL_BUTTON_LEFT));
+}
+
+BOOST_AUTO_TEST_CASE(timestamps) {
+
+    InputState state;
+    BOOST_CHECK_EQUAL(state.newestEventTime(), 0u);
+    BOOST_CHECK_EQUAL(state.oldestFrameEventTime(), 0u);
+
+    state.apply(keyEvent(SDL_KEYDOWN, SDL_SCANCODE_A), 100);
+    state.apply(motionEvent(0, 0, 1, 1), 150);
+
+    // Events that are not input do not affect the state or its timestamps.
+
+    SDL_Event quit{};
+    quit.type = SDL_QUIT;
+    state.apply(quit, 200);
+
+    BOOST_CHECK_EQUAL(state.eventCount(), 2u);
+    BOOST_CHECK_EQUAL(state.newestEventTime(), 150u);
+    BOOST_CHECK_EQUAL(state.oldestFrameEventTime(), 100u);
+
+    state.beginFrame();
+    BOOST_CHECK_EQUAL(state.eventCount(), 0u);
+    BOOST_CHECK_EQUAL(state.newestEventTime(), 150u);
+    BOOST_CHECK_EQUAL(state.oldestFrameEventTime(), 0u);
+
+    state.apply(keyEvent(SDL_KEYUP, SDL_SCANCODE_A), 250);
+    BOOST_CHECK_EQUAL(state.oldestFrameEventTime(), 250u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,204 @@
+#include "harken_jobsystem.h"
+#include "harken_workstealingdeque.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(job_system)
+
+BOOST_AUTO_TEST_CASE(deque_single_thread) {
+
+    Harken::WorkStealingDeque<int> deque{2};
+    int item = 0;
+
+    BOOST_CHECK(deque.empty());
+    BOOST_CHECK(!deque.pop(item));
+    BOOST_CHECK(!deque.steal(item));
+
+    // Pushing beyond the initial capacity forces the deque to grow.
+
+    for (auto i = 1; i <= 5; ++i) {
+        deque.push(i);
+    }
+
+    BOOST_CHECK(deque.steal(item));
+    BOOST_CHECK_EQUAL(item, 1);
+    BOOST_CHECK(deque.pop(item));
+    BOOST_CHECK_EQUAL(item, 5);
+    BOOST_CHECK(deque.steal(item));
+    BOOST_CHECK_EQUAL(item, 2);
+    BOOST_CHECK(deque.pop(item));
+    BOOST_CHECK_EQUAL(item, 4);
+    BOOST_CHECK(deque.pop(item));
+    BOOST_CHECK_EQUAL(item, 3);
+    BOOST_CHECK(!deque.pop(item));
+    BOOST_CHECK(deque.empty());
+}
+
+BOOST_AUTO_TEST_CASE(deque_concurrent_steal) {
+
+    constexpr auto ItemCount = 100000;
+    constexpr auto ThiefCount = 3;
+
+    Harken::WorkStealingDeque<int> deque{64};
+    std::vector<std::atomic<int>> taken(ItemCount);
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (auto t = 0; t < ThiefCount; ++t) {
+        thieves.emplace_back([&deque, &taken, &done]() {
+            int item = 0;
+            while (!done || !deque.empty()) {
+                if (deque.steal(item)) {
+                    ++taken[item];
+                }
+            }
+        });
+    }
+
+    int item = 0;
+    for (auto i = 0; i < ItemCount; ++i) {
+
+        deque.push(i);
+        if (i % 3 == 0 && deque.pop(item)) {
+            ++taken[item];
+        }
+    }
+
+    while (deque.pop(item)) {
+        ++taken[item];
+    }
+
+    done = true;
+    for (auto& thief : thieves) {
+        thief.join();
+    }
+
+    auto exactlyOnce = true;
+    for (const auto& count : taken) {
+        exactlyOnce = exactlyOnce && count == 1;
+    }
+
+    BOOST_CHECK(exactlyOnce);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_for) {
+
+    Harken::JobSystem jobs{3, Harken::JobSystemCaller::Worker};
+    BOOST_CHECK_EQUAL(jobs.threadCount(), 4u);
+
+    std::vector<int> values(10000, 0);
+    jobs.parallelFor(0, values.size(), 64, [&values](const std::size_t i) {
+        values[i] = static_cast<int>(i);
+    });
+
+    std::vector<int> expected(values.size());
+    std::iota(expected.begin(), expected.end(), 0);
+    BOOST_CHECK(values == expected);
+
+    auto called = false;
+    jobs.parallelFor(5, 5, 1, [&called](std::size_t) { called = true; });
+    BOOST_CHECK(!called);
+}
+
+BOOST_AUTO_TEST_CASE(nested_jobs) {
+
+    Harken::JobSystem jobs{3};
+
+    // Each outer job spawns and waits on inner jobs of its own, which must not deadlock even
+    // when there are more outer jobs than threads.
+
+    std::atomic<int> total{0};
+    Harken::JobCounter outer;
+
+    for (auto i = 0; i < 16; ++i) {
+        jobs.run([&jobs, &total]() {
+            jobs.parallelFor(0, 100, 10, [&total](std::size_t) { ++total; });
+        }, outer);
+    }
+
+    jobs.wait(outer);
+    BOOST_CHECK(outer.done());
+    BOOST_CHECK_EQUAL(total.load(), 1600);
+}
+
+BOOST_AUTO_TEST_CASE(external_thread) {
+
+    Harken::JobSystem jobs{2};
+    std::atomic<int> total{0};
+
+    std::thread external{[&jobs, &total]() {
+        Harken::JobCounter counter;
+        for (auto i = 0; i < 100; ++i) {
+            jobs.run([&total]() { ++total; }, counter);
+        }
+        jobs.wait(counter);
+    }};
+
+    external.join();
+    BOOST_CHECK_EQUAL(total.load(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(job_exceptions) {
+
+    Harken::JobSystem jobs{2};
+    Harken::JobCounter counter;
+    std::atomic<int> finished{0};
+
+    for (auto i = 0; i < 8; ++i) {
+        jobs.run([&finished, i]() {
+            if (i % 2 == 0) {
+                throw std::runtime_error{"job failed"};
+            }
+            ++finished;
+        }, counter);
+    }
+
+    // Every job still runs to completion, and the failure is reported only once.
+
+    BOOST_CHECK_THROW(jobs.wait(counter), std::runtime_error);
+    BOOST_CHECK(counter.done());
+    BOOST_CHECK_EQUAL(finished.load(), 4);
+
+    jobs.run([&finished]() { ++finished; }, counter);
+    BOOST_CHECK_NO_THROW(jobs.wait(counter));
+    BOOST_CHECK_EQUAL(finished.load(), 5);
+
+    BOOST_CHECK_THROW(jobs.parallelFor(0, 100, 10, [](const std::size_t i) {
+        if (i == 42) {
+            throw std::runtime_error{"call failed"};
+        }
+    }), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(sleeping_workers_wake) {
+
+    Harken::JobSystem jobs{1};
+
+    // Once the worker has had time to go to sleep, it alone must pick up a job submitted from
+    // this thread, since this thread polls the counter rather than waiting on it.
+
+    for (auto round = 0; round < 20; ++round) {
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+
+        Harken::JobCounter counter;
+        jobs.run([]() {}, counter);
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+        while (!counter.done() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+
+        BOOST_REQUIRE(counter.done());
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+#include "harken_lz4.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+using Harken::lz4Compress;
+using Harken::lz4Decompress;
+
+namespace {
+
+    /**
+     * Compresses then decompresses @p data, returning whether it came back unchanged.
+     */
+
+    bool roundTrips(const std::vector<char>& data) {
+
+        const auto compressed = lz4Compress(data.data(), data.size());
+
+        std::vector<char> decompressed(data.size());
+        return lz4Decompress(compressed.data(), compressed.size(), decompressed.data(), decompressed.size())
+            && decompressed == data;
+    }
+
+    std::vector<char> randomBytes(const std::size_t size, const unsigned seed) {
+
+        std::mt19937 generator{seed};
+        std::uniform_int_distribution<int> distribution{0, 255};
+
+        std::vector<char> data(size);
+        for (auto& byte : data) {
+            byte = static_cast<char>(distribution(generator));
+        }
+
+        return data;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(lz4)
+
+BOOST_AUTO_TEST_CASE(round_trips) {
+
+    BOOST_TEST(roundTrips({}));
+    BOOST_TEST(roundTrips({'a'}));
+    BOOST_TEST(roundTrips(std::vector<char>(12, 'a')));
+    BOOST_TEST(roundTrips(std::vector<char>(13, 'a')));
+    BOOST_TEST(roundTrips(std::vector<char>(100000, 'a')));
+    BOOST_TEST(roundTrips(randomBytes(100000, 1)));
+
+    // Repeats further apart than the largest offset a match can have.
+
+    auto data = randomBytes(70000, 2);
+    const auto copy = data;
+    data.insert(data.end(), copy.begin(), copy.end());
+    BOOST_TEST(roundTrips(data));
+}
+
+BOOST_AUTO_TEST_CASE(compresses_repetitive_data) {
+
+    std::string text;
+    for (auto i = 0; i < 1000; ++i) {
+        text += "vec4 colour = texture(sampler, uv);\n";
+    }
+
+    const auto compressed = lz4Compress(text.data(), text.size());
+    BOOST_TEST(compressed.size() < text.size() / 20);
+}
+
+BOOST_AUTO_TEST_CASE(decodes_reference_blocks) {
+
+    // As compressed by the reference implementation: three literals, then a 23-byte match at
+    // offset three, then the last five literals.
+
+    const std::vector<unsigned char> block = {0x3f, 'a', 'b', 'c', 0x03, 0x00, 0x04, 0x50, 'c', 'a', 'b', 'c', '!'};
+    std::string output(31, '\0');
+
+    BOOST_TEST(lz4Decompress(block.data(), block.size(), &output[0], output.size()));
+    BOOST_TEST(output == "abcabcabcabcabcabcabcabcabcabc!");
+}
+
+BOOST_AUTO_TEST_CASE(rejects_invalid_blocks) {
+
+    const auto data = randomBytes(1000, 3);
+    auto compressed = lz4Compress(data.data(), data.size());
+    std::vector<char> output(data.size());
+
+    // Truncated, or decompressing to the wrong size.
+
+    BOOST_TEST(!lz4Decompress(compressed.data(), compressed.size() - 1, output.data(), output.size()));
+    BOOST_TEST(!lz4Decompress(compressed.data(), compressed.size(), output.data(), output.size() - 1));
+    BOOST_TEST(!lz4Decompress(compressed.data(), compressed.size(), output.data(), output.size() + 1));
+
+    // A match reaching back before the start of the output.
+
+    const std::vector<unsigned char> block = {0x10, 'a', 0x02, 0x00};
+    char small[8];
+    BOOST_TEST(!lz4Decompress(block.data(), block.size(), small, sizeof(small)));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,134 @@
+#include "harken_meshoptimizer.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+namespace {
+
+    /**
+     * Generates the indices of a grid of quads, each split into two triangles, with the triangles
+     * emitted in a random (but deterministic) order.
+     */
+
+    std::vector<GLuint> shuffledGrid(const GLuint size) {
+
+        std::vector<std::array<GLuint, 3>> triangles;
+        for (GLuint y = 0; y < size; ++y) {
+            for (GLuint x = 0; x < size; ++x) {
+
+                const auto corner = y * (size + 1) + x;
+                triangles.push_back({{corner, corner + 1, corner + size + 1}});
+                triangles.push_back({{corner + 1, corner + size + 2, corner + size + 1}});
+            }
+        }
+
+        std::mt19937 generator{42};
+        std::shuffle(triangles.begin(), triangles.end(), generator);
+
+        std::vector<GLuint> indices;
+        for (const auto& triangle : triangles) {
+            indices.insert(indices.end(), triangle.begin(), triangle.end());
+        }
+
+        return indices;
+    }
+
+    /**
+     * Gets the triangles of a triangle list in a canonical form, with each triangle rotated so its
+     * smallest index comes first (preserving winding) and the triangles themselves sorted.
+     */
+
+    std::vector<std::array<GLuint, 3>> canonicalTriangles(const std::vector<GLuint>& indices) {
+
+        std::vector<std::array<GLuint, 3>> triangles;
+        for (std::size_t i = 0; i < indices.size(); i += 3) {
+
+            std::array<GLuint, 3> triangle{{indices[i], indices[i + 1], indices[i + 2]}};
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            triangles.push_back(triangle);
+        }
+
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(mesh_optimizer)
+
+BOOST_AUTO_TEST_CASE(cache_miss_ratio) {
+
+    BOOST_CHECK_EQUAL(Harken::averageCacheMissRatio({}, 0), 0.0);
+    BOOST_CHECK_EQUAL(Harken::averageCacheMissRatio({0, 1, 2, 3, 4, 5}, 6), 3.0);
+    BOOST_CHECK_EQUAL(Harken::averageCacheMissRatio({0, 1, 2, 2, 1, 3}, 4), 2.0);
+
+    // With a cache of three vertices, the second triangle here evicts the shared vertex 0 before
+    // the third triangle needs it again.
+
+    const std::vector<GLuint> strip{0, 1, 2, 3, 4, 5, 0, 1, 2};
+    BOOST_CHECK_EQUAL(Harken::averageCacheMissRatio(strip, 6, 3), 3.0);
+    BOOST_CHECK_EQUAL(Harken::averageCacheMissRatio(strip, 6, 6), 2.0);
+}
+
+BOOST_AUTO_TEST_CASE(vertex_cache) {
+
+    const GLuint size = 32;
+    const auto vertexCount = (size + 1) * (size + 1);
+
+    const auto original = shuffledGrid(size);
+    auto optimized = original;
+
+    Harken::optimizeVertexCache(optimized, vertexCount);
+
+    BOOST_CHECK(canonicalTriangles(optimized) == canonicalTriangles(original));
+    BOOST_CHECK_LT(Harken::averageCacheMissRatio(optimized, vertexCount),
+                   Harken::averageCacheMissRatio(original, vertexCount));
+    BOOST_CHECK_LT(Harken::averageCacheMissRatio(optimized, vertexCount), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(vertex_fetch) {
+
+    std::vector<GLuint> indices{4, 2, 0, 2, 4, 3};
+    const auto remap = Harken::optimizeVertexFetch(indices, 6);
+
+    BOOST_CHECK(indices == (std::vector<GLuint>{0, 1, 2, 1, 0, 3}));
+    BOOST_CHECK(remap == (std::vector<GLuint>{2, 4, 1, 3, 0, 5}));
+
+    const std::vector<char> vertices{'a', 'b', 'c', 'd', 'e', 'f'};
+    const auto remapped = Harken::remapVertices(vertices, remap);
+
+    BOOST_CHECK(remapped == (std::vector<char>{'e', 'c', 'a', 'd', 'b', 'f'}));
+}
+
+BOOST_AUTO_TEST_CASE(optimize_mesh) {
+
+    const GLuint size = 16;
+    const auto vertexCount = (size + 1) * (size + 1);
+
+    const auto original = shuffledGrid(size);
+    auto indices = original;
+
+    const auto report = Harken::optimizeMesh(indices, vertexCount);
+
+    BOOST_CHECK_EQUAL(report.acmrBefore, Harken::averageCacheMissRatio(original, vertexCount));
+    BOOST_CHECK_EQUAL(report.acmrAfter, Harken::averageCacheMissRatio(indices, vertexCount));
+    BOOST_CHECK_LT(report.acmrAfter, report.acmrBefore);
+
+    // Undoing the vertex renumbering should give back the original set of triangles.
+
+    std::vector<GLuint> inverse(vertexCount);
+    for (GLuint v = 0; v < vertexCount; ++v) {
+        inverse[report.vertexRemap[v]] = v;
+    }
+
+    for (auto& index : indices) {
+        index = inverse[index];
+    }
+
+    BOOST_CHECK(canonicalTriangles(indices) == canonicalTriangles(original));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
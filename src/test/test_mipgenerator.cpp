@@ -0,0 +1,160 @@
+#include "harken_mipgenerator.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <vector>
+
+using Harken::JobSystem;
+using Harken::MipChain;
+using Harken::MipFilter;
+using Harken::MipGenerator;
+using Harken::MipSettings;
+
+namespace {
+
+    int byteAt(const MipChain& chain, const std::size_t level, const std::size_t index) {
+        return static_cast<unsigned char>(chain.levels[level][index]);
+    }
+
+    std::vector<char> bytes(const std::vector<int>& values) {
+        return std::vector<char>(values.begin(), values.end());
+    }
+
+    /**
+     * A generator, along with the jobs it runs on.
+     */
+
+    struct GeneratorFixture {
+
+        JobSystem jobs{2};
+        MipGenerator generator{jobs};
+    };
+}
+
+BOOST_FIXTURE_TEST_SUITE(mip_generator, GeneratorFixture)
+
+BOOST_AUTO_TEST_CASE(chain_halves_down_to_a_pixel) {
+
+    const auto chain = generator.generate(std::vector<char>(5 * 3 * 4), {5, 3}, MipSettings{});
+
+    BOOST_CHECK_EQUAL(chain.format(), static_cast<GLenum>(GL_RGBA));
+    BOOST_REQUIRE_EQUAL(chain.levels.size(), 3u);
+    BOOST_CHECK_EQUAL(chain.levels[0].size(), 5u * 3 * 4);
+    BOOST_CHECK_EQUAL(chain.levels[1].size(), 2u * 1 * 4);
+    BOOST_CHECK_EQUAL(chain.levels[2].size(), 1u * 1 * 4);
+
+    MipSettings settings;
+    settings.levels = 2;
+
+    BOOST_CHECK_EQUAL(generator.generate(std::vector<char>(5 * 3 * 4), {5, 3}, settings).levels.size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(box_filter_averages) {
+
+    MipSettings settings;
+    settings.channels = 1;
+
+    const auto square = generator.generate(bytes({0, 255, 255, 0}), {2, 2}, settings);
+    BOOST_CHECK_EQUAL(byteAt(square, 1, 0), 128);
+
+    // Halving an odd size weights each pixel by how much of it is covered.
+
+    const auto odd = generator.generate(bytes({0, 0, 255}), {3, 1}, settings);
+    BOOST_CHECK_EQUAL(byteAt(odd, 1, 0), 85);
+}
+
+BOOST_AUTO_TEST_CASE(srgb_colour_is_averaged_linearly) {
+
+    const auto pixels = bytes({0, 0, 0, 0, 255, 255, 255, 255});
+
+    MipSettings settings;
+    const auto linear = generator.generate(pixels, {2, 1}, settings);
+
+    settings.srgb = true;
+    const auto srgb = generator.generate(pixels, {2, 1}, settings);
+
+    BOOST_CHECK_EQUAL(byteAt(linear, 1, 0), 128);
+    BOOST_CHECK_EQUAL(byteAt(srgb, 1, 0), 188);
+
+    // Alpha is linear either way.
+
+    BOOST_CHECK_EQUAL(byteAt(srgb, 1, 3), 128);
+}
+
+BOOST_AUTO_TEST_CASE(kaiser_filter_preserves_flat_images) {
+
+    MipSettings settings;
+    settings.srgb = true;
+    settings.filter = MipFilter::Kaiser;
+
+    const auto chain = generator.generate(std::vector<char>(37 * 16 * 4, 77), {37, 16}, settings);
+
+    for (std::size_t level = 1; level < chain.levels.size(); ++level) {
+        for (std::size_t i = 0; i < chain.levels[level].size(); ++i) {
+            BOOST_REQUIRE_EQUAL(byteAt(chain, level, i), 77);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(channels_keep_their_own_values) {
+
+    // Three channels don't line up with four-value registers, so each register starts on a
+    // different channel.
+
+    MipSettings settings;
+    settings.channels = 3;
+    settings.srgb = true;
+    settings.filter = MipFilter::Kaiser;
+
+    std::vector<char> pixels(41 * 23 * 3);
+    for (std::size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = static_cast<char>(50 + i % 3 * 60);
+    }
+
+    const auto chain = generator.generate(pixels, {41, 23}, settings);
+
+    for (std::size_t level = 1; level < chain.levels.size(); ++level) {
+        for (std::size_t i = 0; i < chain.levels[level].size(); ++i) {
+            BOOST_REQUIRE_EQUAL(byteAt(chain, level, i), static_cast<int>(50 + i % 3 * 60));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(kaiser_filter_removes_fine_detail) {
+
+    MipSettings settings;
+    settings.channels = 1;
+    settings.filter = MipFilter::Kaiser;
+
+    std::vector<char> stripes(32 * 32);
+    for (std::size_t i = 0; i < stripes.size(); ++i) {
+        stripes[i] = static_cast<char>(i % 2 == 0 ? 0 : 255);
+    }
+
+    const auto chain = generator.generate(stripes, {32, 32}, settings);
+
+    // The edges are clamped, which unbalances the filter there, so only the interior is even.
+
+    for (std::size_t row = 0; row < 16; ++row) {
+        for (std::size_t column = 3; column < 13; ++column) {
+            BOOST_REQUIRE_LE(std::abs(byteAt(chain, 1, row * 16 + column) - 128), 2);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(channels_are_converted) {
+
+    const auto rgb = bytes({10, 20, 30, 40, 50, 60});
+
+    const auto rgba = Harken::convertChannels(rgb.data(), {2, 1}, 3, 4);
+    BOOST_CHECK(rgba == bytes({10, 20, 30, 255, 40, 50, 60, 255}));
+
+    const auto rg = Harken::convertChannels(rgba.data(), {2, 1}, 4, 2);
+    BOOST_CHECK(rg == bytes({10, 20, 40, 50}));
+
+    const auto red = Harken::convertChannels(rgb.data(), {2, 1}, 3, 1);
+    BOOST_CHECK(red == bytes({10, 40}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
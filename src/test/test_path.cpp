@@ -0,0 +1,18 @@
+#include "harken_path.h"
+
+#include <boost/test/unit_test.hpp>
+
+using Harken::directoryOf;
+
+BOOST_AUTO_TEST_SUITE(path)
+
+BOOST_AUTO_TEST_CASE(directory_of) {
+
+    BOOST_CHECK_EQUAL(directoryOf("shaders/lighting/common.glsl"), "shaders/lighting/");
+    BOOST_CHECK_EQUAL(directoryOf("/common.glsl"), "/");
+    BOOST_CHECK_EQUAL(directoryOf("shaders/"), "shaders/");
+    BOOST_CHECK_EQUAL(directoryOf("common.glsl"), "");
+    BOOST_CHECK_EQUAL(directoryOf(""), "");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,69 @@
+#include "harken_renderqueue.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using Harken::RenderQueueEntry;
+
+BOOST_AUTO_TEST_SUITE(render_queue)
+
+BOOST_AUTO_TEST_CASE(key_order) {
+
+    // Program outranks vertex array, which outranks material, which outranks depth.
+
+    BOOST_CHECK_LT(Harken::makeRenderKey(1, 9, 9, 1.0f), Harken::makeRenderKey(2, 0, 0, 0.0f));
+    BOOST_CHECK_LT(Harken::makeRenderKey(1, 1, 9, 1.0f), Harken::makeRenderKey(1, 2, 0, 0.0f));
+    BOOST_CHECK_LT(Harken::makeRenderKey(1, 1, 1, 1.0f), Harken::makeRenderKey(1, 1, 2, 0.0f));
+    BOOST_CHECK_LT(Harken::makeRenderKey(1, 1, 1, 0.25f), Harken::makeRenderKey(1, 1, 1, 0.5f));
+
+    BOOST_CHECK_EQUAL(Harken::makeRenderKey(0, 0, 0, -1.0f), Harken::makeRenderKey(0, 0, 0, 0.0f));
+    BOOST_CHECK_EQUAL(Harken::makeRenderKey(0, 0, 0, 2.0f), Harken::makeRenderKey(0, 0, 0, 1.0f));
+    BOOST_CHECK_EQUAL(Harken::makeRenderKey(0x12345, 0, 0, 0.0f), Harken::makeRenderKey(0x2345, 0, 0, 0.0f));
+}
+
+BOOST_AUTO_TEST_CASE(radix_sort) {
+
+    std::mt19937 generator{7};
+    std::uniform_int_distribution<GLuint> programs{1, 4};
+    std::uniform_int_distribution<GLuint> vertexArrays{1, 50};
+    std::uniform_int_distribution<std::uint16_t> materials{0, 20};
+    std::uniform_real_distribution<float> depths{0.0f, 1.0f};
+
+    std::vector<RenderQueueEntry> entries;
+    for (std::uint32_t i = 0; i < 5000; ++i) {
+        const auto key = Harken::makeRenderKey(programs(generator), vertexArrays(generator),
+                                               materials(generator), depths(generator));
+        entries.push_back(RenderQueueEntry{key, i});
+    }
+
+    auto expected = entries;
+    std::stable_sort(expected.begin(), expected.end(), [](const RenderQueueEntry& lhs, const RenderQueueEntry& rhs) {
+        return lhs.key < rhs.key;
+    });
+
+    std::vector<RenderQueueEntry> scratch;
+    Harken::sortRenderQueueEntries(entries, scratch);
+
+    BOOST_REQUIRE_EQUAL(entries.size(), expected.size());
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        BOOST_CHECK_EQUAL(entries[i].key, expected[i].key);
+        BOOST_CHECK_EQUAL(entries[i].index, expected[i].index);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(radix_sort_uniform_keys) {
+
+    std::vector<RenderQueueEntry> entries{{5, 0}, {5, 1}, {5, 2}};
+    std::vector<RenderQueueEntry> scratch;
+
+    Harken::sortRenderQueueEntries(entries, scratch);
+
+    BOOST_CHECK_EQUAL(entries[0].index, 0u);
+    BOOST_CHECK_EQUAL(entries[1].index, 1u);
+    BOOST_CHECK_EQUAL(entries[2].index, 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
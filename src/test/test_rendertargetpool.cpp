@@ -0,0 +1,150 @@
+#include "harken_rendertargetpool.h"
+
+#include <boost/test/unit_test.hpp>
+
+using Harken::RenderTargetDesc;
+using Harken::Size2;
+
+namespace {
+
+    /**
+     * Stands in for a RenderTarget, so that the pool's bookkeeping can be tested without an
+     * OpenGL context.
+     */
+
+    class FakeTarget {
+    public:
+
+        explicit FakeTarget(const RenderTargetDesc& desc)
+            : m_desc(desc) {
+        }
+
+        const RenderTargetDesc& desc() const {
+            return m_desc;
+        }
+
+    private:
+
+        RenderTargetDesc m_desc;
+    };
+
+    using FakePool = Harken::BasicRenderTargetPool<FakeTarget>;
+
+    RenderTargetDesc colorDesc(const int width, const int height) {
+
+        RenderTargetDesc desc;
+        desc.size = Size2<int>{width, height};
+        return desc;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(render_target_pool)
+
+BOOST_AUTO_TEST_CASE(bytes_per_pixel) {
+
+    BOOST_CHECK_EQUAL(Harken::bytesPerPixel(GL_R8), 1u);
+    BOOST_CHECK_EQUAL(Harken::bytesPerPixel(GL_RGBA8), 4u);
+    BOOST_CHECK_EQUAL(Harken::bytesPerPixel(GL_RGB8), 4u);
+    BOOST_CHECK_EQUAL(Harken::bytesPerPixel(GL_RGBA16F), 8u);
+    BOOST_CHECK_EQUAL(Harken::bytesPerPixel(GL_RGBA32F), 16u);
+    BOOST_CHECK_EQUAL(Harken::bytesPerPixel(GL_DEPTH24_STENCIL8), 4u);
+    BOOST_CHECK_EQUAL(Harken::bytesPerPixel(GL_NONE), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(desc_identity) {
+
+    RenderTargetDesc a;
+    a.size = Size2<int>{1920, 1080};
+    a.depthFormat = GL_DEPTH24_STENCIL8;
+
+    auto b = a;
+    BOOST_CHECK(a == b);
+    BOOST_CHECK_EQUAL(a.hash(), b.hash());
+
+    b.size = Size2<int>{1080, 1920};
+    BOOST_CHECK(a != b);
+
+    b = a;
+    b.samples = 4;
+    BOOST_CHECK(a != b);
+
+    b = a;
+    b.colorFormat = GL_RGBA16F;
+    BOOST_CHECK(a != b);
+}
+
+BOOST_AUTO_TEST_CASE(estimated_bytes) {
+
+    RenderTargetDesc desc;
+    desc.size = Size2<int>{100, 50};
+    BOOST_CHECK_EQUAL(desc.estimatedBytes(), 100u * 50u * 4u);
+
+    desc.depthFormat = GL_DEPTH32F_STENCIL8;
+    desc.samples = 4;
+    BOOST_CHECK_EQUAL(desc.estimatedBytes(), 100u * 50u * 4u * (4u + 8u));
+}
+
+BOOST_AUTO_TEST_CASE(acquire_and_release) {
+
+    FakePool pool;
+    const auto desc = colorDesc(64, 32);
+
+    auto& first = pool.acquire(desc);
+    auto& second = pool.acquire(desc);
+
+    // A target that is still acquired is never handed out twice.
+
+    BOOST_CHECK(&first != &second);
+    BOOST_CHECK_EQUAL(pool.size(), 2u);
+    BOOST_CHECK_EQUAL(pool.stats().created, 2u);
+    BOOST_CHECK_EQUAL(pool.stats().liveBytes, 2 * desc.estimatedBytes());
+
+    pool.release(first);
+    BOOST_CHECK(&pool.acquire(desc) == &first);
+    BOOST_CHECK_EQUAL(pool.stats().reused, 1u);
+
+    // An idle target of a different description is not reused.
+
+    pool.release(second);
+    auto& other = pool.acquire(colorDesc(32, 64));
+    BOOST_CHECK(&other != &second);
+    BOOST_CHECK_EQUAL(pool.size(), 3u);
+    BOOST_CHECK_EQUAL(pool.stats().created, 3u);
+}
+
+BOOST_AUTO_TEST_CASE(idle_eviction) {
+
+    FakePool pool{2};
+    const auto kept = colorDesc(64, 64);
+    const auto dropped = colorDesc(128, 128);
+
+    auto& keptTarget = pool.acquire(kept);
+    pool.release(pool.acquire(dropped));
+
+    // Targets survive as many whole idle frames as allowed; one that is still acquired survives
+    // indefinitely.
+
+    for (auto frame = 0; frame < 2; ++frame) {
+        pool.endFrame();
+        BOOST_CHECK_EQUAL(pool.size(), 2u);
+    }
+
+    pool.endFrame();
+    BOOST_CHECK_EQUAL(pool.size(), 1u);
+    BOOST_CHECK_EQUAL(pool.stats().destroyed, 1u);
+    BOOST_CHECK_EQUAL(pool.stats().liveBytes, kept.estimatedBytes());
+
+    // Releasing a target restarts its idle count from the current frame.
+
+    pool.release(keptTarget);
+    pool.endFrame();
+    pool.endFrame();
+    BOOST_CHECK(&pool.acquire(kept) == &keptTarget);
+
+    pool.clear();
+    BOOST_CHECK_EQUAL(pool.size(), 0u);
+    BOOST_CHECK_EQUAL(pool.stats().destroyed, 2u);
+    BOOST_CHECK_EQUAL(pool.stats().liveBytes, 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
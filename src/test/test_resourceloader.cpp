@@ -0,0 +1,171 @@
+#include "harken_jobsystem.h"
+#include "harken_resourceloader.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using Harken::JobSystem;
+using Harken::LoadStatus;
+using Harken::ResourceLoader;
+
+namespace {
+
+    /**
+     * A context that does nothing, since nothing the tests upload needs OpenGL.
+     */
+
+    class NullContext : public Harken::SharedGLContext {
+    public:
+
+        void makeCurrent() override {
+        }
+
+        void releaseCurrent() override {
+        }
+    };
+
+    /**
+     * Fences whose outcome the test decides. Each fence is numbered in the order it was
+     * inserted, starting from one.
+     */
+
+    class ScriptedFences : public Harken::UploadFences {
+    public:
+
+        GLsync insert() override {
+
+            if (failInsert) {
+                return nullptr;
+            }
+
+            return reinterpret_cast<GLsync>(static_cast<std::uintptr_t>(++inserted));
+        }
+
+        GLenum poll(GLsync) override {
+            return result;
+        }
+
+        void remove(GLsync) override {
+            ++removed;
+        }
+
+        std::atomic<bool> failInsert{false};
+        std::atomic<GLenum> result{GL_TIMEOUT_EXPIRED};
+        std::atomic<int> inserted{0};
+        std::atomic<int> removed{0};
+    };
+
+    /**
+     * A loader whose fences are scripted by the test, along with the job system it needs.
+     */
+
+    struct LoaderFixture {
+
+        LoaderFixture()
+            : jobs{1}, fencesOwned{std::make_unique<ScriptedFences>()}, fences{*fencesOwned},
+              loader{std::make_unique<ResourceLoader>(jobs, std::make_unique<NullContext>(), std::move(fencesOwned))} {
+        }
+
+        /**
+         * Calls update() until @p count fences have been inserted, which happens once the loads
+         * that they follow have been prepared and uploaded.
+         */
+
+        void waitForFences(const int count) {
+            while (fences.inserted < count) {
+                loader->update();
+                std::this_thread::yield();
+            }
+        }
+
+        JobSystem jobs;
+        std::unique_ptr<ScriptedFences> fencesOwned;
+        ScriptedFences& fences;
+        std::unique_ptr<ResourceLoader> loader;
+    };
+}
+
+BOOST_FIXTURE_TEST_SUITE(resource_loader, LoaderFixture)
+
+BOOST_AUTO_TEST_CASE(hands_over_once_fence_passes) {
+
+    const auto resource = loader->load([]() { return 20; }, [](const int value) { return std::to_string(value + 1); });
+    BOOST_CHECK(resource->status() == LoadStatus::Pending);
+    BOOST_CHECK_EQUAL(loader->pending(), 1u);
+
+    waitForFences(1);
+
+    // The upload has been carried out, but not yet reached the GPU.
+
+    BOOST_CHECK_EQUAL(loader->update(), 0u);
+    BOOST_CHECK(resource->status() == LoadStatus::Pending);
+
+    fences.result = GL_ALREADY_SIGNALED;
+    BOOST_CHECK_EQUAL(loader->update(), 1u);
+    BOOST_CHECK(resource->ready());
+    BOOST_CHECK_EQUAL(resource->get(), "21");
+    BOOST_CHECK_EQUAL(fences.removed.load(), 1);
+    BOOST_CHECK_EQUAL(loader->pending(), 0u);
+    BOOST_CHECK_EQUAL(loader->update(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(exceptions_fail_loads) {
+
+    fences.result = GL_CONDITION_SATISFIED;
+
+    const auto prepareThrows = loader->load([]() -> int { throw std::runtime_error{"prepare"}; }, [](int) { return 0; });
+    const auto prepareThrowsOther = loader->load([]() -> int { throw 1; }, [](int) { return 0; });
+    const auto uploadThrows = loader->load([]() { return 0; }, [](int) -> int { throw std::runtime_error{"upload"}; });
+    const auto uploadThrowsOther = loader->load([]() { return 0; }, [](int) -> int { throw 1; });
+
+    loader->finish();
+
+    BOOST_CHECK(prepareThrows->status() == LoadStatus::Failed);
+    BOOST_CHECK_EQUAL(prepareThrows->error(), "prepare");
+    BOOST_CHECK(prepareThrowsOther->status() == LoadStatus::Failed);
+    BOOST_CHECK(!prepareThrowsOther->error().empty());
+    BOOST_CHECK(uploadThrows->status() == LoadStatus::Failed);
+    BOOST_CHECK_EQUAL(uploadThrows->error(), "upload");
+    BOOST_CHECK(uploadThrowsOther->status() == LoadStatus::Failed);
+    BOOST_CHECK(!uploadThrowsOther->error().empty());
+
+    // Failed uploads never insert fences.
+
+    BOOST_CHECK_EQUAL(fences.inserted.load(), 0);
+    BOOST_CHECK_EQUAL(loader->pending(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(fence_failures_fail_loads) {
+
+    fences.failInsert = true;
+    const auto unfenced = loader->load([]() { return 0; }, [](int) { return 0; });
+    loader->finish();
+
+    BOOST_CHECK(unfenced->status() == LoadStatus::Failed);
+
+    fences.failInsert = false;
+    fences.result = GL_WAIT_FAILED;
+    const auto unwaitable = loader->load([]() { return 0; }, [](int) { return 0; });
+    loader->finish();
+
+    BOOST_CHECK(unwaitable->status() == LoadStatus::Failed);
+    BOOST_CHECK_EQUAL(fences.removed.load(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(destruction_removes_outstanding_fences) {
+
+    const auto resource = loader->load([]() { return 0; }, [](int) { return 0; });
+    waitForFences(1);
+    loader.reset();
+
+    BOOST_CHECK(resource->status() == LoadStatus::Pending);
+    BOOST_CHECK_EQUAL(fences.removed.load(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
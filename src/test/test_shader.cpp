@@ -0,0 +1,37 @@
+#include "harken_shader.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using Harken::insertDefines;
+using Harken::ShaderDefines;
+
+BOOST_AUTO_TEST_SUITE(shader)
+
+BOOST_AUTO_TEST_CASE(defines_follow_version) {
+
+    const std::string text = "// Comment\n#version 330 core\nvoid main() {}\n";
+    const ShaderDefines defines = {{"LIGHTS", "4"}, {"SHADOWS", ""}};
+
+    BOOST_CHECK_EQUAL(insertDefines(text, defines),
+                      "// Comment\n#version 330 core\n"
+                      "#define LIGHTS 4\n#define SHADOWS \n#line 3\n"
+                      "void main() {}\n");
+}
+
+BOOST_AUTO_TEST_CASE(defines_without_version) {
+
+    BOOST_CHECK_EQUAL(insertDefines("void main() {}\n", {{"A", "1"}}),
+                      "#define A 1\n#line 1\nvoid main() {}\n");
+
+    BOOST_CHECK_EQUAL(insertDefines("#version 330", {{"A", "1"}}),
+                      "#version 330\n#define A 1\n#line 2\n");
+}
+
+BOOST_AUTO_TEST_CASE(no_defines) {
+    const std::string text = "#version 330 core\nvoid main() {}\n";
+    BOOST_CHECK_EQUAL(insertDefines(text, {}), text);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,67 @@
+#include "harken_shaderlibrary.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_temporarydirectory.h"
+
+using Harken::ShaderLibrary;
+using Harken::ShaderPermutations;
+using HarkenTest::TemporaryDirectory;
+
+namespace {
+
+    const char * const ShaderSource = "#version 330 core\nvoid main() {}\n";
+}
+
+BOOST_AUTO_TEST_SUITE(shader_library)
+
+BOOST_AUTO_TEST_CASE(sources_are_interned) {
+
+    const TemporaryDirectory directory;
+    const auto path = directory.write("shader.vert", ShaderSource);
+    ShaderLibrary library;
+
+    const auto& plain = library.source(GL_VERTEX_SHADER, path);
+    BOOST_CHECK_EQUAL(&library.source(GL_VERTEX_SHADER, path), &plain);
+    BOOST_CHECK(plain.defines.empty());
+
+    // Definitions given in a different order are the same definitions.
+
+    const auto& defined = library.source(GL_VERTEX_SHADER, path, {{"B", "2"}, {"A", "1"}});
+    BOOST_CHECK_NE(&defined, &plain);
+    BOOST_CHECK_EQUAL(&library.source(GL_VERTEX_SHADER, path, {{"A", "1"}, {"B", "2"}}), &defined);
+    BOOST_CHECK_EQUAL(defined.defines.front().first, "A");
+    BOOST_CHECK_EQUAL(defined.text, "#version 330 core\n#define A 1\n#define B 2\n#line 2\nvoid main() {}\n");
+
+    BOOST_CHECK_NE(&library.source(GL_FRAGMENT_SHADER, path), &plain);
+
+    BOOST_CHECK_EQUAL(library.stats().sourcesLoaded, 3u);
+    BOOST_CHECK_EQUAL(library.stats().shadersCompiled, 0u);
+    BOOST_CHECK_EQUAL(library.size(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(permutations) {
+
+    const TemporaryDirectory directory;
+    const auto path = directory.write("shader.frag", ShaderSource);
+    ShaderLibrary library;
+    ShaderPermutations permutations{library, GL_FRAGMENT_SHADER, path, {"FOG", "SHADOWS"}, {{"LIGHTS", "4"}}};
+
+    BOOST_CHECK_EQUAL(permutations.feature("SHADOWS"), 2u);
+    BOOST_CHECK_EQUAL(permutations.feature("NONE"), 0u);
+
+    const auto& both = permutations.source(3);
+    BOOST_CHECK_EQUAL(&permutations.source(3), &both);
+    BOOST_CHECK_EQUAL(&library.source(GL_FRAGMENT_SHADER, path, {{"SHADOWS", "1"}, {"LIGHTS", "4"}, {"FOG", "1"}}), &both);
+    BOOST_CHECK_NE(permutations.source(1).hash, both.hash);
+
+    BOOST_CHECK_EQUAL(library.stats().sourcesLoaded, 2u);
+
+    // Invalidating the file discards every permutation assembled from it.
+
+    library.invalidate(path);
+    permutations.source(3);
+    BOOST_CHECK_EQUAL(library.stats().sourcesLoaded, 3u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
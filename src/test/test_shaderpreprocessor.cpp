@@ -0,0 +1,103 @@
+#include "harken_exception.h"
+#include "harken_shaderpreprocessor.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include "test_temporarydirectory.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using Harken::ShaderDefines;
+using Harken::ShaderPreprocessor;
+using Harken::ShaderPreprocessorException;
+using HarkenTest::TemporaryDirectory;
+
+BOOST_AUTO_TEST_SUITE(shader_preprocessor)
+
+BOOST_AUTO_TEST_CASE(includes) {
+
+    const TemporaryDirectory directory;
+    const auto include = directory.makeDirectory("include");
+    const auto common = directory.write("include/common.glsl", "float twice(float x) { return 2.0 * x; }\n");
+    const auto lighting = directory.write("lighting.glsl", "#include \"common.glsl\"\nfloat light() { return twice(0.5); }");
+    const auto main = directory.write("main.frag",
+                                      "#version 330 core\n"
+                                      "  #  include \"lighting.glsl\"\n"
+                                      "out vec4 colour;\n"
+                                      "void main() { colour = vec4(light()); }\n");
+
+    ShaderPreprocessor preprocessor{{include}};
+    const auto source = preprocessor.process(GL_FRAGMENT_SHADER, main, {{"QUALITY", "2"}});
+
+    BOOST_CHECK_EQUAL(source.text,
+                      "#version 330 core\n"
+                      "#define QUALITY 2\n"
+                      "#line 2\n"
+                      "#line 1 1\n"
+                      "#line 1 2\n"
+                      "float twice(float x) { return 2.0 * x; }\n"
+                      "#line 2 1\n"
+                      "float light() { return twice(0.5); }\n"
+                      "#line 3 0\n"
+                      "out vec4 colour;\n"
+                      "void main() { colour = vec4(light()); }\n");
+
+    const std::vector<std::string> files = {main, lighting, common};
+    BOOST_CHECK(source.files == files);
+    BOOST_CHECK_EQUAL(source.path, main);
+    BOOST_CHECK_EQUAL(source.hash, Harken::shaderContentHash(GL_FRAGMENT_SHADER, source.text));
+}
+
+BOOST_AUTO_TEST_CASE(content_hash) {
+
+    const TemporaryDirectory directory;
+    const auto main = directory.write("hash.vert", "#version 330 core\nvoid main() {}\n");
+    ShaderPreprocessor preprocessor;
+
+    const auto plain = preprocessor.process(GL_VERTEX_SHADER, main);
+    const auto defined = preprocessor.process(GL_VERTEX_SHADER, main, {{"B", ""}, {"A", ""}});
+    const auto reordered = preprocessor.process(GL_VERTEX_SHADER, main, {{"A", ""}, {"B", ""}});
+
+    BOOST_CHECK_NE(plain.hash, defined.hash);
+    BOOST_CHECK_EQUAL(defined.hash, reordered.hash);
+    BOOST_CHECK_NE(plain.hash, preprocessor.process(GL_FRAGMENT_SHADER, main).hash);
+
+    // Cached contents are used until invalidated.
+
+    {
+        std::ofstream file{main};
+        file << "#version 330 core\nvoid main() { }\n";
+    }
+
+    BOOST_CHECK_EQUAL(preprocessor.process(GL_VERTEX_SHADER, main).hash, plain.hash);
+
+    preprocessor.invalidate(main);
+    BOOST_CHECK_NE(preprocessor.process(GL_VERTEX_SHADER, main).hash, plain.hash);
+}
+
+BOOST_AUTO_TEST_CASE(errors) {
+
+    const TemporaryDirectory directory;
+    const auto a = directory.write("a.glsl", "#include \"b.glsl\"\n");
+    directory.write("b.glsl", "#include \"a.glsl\"\n");
+    const auto malformed = directory.write("malformed.glsl", "#include a.glsl\n");
+    const auto missing = directory.write("missing.glsl", "#include \"nonexistent.glsl\"\n");
+
+    ShaderPreprocessor preprocessor;
+
+    BOOST_CHECK_THROW(preprocessor.process(GL_VERTEX_SHADER, a), ShaderPreprocessorException);
+    BOOST_CHECK_THROW(preprocessor.process(GL_VERTEX_SHADER, malformed), ShaderPreprocessorException);
+    BOOST_CHECK_THROW(preprocessor.process(GL_VERTEX_SHADER, missing), Harken::IOException);
+}
+
+BOOST_AUTO_TEST_CASE(permutation_defines) {
+
+    const std::vector<std::string> features = {"NORMAL_MAP", "SKINNED", "FOG"};
+
+    BOOST_CHECK(Harken::permutationDefines(features, 0).empty());
+    BOOST_CHECK(Harken::permutationDefines(features, 5) == (ShaderDefines{{"NORMAL_MAP", "1"}, {"FOG", "1"}}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
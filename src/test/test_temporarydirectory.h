@@ -0,0 +1,106 @@
+#ifndef HARKEN_TEST_TEMPORARYDIRECTORY_H
+#define HARKEN_TEST_TEMPORARYDIRECTORY_H
+
+#include <ftw.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace HarkenTest {
+
+    /**
+     * A directory with a unique name under the system's temporary directory, removed along with
+     * everything in it when the TemporaryDirectory is destroyed. Tests that need files create them
+     * in one of these, so that they can neither collide with other tests (or other runs of the
+     * same test) nor leave anything behind.
+     */
+
+    class TemporaryDirectory {
+    public:
+
+        /**
+         * Creates the directory. Throws a <tt>std::runtime_error</tt> if it cannot be created.
+         */
+
+        TemporaryDirectory() {
+
+            const auto base = std::getenv("TMPDIR");
+            const std::string pattern = std::string{base && *base ? base : "/tmp"} + "/harken-test-XXXXXX";
+
+            std::vector<char> name(pattern.begin(), pattern.end());
+            name.push_back('\0');
+
+            if (!mkdtemp(name.data())) {
+                throw std::runtime_error{"Could not create a temporary directory from " + pattern + "."};
+            }
+
+            m_path = name.data();
+        }
+
+        ~TemporaryDirectory() {
+
+            // Files are visited before the directories containing them, so each directory is
+            // empty by the time it is removed.
+
+            nftw(m_path.c_str(), [](const char * const path, const struct stat *, int, struct FTW *) {
+                return std::remove(path);
+            }, 16, FTW_DEPTH | FTW_PHYS);
+        }
+
+        TemporaryDirectory(const TemporaryDirectory&) = delete;
+        TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+
+        /**
+         * Gets the path of @p name within the directory. Nothing is created.
+         */
+
+        std::string file(const std::string& name) const {
+            return m_path + "/" + name;
+        }
+
+        /**
+         * Creates the subdirectory @p name, returning its path.
+         */
+
+        std::string makeDirectory(const std::string& name) const {
+
+            const auto path = file(name);
+            mkdir(path.c_str(), 0755);
+
+            return path;
+        }
+
+        /**
+         * Gets the path of the directory.
+         */
+
+        const std::string& path() const {
+            return m_path;
+        }
+
+        /**
+         * Writes @p contents to the file @p name, replacing anything already there, and returns
+         * the file's path.
+         */
+
+        std::string write(const std::string& name, const std::string& contents) const {
+
+            const auto path = file(name);
+            std::ofstream{path, std::ios::binary} << contents;
+
+            return path;
+        }
+
+    private:
+
+        std::string m_path;
+    };
+}
+
+#endif
@@ -0,0 +1,74 @@
+#include "harken_texture.h"
+#include "harken_textureuploader.h"
+
+#include <boost/test/unit_test.hpp>
+
+using Harken::mipLevelCount;
+using Harken::mipLevelSize;
+using Harken::pixelSize;
+using Harken::Size2;
+using Harken::TextureException;
+using Harken::uploadRowSize;
+
+namespace {
+
+    bool hasSize(const Size2<int> size, const int width, const int height) {
+        return size.width() == width && size.height() == height;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(texture)
+
+BOOST_AUTO_TEST_CASE(mip_level_count_reaches_a_single_pixel) {
+    BOOST_CHECK_EQUAL(mipLevelCount({1, 1}), 1);
+    BOOST_CHECK_EQUAL(mipLevelCount({256, 256}), 9);
+    BOOST_CHECK_EQUAL(mipLevelCount({256, 16}), 9);
+    BOOST_CHECK_EQUAL(mipLevelCount({300, 200}), 9);
+}
+
+BOOST_AUTO_TEST_CASE(mip_level_size_halves_without_vanishing) {
+
+    const Size2<int> size{300, 20};
+
+    BOOST_CHECK(hasSize(mipLevelSize(size, 0), 300, 20));
+    BOOST_CHECK(hasSize(mipLevelSize(size, 1), 150, 10));
+    BOOST_CHECK(hasSize(mipLevelSize(size, 3), 37, 2));
+    BOOST_CHECK(hasSize(mipLevelSize(size, 5), 9, 1));
+    BOOST_CHECK(hasSize(mipLevelSize(size, 8), 1, 1));
+}
+
+BOOST_AUTO_TEST_CASE(pixel_size_counts_components) {
+    BOOST_CHECK_EQUAL(pixelSize(GL_RED, GL_UNSIGNED_BYTE), 1u);
+    BOOST_CHECK_EQUAL(pixelSize(GL_RGB, GL_UNSIGNED_BYTE), 3u);
+    BOOST_CHECK_EQUAL(pixelSize(GL_BGRA, GL_UNSIGNED_BYTE), 4u);
+    BOOST_CHECK_EQUAL(pixelSize(GL_RG, GL_HALF_FLOAT), 4u);
+    BOOST_CHECK_EQUAL(pixelSize(GL_RGBA, GL_FLOAT), 16u);
+}
+
+BOOST_AUTO_TEST_CASE(pixel_size_of_packed_types_ignores_components) {
+    BOOST_CHECK_EQUAL(pixelSize(GL_RGB, GL_UNSIGNED_SHORT_5_6_5), 2u);
+    BOOST_CHECK_EQUAL(pixelSize(GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV), 4u);
+    BOOST_CHECK_EQUAL(pixelSize(GL_DEPTH_STENCIL, GL_FLOAT_32_UNSIGNED_INT_24_8_REV), 8u);
+}
+
+BOOST_AUTO_TEST_CASE(pixel_size_rejects_unsupported_combinations) {
+    BOOST_CHECK_THROW(pixelSize(GL_RGBA, GL_DOUBLE), TextureException);
+    BOOST_CHECK_THROW(pixelSize(GL_DEPTH_STENCIL, GL_UNSIGNED_BYTE), TextureException);
+}
+
+BOOST_AUTO_TEST_CASE(upload_row_size_validates_regions) {
+
+    BOOST_CHECK_EQUAL(uploadRowSize({10, 4}, GL_RGBA, GL_UNSIGNED_BYTE, 160, 40), 40u);
+
+    // Empty regions have nothing to upload, so are reported as such rather than queued.
+
+    BOOST_CHECK_EQUAL(uploadRowSize({0, 4}, GL_RGBA, GL_UNSIGNED_BYTE, 0, 40), 0u);
+    BOOST_CHECK_EQUAL(uploadRowSize({10, 0}, GL_RGBA, GL_UNSIGNED_BYTE, 0, 40), 0u);
+    BOOST_CHECK_THROW(uploadRowSize({0, 4}, GL_RGBA, GL_UNSIGNED_BYTE, 4, 40), TextureException);
+
+    BOOST_CHECK_THROW(uploadRowSize({10, 4}, GL_RGBA, GL_UNSIGNED_BYTE, 159, 40), TextureException);
+    BOOST_CHECK_THROW(uploadRowSize({10, 4}, GL_RGBA, GL_UNSIGNED_BYTE, 160, 39), TextureException);
+    BOOST_CHECK_THROW(uploadRowSize({-1, 4}, GL_RGBA, GL_UNSIGNED_BYTE, 0, 40), TextureException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+#include "harken_triplebuffer.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <thread>
+
+namespace {
+
+    /**
+     * A value whose fields are always written together, so that a torn read would show up as a
+     * mismatch between them.
+     */
+
+    struct Pair {
+        long first;
+        long second;
+    };
+}
+
+BOOST_AUTO_TEST_SUITE(triple_buffer)
+
+BOOST_AUTO_TEST_CASE(single_thread) {
+
+    Harken::TripleBuffer<int> buffer{7};
+
+    BOOST_CHECK(!buffer.update());
+    BOOST_CHECK_EQUAL(buffer.front(), 7);
+
+    buffer.back() = 1;
+    buffer.publish();
+    buffer.back() = 2;
+    buffer.publish();
+
+    // Only the newest value is observed; the intermediate one is skipped.
+
+    BOOST_CHECK(buffer.update());
+    BOOST_CHECK_EQUAL(buffer.front(), 2);
+    BOOST_CHECK(!buffer.update());
+    BOOST_CHECK_EQUAL(buffer.front(), 2);
+
+    buffer.back() = 3;
+    buffer.publish();
+
+    BOOST_CHECK(buffer.update());
+    BOOST_CHECK_EQUAL(buffer.front(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent) {
+
+    constexpr long ValueCount = 200000;
+
+    Harken::TripleBuffer<Pair> buffer{Pair{0, 0}};
+    std::atomic<bool> done{false};
+
+    std::thread producer{[&buffer, &done]() {
+
+        for (long i = 1; i <= ValueCount; ++i) {
+            buffer.back() = Pair{i, -i};
+            buffer.publish();
+        }
+
+        done = true;
+    }};
+
+    auto last = 0L;
+    auto consistent = true;
+    auto monotonic = true;
+
+    while (!done || buffer.update()) {
+
+        buffer.update();
+
+        const auto value = buffer.front();
+        consistent = consistent && value.first == -value.second;
+        monotonic = monotonic && value.first >= last;
+        last = value.first;
+    }
+
+    producer.join();
+
+    BOOST_CHECK(consistent);
+    BOOST_CHECK(monotonic);
+    BOOST_CHECK_EQUAL(buffer.front().first, ValueCount);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
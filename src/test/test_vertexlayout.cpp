@@ -0,0 +1,95 @@
+#include "harken_glmath.h"
+#include "harken_instancebuffer.h"
+#include "harken_vector.h"
+#include "harken_vertexlayout.h"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+
+using Harken::Vector2f;
+using Harken::Vector3f;
+using Harken::Vector4;
+using Harken::VertexAttribute;
+using Harken::VertexAttributeFormat;
+using Harken::VertexLayout;
+
+using Vector4ub = Vector4<GLubyte>;
+using Vector3s  = Harken::Vector3<GLshort>;
+
+using PositionLayout = VertexLayout<VertexAttribute<Vector3f>>;
+using MeshLayout     = VertexLayout<VertexAttribute<Vector3f>,
+                                    VertexAttribute<Vector3s, true>,
+                                    VertexAttribute<Vector2f>>;
+
+static_assert(PositionLayout::stride() == 12, "Tightly packed layouts should have no padding.");
+static_assert(MeshLayout::offset(1) == 12, "Attribute offsets should be computed at compile time.");
+static_assert(MeshLayout::offset(2) == 20, "Attribute offsets should be rounded up to 4 bytes.");
+static_assert(MeshLayout::stride() == 28, "Layout strides should be computed at compile time.");
+
+BOOST_AUTO_TEST_SUITE(vertex_layout)
+
+BOOST_AUTO_TEST_CASE(offsets_and_stride) {
+
+    using ColourLayout = VertexLayout<VertexAttribute<Vector2f>, VertexAttribute<Vector4ub, true>>;
+
+    const auto colourStride = ColourLayout::stride();
+    const auto colourOffset = ColourLayout::offset(1);
+
+    BOOST_CHECK_EQUAL(colourStride, 12);
+    BOOST_CHECK_EQUAL(colourOffset, 8);
+
+    using OddLayout = VertexLayout<VertexAttribute<Harken::Vector<GLubyte, 3>>, VertexAttribute<Vector2f>>;
+
+    const auto oddStride = OddLayout::stride();
+    const auto oddOffset = OddLayout::offset(1);
+
+    BOOST_CHECK_EQUAL(oddStride, 12);
+    BOOST_CHECK_EQUAL(oddOffset, 4);
+}
+
+BOOST_AUTO_TEST_CASE(format) {
+
+    const auto format = MeshLayout::format();
+
+    BOOST_CHECK_EQUAL(format.stride(), MeshLayout::stride());
+    BOOST_REQUIRE_EQUAL(format.attributes().size(), 3u);
+
+    BOOST_CHECK(format.attributes()[0] == (VertexAttributeFormat{3, GL_FLOAT, GL_FALSE, 0}));
+    BOOST_CHECK(format.attributes()[1] == (VertexAttributeFormat{3, GL_SHORT, GL_TRUE, 12}));
+    BOOST_CHECK(format.attributes()[2] == (VertexAttributeFormat{2, GL_FLOAT, GL_FALSE, 20}));
+}
+
+BOOST_AUTO_TEST_CASE(equality) {
+
+    const auto meshFormat = MeshLayout::format();
+
+    BOOST_CHECK(meshFormat == MeshLayout::format());
+    BOOST_CHECK_EQUAL(meshFormat.hash(), MeshLayout::format().hash());
+
+    BOOST_CHECK(meshFormat != PositionLayout::format());
+    BOOST_CHECK(PositionLayout::format() == VertexLayout<VertexAttribute<Vector3f>>::format());
+}
+
+BOOST_AUTO_TEST_CASE(instance_layout) {
+
+    struct ColouredInstance {
+        Harken::Matrix4f transform;
+        Harken::Vector4f colour;
+    };
+
+    using ColouredInstanceLayout = Harken::InstanceLayout<VertexAttribute<Harken::Vector4f>>;
+
+    const auto transformStride = Harken::InstanceLayout<>::stride();
+    const auto colouredStride = ColouredInstanceLayout::stride();
+    const auto colourOffset = ColouredInstanceLayout::offset(4);
+
+    BOOST_CHECK_EQUAL(transformStride, sizeof(Harken::Matrix4f));
+    BOOST_CHECK_EQUAL(colouredStride, sizeof(ColouredInstance));
+    BOOST_CHECK_EQUAL(colourOffset, offsetof(ColouredInstance, colour));
+
+    const auto columnOffset = Harken::InstanceLayout<>::offset(3);
+    BOOST_CHECK_EQUAL(columnOffset, 12 * sizeof(GLfloat));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+#include "harken_assetpack.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Builds an asset pack from files on disk, for the application to map with Harken::AssetPack.
+// Each asset is named by the path it was given as (or by the name before an '=', as in
+// "name=path"), and is stored uncompressed unless --lz4 precedes it on the command line; assets
+// that are uploaded or used in place (vertex data, say) should be left uncompressed.
+
+using namespace Harken;
+
+namespace {
+
+    void printUsage(const char * const program) {
+        std::cerr << "Usage: " << program << " <output> [--lz4 | --none] [name=]path..." << std::endl;
+    }
+
+    std::vector<char> readFile(const std::string& path) {
+
+        std::ifstream file{path, std::ios::binary | std::ios::ate};
+        if (!file) {
+            throw IOException{"Could not open \"" + path + "\"."};
+        }
+
+        std::vector<char> data(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0);
+
+        if (!file.read(data.data(), static_cast<std::streamsize>(data.size()))) {
+            throw IOException{"Could not read \"" + path + "\"."};
+        }
+
+        return data;
+    }
+}
+
+int main(const int argc, char * argv[]) {
+
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+
+        AssetPackWriter writer;
+        auto compression = AssetCompression::None;
+        std::size_t originalSize = 0;
+
+        for (auto i = 2; i < argc; ++i) {
+
+            if (std::strcmp(argv[i], "--lz4") == 0) {
+                compression = AssetCompression::LZ4;
+                continue;
+            }
+
+            if (std::strcmp(argv[i], "--none") == 0) {
+                compression = AssetCompression::None;
+                continue;
+            }
+
+            const std::string argument = argv[i];
+            const auto separator = argument.find('=');
+
+            const auto name = separator == std::string::npos ? argument : argument.substr(0, separator);
+            const auto path = separator == std::string::npos ? argument : argument.substr(separator + 1);
+
+            auto data = readFile(path);
+            originalSize += data.size();
+
+            writer.add(name, std::move(data), compression);
+        }
+
+        writer.write(argv[1]);
+
+        AssetPack pack{argv[1]};
+        std::cout << "Packed " << pack.count() << " assets (" << originalSize << " bytes) into \"" << argv[1] << "\"."
+                  << std::endl;
+    }
+    catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
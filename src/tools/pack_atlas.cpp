@@ -0,0 +1,264 @@
+#include "harken_assetpack.h"
+#include "harken_atlaspacker.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Packs images into atlas pages, and writes the pages and their index to an asset pack, for the
+// application to load with Harken::TextureAtlas. Images are read from binary Netpbm files (PPM for
+// RGB, or PAM for RGB or RGBA, with a maximum value of 255), and each is named by the path it was
+// given as (or by the name before an '=', as in "name=path"). Pages are stored as RGBA pixels
+// with a byte per component, bottom row first, as "<atlas>.page<n>", and the index as
+// "<atlas>.index", where the atlas is named "atlas" unless --name is given.
+
+using namespace Harken;
+
+namespace {
+
+    struct Image {
+        std::string name;
+        Size2<int> size;
+        std::vector<char> pixels;
+    };
+
+    void printUsage(const char * const program) {
+        std::cerr << "Usage: " << program
+                  << " <output> <width>x<height> [--padding <pixels>] [--name <atlas>] [name=]image..." << std::endl;
+    }
+
+    /**
+     * Reads the next token of a Netpbm header, skipping whitespace and comments.
+     */
+
+    std::string readToken(std::istream& stream) {
+
+        std::string token;
+        stream >> std::ws;
+
+        while (stream.peek() == '#') {
+            std::getline(stream, token);
+            stream >> std::ws;
+        }
+
+        stream >> token;
+        return token;
+    }
+
+    int readNumber(std::istream& stream, const std::string& path) {
+
+        const auto token = readToken(stream);
+        if (token.empty() || token.find_first_not_of("0123456789") != std::string::npos) {
+            throw IOException{"\"" + path + "\" has a malformed header."};
+        }
+
+        return std::stoi(token);
+    }
+
+    /**
+     * Reads a PPM or PAM image, converting it to RGBA and flipping it to bottom row first.
+     */
+
+    Image readImage(const std::string& name, const std::string& path) {
+
+        std::ifstream file{path, std::ios::binary};
+        if (!file) {
+            throw IOException{"Could not open \"" + path + "\"."};
+        }
+
+        const auto magic = readToken(file);
+
+        int width = 0;
+        int height = 0;
+        int depth = 3;
+        int maxValue = 0;
+
+        if (magic == "P6") {
+            width = readNumber(file, path);
+            height = readNumber(file, path);
+            maxValue = readNumber(file, path);
+        }
+        else if (magic == "P7") {
+
+            for (auto token = readToken(file); token != "ENDHDR"; token = readToken(file)) {
+
+                if (token == "WIDTH") {
+                    width = readNumber(file, path);
+                }
+                else if (token == "HEIGHT") {
+                    height = readNumber(file, path);
+                }
+                else if (token == "DEPTH") {
+                    depth = readNumber(file, path);
+                }
+                else if (token == "MAXVAL") {
+                    maxValue = readNumber(file, path);
+                }
+                else if (token == "TUPLTYPE") {
+                    readToken(file);
+                }
+                else {
+                    throw IOException{"\"" + path + "\" has a malformed header."};
+                }
+            }
+        }
+        else {
+            throw IOException{"\"" + path + "\" is not a binary PPM or PAM image."};
+        }
+
+        if (width <= 0 || height <= 0 || (depth != 3 && depth != 4) || maxValue != 255) {
+            throw IOException{"\"" + path + "\" is not an 8-bit RGB or RGBA image."};
+        }
+
+        // A single whitespace character separates the header from the pixels.
+
+        file.get();
+
+        const auto rowSize = static_cast<std::size_t>(width) * static_cast<std::size_t>(depth);
+        std::vector<char> source(rowSize * static_cast<std::size_t>(height));
+
+        if (!file.read(source.data(), static_cast<std::streamsize>(source.size()))) {
+            throw IOException{"Could not read the pixels of \"" + path + "\"."};
+        }
+
+        Image image{name, {width, height}, std::vector<char>(static_cast<std::size_t>(width) * height * 4)};
+
+        for (auto row = 0; row < height; ++row) {
+
+            const auto sourceRow = source.data() + static_cast<std::size_t>(height - 1 - row) * rowSize;
+            auto target = image.pixels.data() + static_cast<std::size_t>(row) * width * 4;
+
+            for (auto column = 0; column < width; ++column, target += 4) {
+                std::memcpy(target, sourceRow + column * depth, static_cast<std::size_t>(depth));
+                if (depth == 3) {
+                    target[3] = static_cast<char>(255);
+                }
+            }
+        }
+
+        return image;
+    }
+
+    /**
+     * Copies the image @p pixels, of the given @p size, into @p page (of the given @p pageSize)
+     * with its bottom-left corner at (@p x, @p y).
+     */
+
+    void copyImage(const std::vector<char>& pixels, const Size2<int> size, std::vector<char>& page, const Size2<int> pageSize,
+                   const int x, const int y) {
+
+        const auto rowSize = static_cast<std::size_t>(size.width()) * 4;
+
+        for (auto row = 0; row < size.height(); ++row) {
+            std::memcpy(page.data() + (static_cast<std::size_t>(y + row) * pageSize.width() + x) * 4,
+                        pixels.data() + static_cast<std::size_t>(row) * rowSize, rowSize);
+        }
+    }
+}
+
+int main(const int argc, char * argv[]) {
+
+    if (argc < 4) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+
+        int pageWidth = 0;
+        int pageHeight = 0;
+        char separator = 0;
+
+        std::istringstream pageSizeStream{argv[2]};
+        if (!(pageSizeStream >> pageWidth >> separator >> pageHeight) || separator != 'x' || pageWidth <= 0 || pageHeight <= 0) {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        auto padding = 1;
+        std::string atlasName = "atlas";
+        std::vector<Image> images;
+
+        for (auto i = 3; i < argc; ++i) {
+
+            if (std::strcmp(argv[i], "--padding") == 0 && i + 1 < argc) {
+                padding = std::max(std::atoi(argv[++i]), 0);
+                continue;
+            }
+
+            if (std::strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+                atlasName = argv[++i];
+                continue;
+            }
+
+            const std::string argument = argv[i];
+            const auto equals = argument.find('=');
+
+            const auto name = equals == std::string::npos ? argument : argument.substr(0, equals);
+            const auto path = equals == std::string::npos ? argument : argument.substr(equals + 1);
+
+            images.push_back(readImage(name, path));
+        }
+
+        if (images.empty()) {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        const Size2<int> pageSize{pageWidth, pageHeight};
+        AtlasPacker packer{pageSize, padding};
+
+        std::vector<Size2<int>> sizes;
+        for (const auto& image : images) {
+            sizes.push_back(image.size);
+        }
+
+        const auto regions = packer.insert(sizes);
+
+        AtlasIndex index;
+        index.pageSize = pageSize;
+        index.pageCount = packer.pageCount();
+        index.padding = padding;
+
+        std::vector<std::vector<char>> pages(static_cast<std::size_t>(packer.pageCount()),
+                                             std::vector<char>(static_cast<std::size_t>(pageWidth) * pageHeight * 4));
+
+        for (std::size_t i = 0; i < images.size(); ++i) {
+
+            const auto& image = images[i];
+            const auto& region = regions[i];
+
+            if (!index.regions.emplace(image.name, region).second) {
+                throw AtlasException{"Two images are named \"" + image.name + "\"."};
+            }
+
+            const Size2<int> paddedSize{image.size.width() + 2 * padding, image.size.height() + 2 * padding};
+            copyImage(padImage(image.pixels.data(), image.size, 4, padding), paddedSize,
+                      pages[static_cast<std::size_t>(region.page)], pageSize, region.x - padding, region.y - padding);
+        }
+
+        AssetPackWriter writer;
+        writer.add(atlasName + ".index", writeAtlasIndex(index));
+
+        for (std::size_t page = 0; page < pages.size(); ++page) {
+            writer.add(atlasName + ".page" + std::to_string(page), std::move(pages[page]));
+        }
+
+        writer.write(argv[1]);
+
+        std::cout << "Packed " << images.size() << " images into " << packer.pageCount() << " pages of " << pageWidth
+                  << "x" << pageHeight << " (" << static_cast<int>(packer.occupancy() * 100.0) << "% occupied) in \""
+                  << argv[1] << "\"." << std::endl;
+    }
+    catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}